@@ -0,0 +1,86 @@
+// Particle simulation throughput: keeps N live particles and measures one 60 Hz frame of
+// simulate + instance generation, single-threaded and on the job system
+//
+// Usage: particle_benchmark [particles] [frames]
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "jobs/JobSystem.h"
+#include "particles/ParticlePool.h"
+
+namespace {
+    struct Result {
+        double simulateMillis = 0.0;
+        double instanceMillis = 0.0;
+    };
+
+    uint32_t rngState = 12345u;
+    float random(float min, float max) {
+        rngState ^= rngState << 13;
+        rngState ^= rngState >> 17;
+        rngState ^= rngState << 5;
+        return min + (max - min) * static_cast<float>(rngState >> 8) * (1.0f / 16777216.0f);
+    }
+
+    void refill(ParticlePool& pool, size_t target) {
+        while (pool.size() < target) {
+            ParticleSpawn particle;
+            particle.velocityX = random(-5.0f, 5.0f);
+            particle.velocityY = random(0.0f, 10.0f);
+            particle.lifetime = random(0.5f, 3.0f);
+            particle.size = random(0.05f, 0.2f);
+            pool.spawn(particle);
+        }
+    }
+
+    Result run(size_t particles, int frames, JobSystem* jobs) {
+        constexpr float dt = 1.0f / 60.0f;
+        ParticlePool pool(particles);
+        std::vector<QuadInstance> instances(particles);
+
+        ParticleForces forces;
+        forces.gravityY = -9.81f;
+        forces.drag = 0.5f;
+        ParticleAppearance appearance;
+
+        Result result;
+        for (int frame = 0; frame < frames; ++frame) {
+            // Respawning is emitter work, not simulation; keep it out of the timings
+            refill(pool, particles);
+
+            const auto start = std::chrono::steady_clock::now();
+            pool.simulate(dt, forces, jobs);
+            const auto simulated = std::chrono::steady_clock::now();
+            pool.writeInstances(instances.data(), appearance, jobs);
+            const auto written = std::chrono::steady_clock::now();
+
+            result.simulateMillis += std::chrono::duration<double, std::milli>(simulated - start).count();
+            result.instanceMillis += std::chrono::duration<double, std::milli>(written - simulated).count();
+        }
+        result.simulateMillis /= frames;
+        result.instanceMillis /= frames;
+        return result;
+    }
+
+    void report(const char* label, const Result& result) {
+        const double total = result.simulateMillis + result.instanceMillis;
+        std::cout << "  " << label << ": simulate " << result.simulateMillis << " ms + instances "
+                  << result.instanceMillis << " ms = " << total << " ms/frame ("
+                  << (total <= 1000.0 / 60.0 ? "within" : "OVER") << " the 16.7 ms budget)" << std::endl;
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t particles = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 500000;
+    const int frames = argc > 2 ? std::atoi(argv[2]) : 300;
+
+    JobSystem jobs;
+    std::cout << "Particle benchmark: " << particles << " live particles, " << frames << " frames" << std::endl;
+    report("single thread", run(particles, frames, nullptr));
+    std::cout << "  (" << jobs.getWorkerCount() + 1 << " threads)" << std::endl;
+    report("job system", run(particles, frames, &jobs));
+    return 0;
+}
@@ -1,61 +1,256 @@
 #ifndef ENGINE_ASSETCACHE_H
 #define ENGINE_ASSETCACHE_H
 
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 
+#include "ContentHash.h"
+
+struct AssetCacheStats {
+    int hits = 0;         // served from the cache by id or canonical path
+    int contentHits = 0;  // different path, identical file contents
+    int misses = 0;       // had to be loaded
+};
+
+// Memory envelope for one asset type, 0 means unlimited
+// Only GPU memory is budgeted: cached assets drop their CPU-side data once uploaded
+struct AssetMemoryBudget {
+    size_t gpuBytes = 0;
+};
+
+struct AssetResidencyStats {
+    size_t resident = 0;     // assets held by the cache
+    size_t referenced = 0;   // of those, still used outside the cache
+    size_t gpuBytes = 0;
+    size_t evictions = 0;
+    size_t evictedGpuBytes = 0;
+    bool overBudget = false; // budget exceeded by referenced assets alone
+};
+
+// Size accounting hook; asset types without getGpuBytes() count as zero
+template<typename T>
+size_t assetGpuBytes(const T& asset) {
+    if constexpr (requires { { asset.getGpuBytes() } -> std::convertible_to<size_t>; }) {
+        return asset.getGpuBytes();
+    } else {
+        return 0;
+    }
+}
+
+// Caches assets of one type, shared by everyone who asks for the same file
+// Assets are keyed by canonical path, with a content hash index so that copies
+// of the same file under another name are loaded only once
+//
+// The cache keeps every asset resident until it has to make room: when a budget is
+// exceeded, the least recently used assets that are neither pinned nor referenced elsewhere are evicted
 template<typename T>
 class AssetCache {
 public:
-    explicit AssetCache(std::unordered_map<std::string_view, std::string_view>& idPathMap) {
-        this->idPathMap = idPathMap;
-    }
+    explicit AssetCache(std::unordered_map<std::string, std::string>& idPathMap) : idPathMap(idPathMap) { }
 
     void load(std::string_view id) {
-        auto it = assets.find(id);
-        if (it != assets.end() && !it->second.expired()) {
-            return;  // Already loaded
+        if (auto pathIt = idPathMap.find(std::string(id)); pathIt != idPathMap.end()) {
+            acquire(pathIt->second);
         }
-
-        auto pathIt = idPathMap.find(id);
-        std::shared_ptr<T> asset = std::make_shared<T>(pathIt->second.data());
-        assets[id] = asset;
-        pending[id] = asset;
     }
 
+    // Drops the cache's reference; users still holding the asset keep it alive
     void unload(std::string_view id) {
-        pending.erase(id);
-        assets.erase(id);
+        if (auto pathIt = idPathMap.find(std::string(id)); pathIt != idPathMap.end()) {
+            evict(resolve(canonicalKey(pathIt->second)));
+        }
     }
 
     std::shared_ptr<T> get(std::string_view id) {
-        if (auto it = assets.find(id); it !=assets.end()) {
-            if (auto asset = it->second.lock()) {
-                pending.erase(id);
+        if (auto pathIt = idPathMap.find(std::string(id)); pathIt != idPathMap.end()) {
+            return acquire(pathIt->second);
+        }
+
+        return nullptr;
+    }
+
+    // Shared instance for a file path; loads it on first use
+    std::shared_ptr<T> acquire(const std::string& path) {
+        const std::string key = resolve(canonicalKey(path));
+        if (auto it = entries.find(key); it != entries.end()) {
+            touch(it->second);
+            stats.hits++;
+            return it->second.asset;
+        }
 
-                return asset;
+        const uint64_t contentHash = hashFile(path);
+        if (contentHash != 0) {
+            if (auto it = byContent.find(contentHash); it != byContent.end()) {
+                Entry& entry = entries.at(it->second);
+                aliases[key] = it->second;
+                touch(entry);
+                stats.contentHits++;
+                return entry.asset;
             }
         }
 
-        pending.erase(id);
+        stats.misses++;
+        std::shared_ptr<T> asset = std::make_shared<T>(path);
+        insert(key, asset, contentHash);
+        enforceBudget();
+        return asset;
+    }
 
-        // asset is not in cache so reload it
-        if (auto it = idPathMap.find(id); it != idPathMap.end()) {
-            std::shared_ptr<T> asset = std::make_shared<T>(it->second.data());
-            assets.insert(std::make_pair(id, asset));
+    // Resident asset for a path, without loading it or counting a hit
+    std::shared_ptr<T> find(const std::string& path) const {
+        auto it = entries.find(resolve(canonicalKey(path)));
+        return it != entries.end() ? it->second.asset : nullptr;
+    }
 
-            return asset;
+    // Take ownership of an asset loaded elsewhere (e.g. decoded on a worker thread)
+    // If the file or its contents are already resident, the resident instance wins and is returned
+    std::shared_ptr<T> adopt(const std::string& path, std::shared_ptr<T> asset, uint64_t contentHash) {
+        const std::string key = resolve(canonicalKey(path));
+        if (auto it = entries.find(key); it != entries.end()) {
+            touch(it->second);
+            return it->second.asset;
+        }
+        if (contentHash != 0) {
+            if (auto it = byContent.find(contentHash); it != byContent.end()) {
+                Entry& entry = entries.at(it->second);
+                aliases[key] = it->second;
+                touch(entry);
+                return entry.asset;
+            }
         }
 
-        return nullptr;
+        stats.misses++;
+        insert(key, asset, contentHash);
+        enforceBudget();
+        return asset;
+    }
+
+    // Pinned assets are never evicted to meet the budget (they can still be unloaded)
+    void setPinned(const std::string& path, bool pinned) {
+        if (auto it = entries.find(resolve(canonicalKey(path))); it != entries.end()) {
+            it->second.pinned = pinned;
+        }
+    }
+
+    void setBudget(const AssetMemoryBudget& newBudget) {
+        budget = newBudget;
+        enforceBudget();
+    }
+
+    const AssetMemoryBudget& getBudget() const { return budget; }
+
+    // Evict least recently used, unreferenced assets until the budget is met
+    void enforceBudget() {
+        residency.overBudget = false;
+        if (withinBudget()) return;
+
+        for (auto it = lru.rbegin(); it != lru.rend() && !withinBudget();) {
+            Entry& entry = entries.at(*it);
+            ++it;
+            if (entry.asset.use_count() == 1 && !entry.pinned) {
+                residency.evictions++;
+                residency.evictedGpuBytes += entry.gpuBytes;
+                evict(entry.key);
+            }
+        }
+
+        residency.overBudget = !withinBudget();
+    }
+
+    const AssetCacheStats& getStats() const { return stats; }
+
+    AssetResidencyStats getResidency() const {
+        AssetResidencyStats result = residency;
+        result.resident = entries.size();
+        result.referenced = 0;
+        for (const auto& [key, entry] : entries) {
+            if (entry.asset.use_count() > 1) result.referenced++;
+        }
+        return result;
     }
 
 private:
-    std::unordered_map<std::string_view, std::shared_ptr<T>> pending;
-    std::unordered_map<std::string_view, std::string_view> idPathMap;
-    // asset id -> T (the asset)
-    std::unordered_map<std::string_view, std::weak_ptr<T>> assets;
+    struct Entry {
+        std::string key;
+        std::shared_ptr<T> asset;
+        uint64_t contentHash = 0;
+        size_t gpuBytes = 0;
+        bool pinned = false;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    std::unordered_map<std::string, std::string>& idPathMap;
+    // canonical path -> resident asset
+    std::unordered_map<std::string, Entry> entries;
+    // canonical path of a duplicate file -> key of the entry holding its contents
+    std::unordered_map<std::string, std::string> aliases;
+    // content hash -> entry key
+    std::unordered_map<uint64_t, std::string> byContent;
+    // most recently used first
+    std::list<std::string> lru;
+
+    AssetCacheStats stats;
+    AssetResidencyStats residency;
+    AssetMemoryBudget budget;
+
+    static std::string canonicalKey(const std::string& path) {
+        std::error_code ec;
+        std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+        return ec ? path : canonical.generic_string();
+    }
+
+    const std::string& resolve(const std::string& key) const {
+        auto it = aliases.find(key);
+        return it != aliases.end() ? it->second : key;
+    }
+
+    bool withinBudget() const {
+        return budget.gpuBytes == 0 || residency.gpuBytes <= budget.gpuBytes;
+    }
+
+    void touch(Entry& entry) {
+        lru.splice(lru.begin(), lru, entry.lruPosition);
+    }
+
+    void insert(const std::string& key, std::shared_ptr<T> asset, uint64_t contentHash) {
+        Entry entry;
+        entry.key = key;
+        entry.gpuBytes = assetGpuBytes(*asset);
+        entry.asset = std::move(asset);
+        entry.contentHash = contentHash;
+        lru.push_front(key);
+        entry.lruPosition = lru.begin();
+
+        residency.gpuBytes += entry.gpuBytes;
+        if (contentHash != 0) {
+            byContent[contentHash] = key;
+        }
+        entries.emplace(key, std::move(entry));
+    }
+
+    // Takes the key by value: callers may pass a string owned by the entry or an alias
+    void evict(std::string key) {
+        auto it = entries.find(key);
+        if (it == entries.end()) return;
+
+        Entry& entry = it->second;
+        residency.gpuBytes -= entry.gpuBytes;
+
+        if (entry.contentHash != 0) {
+            byContent.erase(entry.contentHash);
+        }
+        std::erase_if(aliases, [&key](const auto& alias) { return alias.second == key; });
+        lru.erase(entry.lruPosition);
+        entries.erase(it);
+    }
 };
 
 
-#endif //ENGINE_ASSETCACHE_H
\ No newline at end of file
+#endif //ENGINE_ASSETCACHE_H
@@ -1,12 +1,26 @@
 #include "AssetManager.h"
+#include <iostream>
+#include <thread>
+
+AssetManager::~AssetManager() {
+    // Decode jobs write into the preload tasks; let them finish first
+    if (preloading && jobs) {
+        jobs->wait(preloading->decodes);
+    }
+}
 
 void AssetManager::loadSync(std::string_view path, AssetType type, std::string_view id) {
+    idPathMap[std::string(id)] = std::string(path);
+
     switch (type) {
         case AssetType::Texture:
             textures.load(id);
             return;
         case AssetType::Shader:
             shaders.load(id);
+            return;
+        default:
+            return;
     }
 }
 
@@ -17,6 +31,9 @@ void AssetManager::unloadSync(AssetType type, std::string_view id) {
             return;
         case AssetType::Shader:
             shaders.unload(id);
+            return;
+        default:
+            return;
     }
 }
 
@@ -27,3 +44,216 @@ std::shared_ptr<Texture2D> AssetManager::getTexture(std::string_view id) {
 std::shared_ptr<Shader> AssetManager::getShader(std::string_view id) {
     return shaders.get(id);
 }
+
+std::shared_ptr<Texture2D> AssetManager::acquireTexture(const std::string& path) {
+    return textures.acquire(path);
+}
+
+void AssetManager::preload(const SceneManifest& manifest, std::function<void()> onComplete) {
+    if (!preloading) {
+        preloading = std::make_unique<Preload>();
+        preloading->start = std::chrono::steady_clock::now();
+    }
+
+    for (size_t i : manifest.getLoadOrder()) {
+        const ManifestEntry& entry = manifest.getEntries()[i];
+        idPathMap[entry.id] = entry.path;
+        if (preloading->taskIndex.contains(entry.id)) continue;
+
+        auto task = std::make_unique<PreloadTask>();
+        task->entry = entry;
+        preloading->taskIndex[entry.id] = preloading->tasks.size();
+        preloading->tasks.push_back(std::move(task));
+    }
+
+    if (onComplete) {
+        preloading->onComplete.push_back(std::move(onComplete));
+    }
+
+    // Kick off everything without pending dependencies right away
+    pumpPreload();
+}
+
+void AssetManager::switchManifest(const SceneManifest& from, const SceneManifest& to, std::function<void()> onComplete) {
+    ManifestDiff delta = SceneManifest::diff(from, to);
+
+    for (const auto& entry : delta.removed) {
+        if (entry.type == AssetType::Texture) {
+            textures.setPinned(entry.path, false);
+        } else if (entry.type == AssetType::Shader) {
+            shaders.setPinned(entry.path, false);
+        }
+        unloadSync(entry.type, entry.id);
+    }
+
+    SceneManifest added;
+    for (auto& entry : delta.added) {
+        added.add(std::move(entry));
+    }
+
+    std::cout << "Switching manifest: " << delta.removed.size() << " unloaded, " << added.getEntries().size()
+              << " to load, " << delta.kept.size() << " kept" << std::endl;
+    preload(added, std::move(onComplete));
+}
+
+void AssetManager::finishPreload() {
+    while (preloading) {
+        pumpPreload();
+        if (preloading) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+PreloadProgress AssetManager::getPreloadProgress() const {
+    PreloadProgress progress;
+    if (!preloading) return progress;
+
+    progress.total = preloading->tasks.size();
+    for (const auto& task : preloading->tasks) {
+        TaskState state = task->state.load(std::memory_order_acquire);
+        if (state == TaskState::Resident) progress.resident++;
+        if (state == TaskState::Failed) progress.failed++;
+    }
+    return progress;
+}
+
+void AssetManager::update(int dt) {
+    pumpPreload();
+    textures.enforceBudget();
+    shaders.enforceBudget();
+}
+
+void AssetManager::pumpPreload() {
+    if (!preloading) return;
+
+    bool complete = true;
+    for (auto& task : preloading->tasks) {
+        switch (task->state.load(std::memory_order_acquire)) {
+            case TaskState::Waiting: {
+                TaskState dependencies = dependencyState(*task);
+                if (dependencies == TaskState::Failed) {
+                    std::cerr << "ERROR::ASSET_MANAGER::DEPENDENCY_FAILED for " << task->entry.id << std::endl;
+                    task->state.store(TaskState::Failed, std::memory_order_release);
+                } else if (dependencies == TaskState::Resident) {
+                    startTask(*task);
+                }
+                break;
+            }
+            case TaskState::Decoded:
+                finishTask(*task);
+                break;
+            default:
+                break;
+        }
+
+        TaskState state = task->state.load(std::memory_order_acquire);
+        if (state != TaskState::Resident && state != TaskState::Failed) {
+            complete = false;
+        }
+    }
+
+    if (!complete) return;
+
+    if (jobs) {
+        jobs->wait(preloading->decodes);  // already done; makes the counter safe to destroy
+    }
+
+    const PreloadProgress progress = getPreloadProgress();
+    const double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - preloading->start).count();
+    std::cout << "Preloaded " << progress.resident << " assets in " << millis << " ms";
+    if (progress.failed > 0) {
+        std::cout << " (" << progress.failed << " failed)";
+    }
+    std::cout << std::endl;
+
+    // Callbacks may start another preload, so detach the finished one first
+    std::unique_ptr<Preload> finished = std::move(preloading);
+    for (auto& callback : finished->onComplete) {
+        callback();
+    }
+}
+
+AssetManager::TaskState AssetManager::dependencyState(const PreloadTask& task) const {
+    for (const auto& dependency : task.entry.dependencies) {
+        auto it = preloading->taskIndex.find(dependency);
+        if (it == preloading->taskIndex.end()) continue;  // loaded outside this preload
+
+        TaskState state = preloading->tasks[it->second]->state.load(std::memory_order_acquire);
+        if (state == TaskState::Failed) return TaskState::Failed;
+        if (state != TaskState::Resident) return TaskState::Waiting;
+    }
+    return TaskState::Resident;
+}
+
+void AssetManager::startTask(PreloadTask& task) {
+    const ManifestEntry& entry = task.entry;
+
+    if (entry.type == AssetType::Shader) {
+        // Compiling needs the GL context, so shaders load right here
+        std::shared_ptr<Shader> shader = shaders.acquire(entry.path);
+        shaders.setPinned(entry.path, true);
+        task.state.store(shader && shader->isValid() ? TaskState::Resident : TaskState::Failed, std::memory_order_release);
+        return;
+    }
+
+    if (entry.type != AssetType::Texture) {
+        std::cerr << "ERROR::ASSET_MANAGER::UNSUPPORTED_PRELOAD_TYPE for " << entry.id << std::endl;
+        task.state.store(TaskState::Failed, std::memory_order_release);
+        return;
+    }
+
+    if (textures.find(entry.path)) {
+        textures.setPinned(entry.path, true);
+        task.state.store(TaskState::Resident, std::memory_order_release);
+        return;
+    }
+
+    task.state.store(TaskState::Decoding, std::memory_order_release);
+    auto decode = [&task] {
+        task.data = Texture2D::decode(task.entry.path);
+        task.contentHash = hashFile(task.entry.path);
+        task.state.store(TaskState::Decoded, std::memory_order_release);
+    };
+
+    if (jobs) {
+        jobs->submit(decode, &preloading->decodes);
+    } else {
+        decode();
+    }
+}
+
+void AssetManager::finishTask(PreloadTask& task) {
+    const std::string& path = task.entry.path;
+    auto texture = std::make_shared<Texture2D>(path, *task.data);
+    task.data.reset();
+
+    if (!texture->isValid()) {
+        task.state.store(TaskState::Failed, std::memory_order_release);
+        return;
+    }
+
+    textures.adopt(path, texture, task.contentHash);
+    textures.setPinned(path, true);
+    task.state.store(TaskState::Resident, std::memory_order_release);
+}
+
+void AssetManager::reportStats(std::ostream& out) const {
+    const AssetCacheStats& stats = textures.getStats();
+    const int requests = stats.hits + stats.contentHits + stats.misses;
+    out << "Texture cache: " << requests << " requests, " << stats.hits << " hits, "
+        << stats.contentHits << " content hits, " << stats.misses << " misses" << std::endl;
+
+    const AssetResidencyStats residency = textures.getResidency();
+    const AssetMemoryBudget& budget = textures.getBudget();
+    out << "Texture residency: " << residency.resident << " resident (" << residency.referenced << " in use), "
+        << residency.gpuBytes / 1024 << " KiB GPU";
+    if (budget.gpuBytes > 0) {
+        out << " of " << budget.gpuBytes / 1024 << " KiB budget";
+    }
+    out << ", " << residency.evictions << " evicted (" << residency.evictedGpuBytes / 1024 << " KiB)";
+    if (residency.overBudget) {
+        out << ", OVER BUDGET";
+    }
+    out << std::endl;
+}
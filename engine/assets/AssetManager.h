@@ -1,22 +1,39 @@
 #ifndef ENGINE_ASSETMANAGER_H
 #define ENGINE_ASSETMANAGER_H
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <ostream>
+#include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "AssetCache.h"
+#include "AssetTypes.h"
+#include "SceneManifest.h"
+#include "jobs/JobSystem.h"
 #include "renderer/shader/Shader.h"
 #include "renderer/texture/Texture2D.h"
 #include "service/IService.h"
 
-enum class AssetType {
-    Texture, Mesh, Shader, Audio, Animation
+struct PreloadProgress {
+    size_t total = 0;
+    size_t resident = 0;
+    size_t failed = 0;
+
+    bool isComplete() const { return resident + failed == total; }
+    float fraction() const { return total > 0 ? static_cast<float>(resident + failed) / static_cast<float>(total) : 1.0f; }
 };
 
 class AssetManager : public IService {
 public:
-    AssetManager() : textures(this->idPathMap), shaders(this->idPathMap) { } ;
+    // Without a job system, preloads decode on the calling thread inside update()
+    explicit AssetManager(JobSystem* jobs = nullptr) : textures(this->idPathMap), shaders(this->idPathMap), jobs(jobs) { } ;
+    ~AssetManager() override;
 
     void loadSync(std::string_view path, AssetType type, std::string_view id);
     void unloadSync(AssetType type, std::string_view id);
@@ -27,16 +44,71 @@ public:
     // void getAudio();
     // void getAnimation();
 
+    // Shared, ref-counted texture for a file; every caller with the same file gets the same instance
+    std::shared_ptr<Texture2D> acquireTexture(const std::string& path);
+
+    // Load every asset of a manifest ahead of use, in dependency order
+    // Files are decoded in parallel on the job system; GPU uploads happen in update() on the GL thread
+    // Manifest assets are pinned so budgets never evict them while the scene is active
+    void preload(const SceneManifest& manifest, std::function<void()> onComplete = {});
+
+    // Switch scenes loading only the delta: assets only in `from` are unloaded, assets only in `to` preloaded
+    void switchManifest(const SceneManifest& from, const SceneManifest& to, std::function<void()> onComplete = {});
+
+    // Block, pumping uploads, until the current preload has completed
+    void finishPreload();
+
+    // True when no preload is in flight, i.e. everything requested is resident
+    bool isReady() const { return !preloading; }
+    PreloadProgress getPreloadProgress() const;
+
+    const AssetCacheStats& getTextureStats() const { return textures.getStats(); }
+    const AssetCacheStats& getShaderStats() const { return shaders.getStats(); }
+    void reportStats(std::ostream& out) const;
+
+    // Memory envelopes per asset type; unreferenced assets are evicted LRU-first to stay inside them
+    void setTextureBudget(const AssetMemoryBudget& budget) { textures.setBudget(budget); }
+    void setShaderBudget(const AssetMemoryBudget& budget) { shaders.setBudget(budget); }
+    AssetResidencyStats getTextureResidency() const { return textures.getResidency(); }
+    AssetResidencyStats getShaderResidency() const { return shaders.getResidency(); }
+
     // IService interface
-    void update(int dt) override { }
+    // Uploads finished preload decodes; assets released since the last frame become evictable here
+    void update(int dt) override;
 
 protected:
 
 private:
+    enum class TaskState { Waiting, Decoding, Decoded, Resident, Failed };
+
+    struct PreloadTask {
+        ManifestEntry entry;
+        std::atomic<TaskState> state{TaskState::Waiting};
+        std::unique_ptr<TextureData> data;  // written by the decode job
+        uint64_t contentHash = 0;
+    };
+
+    struct Preload {
+        std::vector<std::unique_ptr<PreloadTask>> tasks;
+        std::unordered_map<std::string, size_t> taskIndex;  // asset id -> task
+        std::vector<std::function<void()>> onComplete;
+        std::chrono::steady_clock::time_point start;
+        JobCounter decodes;
+    };
+
+    // asset id -> file path, shared by all caches
+    std::unordered_map<std::string, std::string> idPathMap;
+
     AssetCache<Texture2D> textures;
     AssetCache<Shader> shaders;
 
-    std::unordered_map<std::string_view, std::string_view> idPathMap;
+    JobSystem* jobs;
+    std::unique_ptr<Preload> preloading;
+
+    void pumpPreload();
+    TaskState dependencyState(const PreloadTask& task) const;
+    void startTask(PreloadTask& task);
+    void finishTask(PreloadTask& task);
 };
 
-#endif //ENGINE_ASSETMANAGER_H
\ No newline at end of file
+#endif //ENGINE_ASSETMANAGER_H
@@ -0,0 +1,60 @@
+#include "AssetSnapshot.h"
+#include "jobs/JobSystem.h"
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+std::shared_ptr<const AssetSnapshot> AssetSnapshot::load(const SceneManifest& manifest, JobSystem* jobs) {
+    const auto start = std::chrono::steady_clock::now();
+    const std::vector<ManifestEntry>& entries = manifest.getEntries();
+
+    // Each job writes only its own slot; the maps are filled afterwards on this thread
+    std::vector<std::unique_ptr<TextureData>> decoded(entries.size());
+    std::vector<std::unique_ptr<MappedFile>> mapped(entries.size());
+    auto loadRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (entries[i].type == AssetType::Texture) {
+                decoded[i] = Texture2D::decode(entries[i].path);
+            } else {
+                mapped[i] = std::make_unique<MappedFile>(entries[i].path);
+            }
+        }
+    };
+    if (jobs) {
+        jobs->parallelFor(entries.size(), 1, loadRange);
+    } else {
+        loadRange(0, entries.size());
+    }
+
+    auto snapshot = std::make_shared<AssetSnapshot>();
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (decoded[i] && decoded[i]->valid) {
+            const TextureData& data = *decoded[i];
+            snapshot->bytes += data.baked ? data.file->getSize()
+                                          : static_cast<size_t>(data.width) * data.height * data.channels;
+            snapshot->textures.emplace(entries[i].id, std::move(decoded[i]));
+        } else if (mapped[i] && mapped[i]->isValid()) {
+            snapshot->bytes += mapped[i]->getSize();
+            snapshot->files.emplace(entries[i].id, std::move(mapped[i]));
+        } else {
+            std::cerr << "ERROR::ASSET_SNAPSHOT::Failed to load " << entries[i].id << " (" << entries[i].path << ")" << std::endl;
+        }
+    }
+    snapshot->loadMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return snapshot;
+}
+
+const TextureData* AssetSnapshot::findTexture(const std::string& id) const {
+    auto it = textures.find(id);
+    return it != textures.end() ? it->second.get() : nullptr;
+}
+
+const MappedFile* AssetSnapshot::findFile(const std::string& id) const {
+    auto it = files.find(id);
+    return it != files.end() ? it->second.get() : nullptr;
+}
+
+void AssetSnapshot::reportStats(std::ostream& out) const {
+    out << "Asset snapshot: " << getAssetCount() << " assets, " << static_cast<double>(bytes) / (1024.0 * 1024.0)
+        << " MB, loaded in " << loadMillis << " ms" << std::endl;
+}
@@ -0,0 +1,41 @@
+#ifndef ENGINE_ASSETSNAPSHOT_H
+#define ENGINE_ASSETSNAPSHOT_H
+
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+
+#include "MappedFile.h"
+#include "SceneManifest.h"
+#include "renderer/texture/Texture2D.h"
+
+class JobSystem;
+
+// CPU copies of a manifest's assets, loaded once and then read-only
+// Many worlds (e.g. a WorldBatch) hold the same snapshot through a shared_ptr to const and read it
+// from any thread without locking. Textures are decoded but never uploaded, so no GL context is needed
+class AssetSnapshot {
+public:
+    // Decode textures and map other files in parallel when jobs is given; missing assets are reported and skipped
+    static std::shared_ptr<const AssetSnapshot> load(const SceneManifest& manifest, JobSystem* jobs = nullptr);
+
+    // Decoded pixels of a texture asset, nullptr if unknown or failed
+    const TextureData* findTexture(const std::string& id) const;
+
+    // Raw bytes of any other asset (e.g. shader sources), nullptr if unknown or failed
+    const MappedFile* findFile(const std::string& id) const;
+
+    size_t getAssetCount() const { return textures.size() + files.size(); }
+    size_t getBytes() const { return bytes; }
+    void reportStats(std::ostream& out) const;
+
+private:
+    std::unordered_map<std::string, std::unique_ptr<TextureData>> textures;
+    std::unordered_map<std::string, std::unique_ptr<MappedFile>> files;
+    size_t bytes = 0;
+    double loadMillis = 0.0;
+};
+
+#endif //ENGINE_ASSETSNAPSHOT_H
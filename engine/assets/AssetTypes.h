@@ -0,0 +1,8 @@
+#ifndef ENGINE_ASSETTYPES_H
+#define ENGINE_ASSETTYPES_H
+
+enum class AssetType {
+    Texture, Mesh, Shader, Audio, Animation
+};
+
+#endif //ENGINE_ASSETTYPES_H
@@ -0,0 +1,40 @@
+#ifndef ENGINE_CONTENTHASH_H
+#define ENGINE_CONTENTHASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+// 64-bit FNV-1a, used to key assets and caches by content
+inline constexpr uint64_t fnvOffsetBasis = 14695981039346656037ull;
+inline constexpr uint64_t fnvPrime = 1099511628211ull;
+
+inline uint64_t hashBytes(const void* data, size_t size, uint64_t hash = fnvOffsetBasis) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= fnvPrime;
+    }
+    return hash;
+}
+
+inline uint64_t hashString(std::string_view text, uint64_t hash = fnvOffsetBasis) {
+    return hashBytes(text.data(), text.size(), hash);
+}
+
+// Hash of a file's contents, 0 if it cannot be read
+inline uint64_t hashFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return 0;
+
+    uint64_t hash = fnvOffsetBasis;
+    char buffer[64 * 1024];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+        hash = hashBytes(buffer, static_cast<size_t>(file.gcount()), hash);
+    }
+    return hash;
+}
+
+#endif //ENGINE_CONTENTHASH_H
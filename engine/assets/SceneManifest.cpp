@@ -0,0 +1,127 @@
+#include "SceneManifest.h"
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    bool parseType(const std::string& name, AssetType& type) {
+        if (name == "texture") { type = AssetType::Texture; return true; }
+        if (name == "shader")  { type = AssetType::Shader;  return true; }
+        return false;
+    }
+}
+
+std::unique_ptr<SceneManifest> SceneManifest::fromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "ERROR::SCENE_MANIFEST::FILE_NOT_FOUND: " << path << std::endl;
+        return nullptr;
+    }
+
+    auto manifest = std::make_unique<SceneManifest>();
+    if (!manifest->parse(file, path)) {
+        return nullptr;
+    }
+    if (!manifest->empty() && manifest->getLoadOrder().empty()) {
+        std::cerr << "ERROR::SCENE_MANIFEST::DEPENDENCY_CYCLE in " << path << std::endl;
+        return nullptr;
+    }
+    return manifest;
+}
+
+bool SceneManifest::parse(std::istream& input, const std::string& sourceName) {
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(input, line)) {
+        lineNumber++;
+        if (auto comment = line.find('#'); comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream tokens(line);
+        std::string typeName;
+        if (!(tokens >> typeName)) continue;  // blank line
+
+        ManifestEntry entry;
+        if (!parseType(typeName, entry.type) || !(tokens >> entry.id >> entry.path)) {
+            std::cerr << "ERROR::SCENE_MANIFEST::PARSE_ERROR " << sourceName << ":" << lineNumber << ": " << line << std::endl;
+            return false;
+        }
+
+        std::string token;
+        if (tokens >> token) {
+            if (token != ":") {
+                std::cerr << "ERROR::SCENE_MANIFEST::PARSE_ERROR " << sourceName << ":" << lineNumber
+                          << ": expected ':' before dependencies" << std::endl;
+                return false;
+            }
+            while (tokens >> token) {
+                entry.dependencies.push_back(token);
+            }
+        }
+
+        add(std::move(entry));
+    }
+    return true;
+}
+
+void SceneManifest::add(ManifestEntry entry) {
+    if (auto it = index.find(entry.id); it != index.end()) {
+        entries[it->second] = std::move(entry);
+        return;
+    }
+    index[entry.id] = entries.size();
+    entries.push_back(std::move(entry));
+}
+
+const ManifestEntry* SceneManifest::find(const std::string& id) const {
+    auto it = index.find(id);
+    return it != index.end() ? &entries[it->second] : nullptr;
+}
+
+std::vector<size_t> SceneManifest::getLoadOrder() const {
+    // Depth-first topological sort; dependencies outside the manifest are assumed resident
+    enum class Mark { None, Visiting, Done };
+    std::vector<Mark> marks(entries.size(), Mark::None);
+    std::vector<size_t> order;
+    order.reserve(entries.size());
+
+    std::function<bool(size_t)> visit = [&](size_t i) {
+        if (marks[i] == Mark::Done) return true;
+        if (marks[i] == Mark::Visiting) return false;  // cycle
+        marks[i] = Mark::Visiting;
+        for (const auto& dependency : entries[i].dependencies) {
+            if (auto it = index.find(dependency); it != index.end() && !visit(it->second)) {
+                return false;
+            }
+        }
+        marks[i] = Mark::Done;
+        order.push_back(i);
+        return true;
+    };
+
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (!visit(i)) return {};
+    }
+    return order;
+}
+
+ManifestDiff SceneManifest::diff(const SceneManifest& from, const SceneManifest& to) {
+    ManifestDiff result;
+    for (const auto& entry : to.entries) {
+        const ManifestEntry* previous = from.find(entry.id);
+        if (previous && previous->type == entry.type && previous->path == entry.path) {
+            result.kept.push_back(entry.id);
+        } else {
+            result.added.push_back(entry);
+        }
+    }
+    for (const auto& entry : from.entries) {
+        const ManifestEntry* next = to.find(entry.id);
+        if (!next || next->type != entry.type || next->path != entry.path) {
+            result.removed.push_back(entry);
+        }
+    }
+    return result;
+}
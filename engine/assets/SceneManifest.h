@@ -0,0 +1,55 @@
+#ifndef ENGINE_SCENEMANIFEST_H
+#define ENGINE_SCENEMANIFEST_H
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AssetTypes.h"
+
+struct ManifestEntry {
+    std::string id;
+    AssetType type;
+    std::string path;
+    std::vector<std::string> dependencies;  // ids that must be resident before this one loads
+};
+
+// Result of comparing two manifests, e.g. when switching maps
+struct ManifestDiff {
+    std::vector<ManifestEntry> added;    // in the new manifest only (or moved to another path)
+    std::vector<ManifestEntry> removed;  // in the old manifest only
+    std::vector<std::string> kept;       // ids shared by both
+};
+
+// Declares every asset a scene needs, so they can be preloaded before gameplay starts
+//
+// Text format, one asset per line:
+//   <type> <id> <path> [: <dependency id>...]
+// where type is texture or shader; '#' starts a comment
+class SceneManifest {
+public:
+    SceneManifest() = default;
+
+    // Load from a manifest file, nullptr on parse errors or dependency cycles
+    static std::unique_ptr<SceneManifest> fromFile(const std::string& path);
+
+    bool parse(std::istream& input, const std::string& sourceName = "<manifest>");
+    void add(ManifestEntry entry);
+
+    const std::vector<ManifestEntry>& getEntries() const { return entries; }
+    const ManifestEntry* find(const std::string& id) const;
+    bool empty() const { return entries.empty(); }
+
+    // Entry indices ordered so dependencies come first; empty if there is a cycle
+    std::vector<size_t> getLoadOrder() const;
+
+    static ManifestDiff diff(const SceneManifest& from, const SceneManifest& to);
+
+private:
+    std::vector<ManifestEntry> entries;
+    std::unordered_map<std::string, size_t> index;
+};
+
+#endif //ENGINE_SCENEMANIFEST_H
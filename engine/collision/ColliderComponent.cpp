@@ -0,0 +1,21 @@
+#include "ColliderComponent.h"
+#include "CollisionWorld.h"
+#include "entity/Entity.h"
+#include "transform/TransformComponent.h"
+
+ColliderComponent::ColliderComponent(CollisionWorld& world, const CollisionShape& shape, uint32_t layer, uint32_t mask)
+    : world(world), id(world.add(shape, 0.0f, 0.0f, 0.0f, layer, mask)) {}
+
+ColliderComponent::~ColliderComponent() {
+    world.remove(id);
+}
+
+void ColliderComponent::setStatic(bool value) {
+    world.setStatic(id, value);
+}
+
+void ColliderComponent::update(float dt) {
+    if (auto* transform = getComponent<TransformComponent>("transform")) {
+        world.setPose(id, transform->position.x, transform->position.y, transform->rotation);
+    }
+}
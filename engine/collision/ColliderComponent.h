@@ -0,0 +1,35 @@
+#ifndef ENGINE_COLLIDERCOMPONENT_H
+#define ENGINE_COLLIDERCOMPONENT_H
+
+#include <cstdint>
+
+#include "CollisionShape.h"
+#include "component/Component.h"
+
+class CollisionWorld;
+
+// Registers the entity with a CollisionWorld and keeps the collider on the entity's transform
+// The world must outlive the component; contacts are read back from the world by id
+class ColliderComponent : public Component {
+public:
+    ColliderComponent(CollisionWorld& world, const CollisionShape& shape, uint32_t layer = 1, uint32_t mask = ~0u);
+    ~ColliderComponent() override;
+
+    ColliderComponent(const ColliderComponent&) = delete;
+    ColliderComponent& operator=(const ColliderComponent&) = delete;
+
+    ColliderId getId() const { return id; }
+    CollisionWorld& getWorld() { return world; }
+
+    // Static colliders (walls) are only tested against moving ones
+    void setStatic(bool value);
+
+    // Component interface: copies position and rotation from the transform
+    void update(float dt) override;
+
+private:
+    CollisionWorld& world;
+    ColliderId id;
+};
+
+#endif //ENGINE_COLLIDERCOMPONENT_H
@@ -0,0 +1,55 @@
+#ifndef ENGINE_COLLISIONSHAPE_H
+#define ENGINE_COLLISIONSHAPE_H
+
+#include <cstddef>
+#include <cstdint>
+
+using ColliderId = uint32_t;
+constexpr ColliderId invalidCollider = ~0u;
+
+enum class ShapeType : uint8_t {
+    Aabb,       // axis-aligned box, ignores rotation
+    Circle,
+    Obb         // box rotated with the collider
+};
+
+// Collision geometry in world units, centred on the collider's position
+// Independent of the transform's scale, so a sprite can have a tighter hull than its quad
+struct CollisionShape {
+    ShapeType type = ShapeType::Aabb;
+    float halfWidth = 0.5f;     // boxes
+    float halfHeight = 0.5f;
+    float radius = 0.5f;        // circles
+
+    static CollisionShape box(float halfWidth, float halfHeight) { return {ShapeType::Aabb, halfWidth, halfHeight, 0.0f}; }
+    static CollisionShape orientedBox(float halfWidth, float halfHeight) { return {ShapeType::Obb, halfWidth, halfHeight, 0.0f}; }
+    static CollisionShape circle(float radius) { return {ShapeType::Circle, 0.0f, 0.0f, radius}; }
+};
+
+// One overlapping pair, a < b; the normal points from a towards b and depth is the penetration along it
+struct ContactPair {
+    ColliderId a;
+    ColliderId b;
+    float normalX;
+    float normalY;
+    float depth;
+};
+
+// Closest collider along a segment
+struct RaycastHit {
+    ColliderId collider = invalidCollider;
+    float fraction = 1.0f;          // along the segment, 0 = start, 1 = end
+    float normalX = 0.0f;           // surface normal at the hit, facing the ray
+    float normalY = 0.0f;
+};
+
+struct CollisionStats {
+    size_t colliders = 0;
+    size_t candidatePairs = 0;      // bounds overlaps from the broadphase
+    size_t contacts = 0;            // confirmed by the narrowphase
+    size_t sortSwaps = 0;           // insertion sort moves this step; low when motion is coherent
+    double broadphaseMillis = 0.0;
+    double narrowphaseMillis = 0.0;
+};
+
+#endif //ENGINE_COLLISIONSHAPE_H
@@ -0,0 +1,679 @@
+#include "CollisionWorld.h"
+#include "jobs/JobSystem.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COLLISION_SSE 1
+#endif
+
+namespace {
+    // Below this many colliders per slice, threading costs more than it saves
+    constexpr size_t sweepGrain = 4096;
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+
+    // Colliders wider than this are left out of the ray query window and always tested
+    constexpr float wideCollider = 32.0f;
+
+    // Keep a < b so the same pair always reads the same way; the normal flips with the swap
+    ContactPair makeContact(ColliderId a, ColliderId b, float normalX, float normalY, float depth) {
+        if (a < b) return {a, b, normalX, normalY, depth};
+        return {b, a, -normalX, -normalY, depth};
+    }
+
+    void circleContact(ColliderId a, ColliderId b, float dx, float dy, float distance, float radii, std::vector<ContactPair>& out) {
+        // Coincident centres have no direction; any axis separates them
+        if (distance > 1e-6f) {
+            out.push_back(makeContact(a, b, dx / distance, dy / distance, radii - distance));
+        } else {
+            out.push_back(makeContact(a, b, 1.0f, 0.0f, radii));
+        }
+    }
+
+    void boxContact(ColliderId a, ColliderId b, float dx, float dy, float overlapX, float overlapY, std::vector<ContactPair>& out) {
+        // Separate along the axis of least penetration
+        if (overlapX < overlapY) {
+            out.push_back(makeContact(a, b, dx < 0.0f ? -1.0f : 1.0f, 0.0f, overlapX));
+        } else {
+            out.push_back(makeContact(a, b, 0.0f, dy < 0.0f ? -1.0f : 1.0f, overlapY));
+        }
+    }
+}
+
+CollisionWorld::CollisionWorld(JobSystem* jobs) : jobs(jobs) {}
+
+ColliderId CollisionWorld::add(const CollisionShape& shape, float x, float y, float rotation,
+                               uint32_t collisionLayer, uint32_t collisionMask, bool isStatic) {
+    ColliderId id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    } else {
+        id = static_cast<ColliderId>(active.size());
+        const size_t count = static_cast<size_t>(id) + 1;
+        for (auto* array : {&positionX, &positionY, &rotationCos, &rotationSin, &halfWidth, &halfHeight, &radius,
+                            &minX, &maxX, &minY, &maxY}) {
+            array->resize(count, 0.0f);
+        }
+        type.resize(count, ShapeType::Aabb);
+        layer.resize(count, 0);
+        mask.resize(count, 0);
+        active.resize(count, 0);
+        staticFlag.resize(count, 0);
+    }
+
+    active[id] = 1;
+    layer[id] = collisionLayer;
+    mask[id] = collisionMask;
+    staticFlag[id] = isStatic ? 1 : 0;
+    type[id] = shape.type;
+    halfWidth[id] = shape.halfWidth;
+    halfHeight[id] = shape.halfHeight;
+    radius[id] = shape.radius;
+    positionX[id] = x;
+    positionY[id] = y;
+    rotationCos[id] = std::cos(rotation);
+    rotationSin[id] = std::sin(rotation);
+    updateBounds(id);
+
+    // Appended out of place; the next sort moves it to its slot
+    order.push_back(id);
+    return id;
+}
+
+void CollisionWorld::remove(ColliderId id) {
+    if (!isValid(id)) return;
+
+    active[id] = 0;
+    order.erase(std::find(order.begin(), order.end(), id));
+    freeIds.push_back(id);
+    queriesDirty = true;
+    version++;
+}
+
+void CollisionWorld::setPose(ColliderId id, float x, float y, float rotation) {
+    if (!isValid(id)) return;
+
+    // Components push their pose every tick; a collider that did not move keeps the order and version
+    const float c = std::cos(rotation);
+    const float s = std::sin(rotation);
+    if (positionX[id] == x && positionY[id] == y && rotationCos[id] == c && rotationSin[id] == s) return;
+
+    positionX[id] = x;
+    positionY[id] = y;
+    rotationCos[id] = c;
+    rotationSin[id] = s;
+    updateBounds(id);
+}
+
+void CollisionWorld::setShape(ColliderId id, const CollisionShape& shape) {
+    if (!isValid(id)) return;
+
+    type[id] = shape.type;
+    halfWidth[id] = shape.halfWidth;
+    halfHeight[id] = shape.halfHeight;
+    radius[id] = shape.radius;
+    updateBounds(id);
+}
+
+void CollisionWorld::setFilter(ColliderId id, uint32_t collisionLayer, uint32_t collisionMask) {
+    if (!isValid(id)) return;
+    layer[id] = collisionLayer;
+    mask[id] = collisionMask;
+    version++;
+}
+
+void CollisionWorld::setStatic(ColliderId id, bool value) {
+    if (!isValid(id)) return;
+    const uint8_t flag = value ? 1 : 0;
+    if (staticFlag[id] == flag) return;
+    staticFlag[id] = flag;
+    version++;
+}
+
+CollisionShape CollisionWorld::getShape(ColliderId id) const {
+    if (!isValid(id)) return {};
+    return {type[id], halfWidth[id], halfHeight[id], radius[id]};
+}
+
+void CollisionWorld::getBounds(ColliderId id, float& outMinX, float& outMinY, float& outMaxX, float& outMaxY) const {
+    if (!isValid(id)) {
+        outMinX = outMinY = outMaxX = outMaxY = 0.0f;
+        return;
+    }
+    outMinX = minX[id];
+    outMinY = minY[id];
+    outMaxX = maxX[id];
+    outMaxY = maxY[id];
+}
+
+void CollisionWorld::updateBounds(ColliderId id) {
+    float extentX = halfWidth[id];
+    float extentY = halfHeight[id];
+    if (type[id] == ShapeType::Circle) {
+        extentX = extentY = radius[id];
+    } else if (type[id] == ShapeType::Obb) {
+        const float c = std::abs(rotationCos[id]);
+        const float s = std::abs(rotationSin[id]);
+        extentX = halfWidth[id] * c + halfHeight[id] * s;
+        extentY = halfWidth[id] * s + halfHeight[id] * c;
+    }
+    minX[id] = positionX[id] - extentX;
+    maxX[id] = positionX[id] + extentX;
+    minY[id] = positionY[id] - extentY;
+    maxY[id] = positionY[id] + extentY;
+    queriesDirty = true;
+    version++;
+}
+
+void CollisionWorld::sortOrder() {
+    // Last tick's order is nearly right when things move a little, so insertion sort is close to linear
+    // Past a budget of moves (first tick, mass spawns, teleports) a full sort is cheaper
+    const size_t budget = order.size() * 8 + 64;
+    size_t swaps = 0;
+    for (size_t i = 1; i < order.size(); ++i) {
+        const ColliderId id = order[i];
+        const float key = minX[id];
+        size_t j = i;
+        while (j > 0 && minX[order[j - 1]] > key) {
+            order[j] = order[j - 1];
+            --j;
+        }
+        order[j] = id;
+        swaps += i - j;
+
+        if (swaps > budget) {
+            std::stable_sort(order.begin(), order.end(), [this](ColliderId a, ColliderId b) {
+                return minX[a] < minX[b];
+            });
+            break;
+        }
+    }
+    stats.sortSwaps = swaps;
+}
+
+void CollisionWorld::gatherSorted() {
+    const size_t count = order.size();
+    for (auto* array : {&sortedMinX, &sortedMaxX, &sortedMinY, &sortedMaxY}) {
+        array->resize(count + 4);
+    }
+    queryWidth = 0.0f;
+    wideColliders.clear();
+    for (size_t i = 0; i < count; ++i) {
+        const ColliderId id = order[i];
+        sortedMinX[i] = minX[id];
+        sortedMaxX[i] = maxX[id];
+        sortedMinY[i] = minY[id];
+        sortedMaxY[i] = maxY[id];
+
+        const float width = maxX[id] - minX[id];
+        if (width > wideCollider) {
+            wideColliders.push_back(id);
+        } else {
+            queryWidth = std::max(queryWidth, width);
+        }
+    }
+    // Sentinels overlap nothing, which ends every sweep
+    for (size_t i = count; i < count + 4; ++i) {
+        sortedMinX[i] = infinity;
+        sortedMaxX[i] = -infinity;
+        sortedMinY[i] = infinity;
+        sortedMaxY[i] = -infinity;
+    }
+    queriesDirty = false;
+}
+
+void CollisionWorld::addCandidate(ColliderId a, ColliderId b, Slice& slice) const {
+    if (staticFlag[a] && staticFlag[b]) return;
+    if (!(layer[a] & mask[b]) || !(layer[b] & mask[a])) return;
+
+    // Bucketed by shape so the common cases run through the SIMD kernels
+    std::vector<ColliderId>* pairs = &slice.otherPairs;
+    if (type[a] == ShapeType::Circle && type[b] == ShapeType::Circle) {
+        pairs = &slice.circlePairs;
+    } else if (type[a] == ShapeType::Aabb && type[b] == ShapeType::Aabb) {
+        pairs = &slice.boxPairs;
+    }
+    pairs->push_back(a);
+    pairs->push_back(b);
+}
+
+void CollisionWorld::sweep(size_t begin, size_t end, Slice& slice) const {
+    for (size_t i = begin; i < end; ++i) {
+        const ColliderId a = order[i];
+        const float aMaxX = sortedMaxX[i];
+        const float aMinY = sortedMinY[i];
+        const float aMaxY = sortedMaxY[i];
+        size_t j = i + 1;
+
+#ifdef COLLISION_SSE
+        // Four neighbours per step; the X test fails for good once one lane does, since minX is sorted
+        const __m128 maxXV = _mm_set1_ps(aMaxX);
+        const __m128 minYV = _mm_set1_ps(aMinY);
+        const __m128 maxYV = _mm_set1_ps(aMaxY);
+        for (;; j += 4) {
+            const __m128 inX = _mm_cmple_ps(_mm_loadu_ps(&sortedMinX[j]), maxXV);
+            const int xMask = _mm_movemask_ps(inX);
+            if (xMask == 0) break;
+
+            const __m128 inY = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&sortedMinY[j]), maxYV),
+                                          _mm_cmpge_ps(_mm_loadu_ps(&sortedMaxY[j]), minYV));
+            unsigned int hits = static_cast<unsigned int>(_mm_movemask_ps(_mm_and_ps(inX, inY)));
+            while (hits) {
+                addCandidate(a, order[j + std::countr_zero(hits)], slice);
+                hits &= hits - 1;
+            }
+            if (xMask != 0xF) break;
+        }
+#else
+        for (; sortedMinX[j] <= aMaxX; ++j) {
+            if (sortedMinY[j] <= aMaxY && sortedMaxY[j] >= aMinY) {
+                addCandidate(a, order[j], slice);
+            }
+        }
+#endif
+    }
+}
+
+void CollisionWorld::testCircles(const std::vector<ColliderId>& pairs, std::vector<ContactPair>& out) const {
+    const size_t count = pairs.size() / 2;
+    size_t i = 0;
+
+#ifdef COLLISION_SSE
+    // Gathered four pairs at a time; most candidates miss, so one movemask usually ends the block
+    for (; i + 4 <= count; i += 4) {
+        alignas(16) float ax[4], ay[4], bx[4], by[4], radii[4];
+        for (size_t k = 0; k < 4; ++k) {
+            const ColliderId a = pairs[2 * (i + k)];
+            const ColliderId b = pairs[2 * (i + k) + 1];
+            ax[k] = positionX[a];
+            ay[k] = positionY[a];
+            bx[k] = positionX[b];
+            by[k] = positionY[b];
+            radii[k] = radius[a] + radius[b];
+        }
+        const __m128 dx = _mm_sub_ps(_mm_load_ps(bx), _mm_load_ps(ax));
+        const __m128 dy = _mm_sub_ps(_mm_load_ps(by), _mm_load_ps(ay));
+        const __m128 r = _mm_load_ps(radii);
+        const __m128 distanceSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        unsigned int hits = static_cast<unsigned int>(_mm_movemask_ps(_mm_cmplt_ps(distanceSq, _mm_mul_ps(r, r))));
+        if (hits == 0) continue;
+
+        alignas(16) float dxOut[4], dyOut[4], distance[4];
+        _mm_store_ps(dxOut, dx);
+        _mm_store_ps(dyOut, dy);
+        _mm_store_ps(distance, _mm_sqrt_ps(distanceSq));
+        while (hits) {
+            const int k = std::countr_zero(hits);
+            hits &= hits - 1;
+            circleContact(pairs[2 * (i + k)], pairs[2 * (i + k) + 1], dxOut[k], dyOut[k], distance[k], radii[k], out);
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const ColliderId a = pairs[2 * i];
+        const ColliderId b = pairs[2 * i + 1];
+        const float dx = positionX[b] - positionX[a];
+        const float dy = positionY[b] - positionY[a];
+        const float radii = radius[a] + radius[b];
+        const float distanceSq = dx * dx + dy * dy;
+        if (distanceSq < radii * radii) {
+            circleContact(a, b, dx, dy, std::sqrt(distanceSq), radii, out);
+        }
+    }
+}
+
+void CollisionWorld::testBoxes(const std::vector<ColliderId>& pairs, std::vector<ContactPair>& out) const {
+    const size_t count = pairs.size() / 2;
+    size_t i = 0;
+
+#ifdef COLLISION_SSE
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= count; i += 4) {
+        alignas(16) float ax[4], ay[4], bx[4], by[4], extentX[4], extentY[4];
+        for (size_t k = 0; k < 4; ++k) {
+            const ColliderId a = pairs[2 * (i + k)];
+            const ColliderId b = pairs[2 * (i + k) + 1];
+            ax[k] = positionX[a];
+            ay[k] = positionY[a];
+            bx[k] = positionX[b];
+            by[k] = positionY[b];
+            extentX[k] = halfWidth[a] + halfWidth[b];
+            extentY[k] = halfHeight[a] + halfHeight[b];
+        }
+        const __m128 dx = _mm_sub_ps(_mm_load_ps(bx), _mm_load_ps(ax));
+        const __m128 dy = _mm_sub_ps(_mm_load_ps(by), _mm_load_ps(ay));
+        const __m128 overlapX = _mm_sub_ps(_mm_load_ps(extentX), _mm_andnot_ps(signMask, dx));
+        const __m128 overlapY = _mm_sub_ps(_mm_load_ps(extentY), _mm_andnot_ps(signMask, dy));
+        unsigned int hits = static_cast<unsigned int>(_mm_movemask_ps(
+            _mm_and_ps(_mm_cmpgt_ps(overlapX, zero), _mm_cmpgt_ps(overlapY, zero))));
+        if (hits == 0) continue;
+
+        alignas(16) float dxOut[4], dyOut[4], overlapXOut[4], overlapYOut[4];
+        _mm_store_ps(dxOut, dx);
+        _mm_store_ps(dyOut, dy);
+        _mm_store_ps(overlapXOut, overlapX);
+        _mm_store_ps(overlapYOut, overlapY);
+        while (hits) {
+            const int k = std::countr_zero(hits);
+            hits &= hits - 1;
+            boxContact(pairs[2 * (i + k)], pairs[2 * (i + k) + 1], dxOut[k], dyOut[k], overlapXOut[k], overlapYOut[k], out);
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const ColliderId a = pairs[2 * i];
+        const ColliderId b = pairs[2 * i + 1];
+        const float dx = positionX[b] - positionX[a];
+        const float dy = positionY[b] - positionY[a];
+        const float overlapX = halfWidth[a] + halfWidth[b] - std::abs(dx);
+        const float overlapY = halfHeight[a] + halfHeight[b] - std::abs(dy);
+        if (overlapX > 0.0f && overlapY > 0.0f) {
+            boxContact(a, b, dx, dy, overlapX, overlapY, out);
+        }
+    }
+}
+
+bool CollisionWorld::testPair(ColliderId a, ColliderId b, ContactPair& out) const {
+    const bool circleA = type[a] == ShapeType::Circle;
+    const bool circleB = type[b] == ShapeType::Circle;
+    if (circleA && circleB) {
+        const float dx = positionX[b] - positionX[a];
+        const float dy = positionY[b] - positionY[a];
+        const float radii = radius[a] + radius[b];
+        const float distanceSq = dx * dx + dy * dy;
+        if (distanceSq >= radii * radii) return false;
+
+        const float distance = std::sqrt(distanceSq);
+        out = distance > 1e-6f ? makeContact(a, b, dx / distance, dy / distance, radii - distance)
+                               : makeContact(a, b, 1.0f, 0.0f, radii);
+        return true;
+    }
+    if (circleA) return testCircleBox(a, b, out);
+    if (circleB) return testCircleBox(b, a, out);
+    return testBoxPair(a, b, out);
+}
+
+bool CollisionWorld::testBoxPair(ColliderId a, ColliderId b, ContactPair& out) const {
+    // Separating axis test over both boxes' edge normals; axis-aligned boxes have no rotation
+    const float ca = type[a] == ShapeType::Obb ? rotationCos[a] : 1.0f;
+    const float sa = type[a] == ShapeType::Obb ? rotationSin[a] : 0.0f;
+    const float cb = type[b] == ShapeType::Obb ? rotationCos[b] : 1.0f;
+    const float sb = type[b] == ShapeType::Obb ? rotationSin[b] : 0.0f;
+    const float axesX[4] = {ca, -sa, cb, -sb};
+    const float axesY[4] = {sa, ca, sb, cb};
+
+    const float dx = positionX[b] - positionX[a];
+    const float dy = positionY[b] - positionY[a];
+
+    float depth = infinity;
+    float normalX = 1.0f, normalY = 0.0f;
+    for (int k = 0; k < 4; ++k) {
+        const float lx = axesX[k];
+        const float ly = axesY[k];
+        const float extentA = halfWidth[a] * std::abs(ca * lx + sa * ly) + halfHeight[a] * std::abs(-sa * lx + ca * ly);
+        const float extentB = halfWidth[b] * std::abs(cb * lx + sb * ly) + halfHeight[b] * std::abs(-sb * lx + cb * ly);
+        const float distance = dx * lx + dy * ly;
+        const float overlap = extentA + extentB - std::abs(distance);
+        if (overlap <= 0.0f) return false;
+
+        if (overlap < depth) {
+            depth = overlap;
+            normalX = distance < 0.0f ? -lx : lx;
+            normalY = distance < 0.0f ? -ly : ly;
+        }
+    }
+    out = makeContact(a, b, normalX, normalY, depth);
+    return true;
+}
+
+bool CollisionWorld::testCircleBox(ColliderId circle, ColliderId box, ContactPair& out) const {
+    const float c = type[box] == ShapeType::Obb ? rotationCos[box] : 1.0f;
+    const float s = type[box] == ShapeType::Obb ? rotationSin[box] : 0.0f;
+
+    // Circle centre in the box's frame
+    const float dx = positionX[circle] - positionX[box];
+    const float dy = positionY[circle] - positionY[box];
+    const float localX = dx * c + dy * s;
+    const float localY = -dx * s + dy * c;
+    const float hw = halfWidth[box];
+    const float hh = halfHeight[box];
+    const float r = radius[circle];
+
+    // Normal from the box towards the circle, in box space
+    float normalX, normalY, depth;
+    const float closestX = std::clamp(localX, -hw, hw);
+    const float closestY = std::clamp(localY, -hh, hh);
+    if (closestX != localX || closestY != localY) {
+        const float offsetX = localX - closestX;
+        const float offsetY = localY - closestY;
+        const float distanceSq = offsetX * offsetX + offsetY * offsetY;
+        if (distanceSq >= r * r) return false;
+
+        const float distance = std::sqrt(distanceSq);
+        normalX = offsetX / distance;
+        normalY = offsetY / distance;
+        depth = r - distance;
+    } else {
+        // Centre inside the box: push out through the nearest face
+        const float faceX = hw - std::abs(localX);
+        const float faceY = hh - std::abs(localY);
+        if (faceX < faceY) {
+            normalX = localX < 0.0f ? -1.0f : 1.0f;
+            normalY = 0.0f;
+            depth = faceX + r;
+        } else {
+            normalX = 0.0f;
+            normalY = localY < 0.0f ? -1.0f : 1.0f;
+            depth = faceY + r;
+        }
+    }
+
+    // Back to world space, flipped to point from the circle towards the box
+    const float worldX = normalX * c - normalY * s;
+    const float worldY = normalX * s + normalY * c;
+    out = makeContact(circle, box, -worldX, -worldY, depth);
+    return true;
+}
+
+void CollisionWorld::narrowphase(Slice& slice) const {
+    slice.contacts.clear();
+    testCircles(slice.circlePairs, slice.contacts);
+    testBoxes(slice.boxPairs, slice.contacts);
+
+    ContactPair contact;
+    for (size_t i = 0; i + 1 < slice.otherPairs.size(); i += 2) {
+        if (testPair(slice.otherPairs[i], slice.otherPairs[i + 1], contact)) {
+            slice.contacts.push_back(contact);
+        }
+    }
+}
+
+void CollisionWorld::detect() {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    sortOrder();
+    gatherSorted();
+
+    // Contiguous slices of the sort order; each keeps its own pair lists, so no locking
+    const size_t count = order.size();
+    size_t sliceCount = 1;
+    if (jobs && count > sweepGrain) {
+        sliceCount = std::min((count + sweepGrain - 1) / sweepGrain, static_cast<size_t>(jobs->getWorkerCount() + 1) * 4);
+    }
+    slices.resize(sliceCount);
+
+    auto sweepSlices = [this, count, sliceCount](size_t begin, size_t end) {
+        for (size_t s = begin; s < end; ++s) {
+            Slice& slice = slices[s];
+            slice.circlePairs.clear();
+            slice.boxPairs.clear();
+            slice.otherPairs.clear();
+            sweep(count * s / sliceCount, count * (s + 1) / sliceCount, slice);
+        }
+    };
+    auto testSlices = [this](size_t begin, size_t end) {
+        for (size_t s = begin; s < end; ++s) {
+            narrowphase(slices[s]);
+        }
+    };
+
+    if (sliceCount > 1) {
+        jobs->parallelFor(sliceCount, 1, sweepSlices);
+    } else {
+        sweepSlices(0, sliceCount);
+    }
+    const auto swept = Clock::now();
+
+    if (sliceCount > 1) {
+        jobs->parallelFor(sliceCount, 1, testSlices);
+    } else {
+        testSlices(0, sliceCount);
+    }
+
+    // Slice order follows the sort order, so the same poses always give the same contact list
+    contacts.clear();
+    stats.candidatePairs = 0;
+    for (const Slice& slice : slices) {
+        stats.candidatePairs += (slice.circlePairs.size() + slice.boxPairs.size() + slice.otherPairs.size()) / 2;
+        contacts.insert(contacts.end(), slice.contacts.begin(), slice.contacts.end());
+    }
+    const auto tested = Clock::now();
+
+    stats.colliders = count;
+    stats.contacts = contacts.size();
+    stats.broadphaseMillis = std::chrono::duration<double, std::milli>(swept - start).count();
+    stats.narrowphaseMillis = std::chrono::duration<double, std::milli>(tested - swept).count();
+}
+
+void CollisionWorld::prepareQueries() {
+    if (!queriesDirty) return;
+    sortOrder();
+    gatherSorted();
+}
+
+void CollisionWorld::testRay(ColliderId id, float x0, float y0, float dx, float dy, uint32_t queryMask, ColliderId ignore, RaycastHit& best) const {
+    if (id == ignore || !(layer[id] & queryMask)) return;
+
+    const float offsetX = x0 - positionX[id];
+    const float offsetY = y0 - positionY[id];
+    float fraction, normalX, normalY;
+
+    if (type[id] == ShapeType::Circle) {
+        // |offset + t * d| = r, nearest root in [0, 1]; a start inside the circle hits at once
+        const float r = radius[id];
+        const float a = dx * dx + dy * dy;
+        const float b = offsetX * dx + offsetY * dy;
+        const float c = offsetX * offsetX + offsetY * offsetY - r * r;
+        if (c <= 0.0f) {
+            fraction = 0.0f;
+        } else {
+            const float discriminant = b * b - a * c;
+            if (a <= 0.0f || discriminant < 0.0f) return;
+            fraction = (-b - std::sqrt(discriminant)) / a;
+            if (fraction < 0.0f || fraction > 1.0f) return;
+        }
+        normalX = offsetX + fraction * dx;
+        normalY = offsetY + fraction * dy;
+        const float length = std::sqrt(normalX * normalX + normalY * normalY);
+        if (length > 1e-6f) {
+            normalX /= length;
+            normalY /= length;
+        } else {
+            normalX = 1.0f;
+            normalY = 0.0f;
+        }
+    } else {
+        // Slabs in the box's frame; axis-aligned boxes have no rotation
+        const float c = type[id] == ShapeType::Obb ? rotationCos[id] : 1.0f;
+        const float s = type[id] == ShapeType::Obb ? rotationSin[id] : 0.0f;
+        const float origin[2] = {offsetX * c + offsetY * s, -offsetX * s + offsetY * c};
+        const float direction[2] = {dx * c + dy * s, -dx * s + dy * c};
+        const float extent[2] = {halfWidth[id], halfHeight[id]};
+
+        float enter = -infinity, exit = infinity;
+        int enterAxis = -1;
+        float enterSign = 0.0f;
+        for (int axis = 0; axis < 2; ++axis) {
+            if (std::abs(direction[axis]) < 1e-12f) {
+                if (std::abs(origin[axis]) > extent[axis]) return;
+                continue;
+            }
+            float slabEnter = (-extent[axis] - origin[axis]) / direction[axis];
+            float slabExit = (extent[axis] - origin[axis]) / direction[axis];
+            // The face entered first has its normal against the ray
+            float sign = -1.0f;
+            if (slabEnter > slabExit) {
+                std::swap(slabEnter, slabExit);
+                sign = 1.0f;
+            }
+            if (slabEnter > enter) {
+                enter = slabEnter;
+                enterAxis = axis;
+                enterSign = sign;
+            }
+            exit = std::min(exit, slabExit);
+        }
+        if (enter > exit || exit < 0.0f || enter > 1.0f) return;
+
+        // A start inside the box hits at once
+        fraction = std::max(enter, 0.0f);
+        const float localX = enterAxis == 0 ? enterSign : 0.0f;
+        const float localY = enterAxis == 1 ? enterSign : 0.0f;
+        normalX = localX * c - localY * s;
+        normalY = localX * s + localY * c;
+    }
+
+    // Ties go to the lower id, so the answer does not depend on search order
+    if (fraction < best.fraction || (fraction == best.fraction && id < best.collider)) {
+        best = {id, fraction, normalX, normalY};
+    }
+}
+
+bool CollisionWorld::raycast(float x0, float y0, float x1, float y1, uint32_t queryMask, RaycastHit& out, ColliderId ignore) const {
+    const float dx = x1 - x0;
+    const float dy = y1 - y0;
+    RaycastHit best;
+    best.fraction = infinity;
+
+    if (queriesDirty) {
+        for (const ColliderId id : order) {
+            testRay(id, x0, y0, dx, dy, queryMask, ignore, best);
+        }
+    } else {
+        const float rayMinX = std::min(x0, x1), rayMaxX = std::max(x0, x1);
+        const float rayMinY = std::min(y0, y1), rayMaxY = std::max(y0, y1);
+
+        // Everything overlapping the ray's X range starts no further left than the widest collider allows
+        const size_t count = order.size();
+        const auto first = sortedMinX.begin();
+        const size_t begin = std::lower_bound(first, first + count, rayMinX - queryWidth) - first;
+        const size_t end = std::upper_bound(first + begin, first + count, rayMaxX) - first;
+        for (size_t i = begin; i < end; ++i) {
+            if (sortedMaxX[i] < rayMinX || sortedMinY[i] > rayMaxY || sortedMaxY[i] < rayMinY) continue;
+            testRay(order[i], x0, y0, dx, dy, queryMask, ignore, best);
+        }
+        for (const ColliderId id : wideColliders) {
+            if (maxX[id] < rayMinX || minX[id] > rayMaxX || minY[id] > rayMaxY || maxY[id] < rayMinY) continue;
+            testRay(id, x0, y0, dx, dy, queryMask, ignore, best);
+        }
+    }
+
+    if (best.collider == invalidCollider) return false;
+    out = best;
+    return true;
+}
+
+void CollisionWorld::reportStats(std::ostream& out) const {
+    out << "Collision: " << stats.colliders << " colliders, " << stats.candidatePairs << " candidate pairs, "
+        << stats.contacts << " contacts (" << stats.sortSwaps << " sort moves), broadphase "
+        << stats.broadphaseMillis << " ms + narrowphase " << stats.narrowphaseMillis << " ms" << std::endl;
+}
@@ -0,0 +1,117 @@
+#ifndef ENGINE_COLLISIONWORLD_H
+#define ENGINE_COLLISIONWORLD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "CollisionShape.h"
+#include "service/IService.h"
+
+class JobSystem;
+
+// Finds overlapping colliders once per simulation tick
+// Broadphase: sort-and-sweep along X. The sort order is kept between ticks and repaired with an
+// insertion sort, which is close to linear when things move a little each tick; the sweep tests
+// four neighbours' Y extents per SSE compare. Narrowphase: circle/circle and box/box pairs run four
+// at a time, rotated boxes and mixed pairs go through the scalar SAT / closest-point tests.
+// Colliders live in flat per-attribute arrays indexed by id; ids are reused after remove()
+class CollisionWorld : public IService {
+public:
+    explicit CollisionWorld(JobSystem* jobs = nullptr);
+
+    // Layers: a pair is tested when each side's layer is in the other's mask
+    // Static colliders (walls) are never paired with each other
+    ColliderId add(const CollisionShape& shape, float x, float y, float rotation = 0.0f,
+                   uint32_t collisionLayer = 1, uint32_t collisionMask = ~0u, bool isStatic = false);
+    void remove(ColliderId id);
+
+    // Rotation in radians, counter-clockwise; only oriented boxes use it
+    void setPose(ColliderId id, float x, float y, float rotation = 0.0f);
+    void setShape(ColliderId id, const CollisionShape& shape);
+    void setFilter(ColliderId id, uint32_t collisionLayer, uint32_t collisionMask);
+    void setStatic(ColliderId id, bool value);
+
+    bool isValid(ColliderId id) const { return id < active.size() && active[id]; }
+    CollisionShape getShape(ColliderId id) const;
+    void getBounds(ColliderId id, float& outMinX, float& outMinY, float& outMaxX, float& outMaxY) const;
+
+    // Broadphase + narrowphase over the current poses; the result replaces the previous contacts
+    void detect();
+
+    // Contacts of the last detect(), in a deterministic order for the same inputs
+    const std::vector<ContactPair>& getContacts() const { return contacts; }
+
+    // Closest collider crossed by the segment (x0, y0) -> (x1, y1) whose layer is in queryMask
+    // Searches the sweep order; after moving colliders call prepareQueries() first, or every
+    // collider is tested. Read-only, so many rays may be cast from worker threads at once
+    bool raycast(float x0, float y0, float x1, float y1, uint32_t queryMask, RaycastHit& out,
+                 ColliderId ignore = invalidCollider) const;
+
+    // Bring the sweep order up to date with poses set since the last detect()
+    void prepareQueries();
+
+    // Bumped whenever a query could answer differently: colliders added, removed, moved or refiltered
+    unsigned int getVersion() const { return version; }
+
+    size_t size() const { return order.size(); }
+    const CollisionStats& getStats() const { return stats; }
+    void reportStats(std::ostream& out) const;
+
+    // Driven from the fixed tick (WorldEngine::physicsTick), not the frame
+    void update(int dt) override {}
+
+private:
+    // One slice of the sweep, run on its own thread; results are concatenated in slice order
+    struct Slice {
+        std::vector<ColliderId> circlePairs;    // pairs, flattened a0 b0 a1 b1 ...
+        std::vector<ColliderId> boxPairs;
+        std::vector<ColliderId> otherPairs;
+        std::vector<ContactPair> contacts;
+    };
+
+    JobSystem* jobs;
+
+    // Per collider, indexed by id
+    std::vector<float> positionX, positionY;
+    std::vector<float> rotationCos, rotationSin;
+    std::vector<float> halfWidth, halfHeight, radius;
+    std::vector<float> minX, maxX, minY, maxY;
+    std::vector<ShapeType> type;
+    std::vector<uint32_t> layer, mask;
+    std::vector<uint8_t> active, staticFlag;
+    std::vector<ColliderId> freeIds;
+
+    // Active ids sorted by minX, carried over between ticks
+    std::vector<ColliderId> order;
+
+    // Bounds gathered in sweep order, padded with four sentinels so the SIMD sweep needs no bounds check
+    std::vector<float> sortedMinX, sortedMaxX, sortedMinY, sortedMaxY;
+    bool queriesDirty = true;           // poses changed since the sorted bounds were gathered
+    unsigned int version = 0;
+
+    // Ray queries search minX back by the widest collider; walls longer than that are kept apart
+    float queryWidth = 0.0f;
+    std::vector<ColliderId> wideColliders;
+
+    std::vector<Slice> slices;
+    std::vector<ContactPair> contacts;
+    CollisionStats stats;
+
+    void updateBounds(ColliderId id);
+    void sortOrder();
+    void gatherSorted();
+    void sweep(size_t begin, size_t end, Slice& slice) const;
+    void addCandidate(ColliderId a, ColliderId b, Slice& slice) const;
+    void narrowphase(Slice& slice) const;
+
+    void testCircles(const std::vector<ColliderId>& pairs, std::vector<ContactPair>& out) const;
+    void testBoxes(const std::vector<ColliderId>& pairs, std::vector<ContactPair>& out) const;
+    bool testPair(ColliderId a, ColliderId b, ContactPair& out) const;
+    bool testBoxPair(ColliderId a, ColliderId b, ContactPair& out) const;
+    bool testCircleBox(ColliderId circle, ColliderId box, ContactPair& out) const;
+    void testRay(ColliderId id, float x0, float y0, float dx, float dy, uint32_t queryMask, ColliderId ignore, RaycastHit& best) const;
+};
+
+#endif //ENGINE_COLLISIONWORLD_H
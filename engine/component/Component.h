@@ -10,6 +10,9 @@ public:
     Component();
     virtual ~Component() = default;
 
+    // Per-frame logic, called by the owning entity's update
+    virtual void update(float dt) {}
+
     template<typename TComponent>
         requires std::derived_from<TComponent, Component>
     TComponent* getComponent(const std::string& name);
@@ -17,7 +17,9 @@ bool Entity::removeComponent(std::string name) {
 }
 
 void Entity::update(float dt) {
-    // stub
+    for (auto& [name, component] : components) {
+        component->update(dt);
+    }
 }
 
 
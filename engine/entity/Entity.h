@@ -21,8 +21,14 @@ public:
         requires std::derived_from<TComponent, Component>
     TComponent* getComponent(std::string name);
     virtual void update(float dt);
+
+    // Static entities never move; the renderer bakes them into shared pre-transformed batches
+    // Call SceneRenderer::removeStatic before deleting or changing a baked entity
+    void setStatic(bool value) { isStaticEntity = value; }
+    bool isStatic() const { return isStaticEntity; }
 protected:
     long long uuid;
+    bool isStaticEntity = false;
 private:
     std::unordered_map<std::string, Component*> components;  // name -> component
 };
@@ -0,0 +1,37 @@
+#include "CameraController.h"
+#include "renderer/Camera.h"
+
+void CameraController::attach(InputManager* manager, Camera* target) {
+    input = manager;
+    camera = target;
+    if (!input) return;
+
+    forward = input->bindAction("camera_forward", Key::W);
+    back = input->bindAction("camera_back", Key::S);
+    left = input->bindAction("camera_left", Key::A);
+    right = input->bindAction("camera_right", Key::D);
+    up = input->bindAction("camera_up", Key::Space);
+    down = input->bindAction("camera_down", Key::Shift);
+    look = input->bindAction("camera_look", MouseButton::Right);
+}
+
+void CameraController::update(float deltaTime) {
+    if (!input || !camera) return;
+
+    // Camera movement (WASD + Space/Shift)
+    const float step = speed * deltaTime;
+    if (input->isActionPressed(forward)) camera->moveForward(step);
+    if (input->isActionPressed(back)) camera->moveForward(-step);
+    if (input->isActionPressed(left)) camera->moveRight(-step);
+    if (input->isActionPressed(right)) camera->moveRight(step);
+    if (input->isActionPressed(up)) camera->moveUp(step);
+    if (input->isActionPressed(down)) camera->moveUp(-step);
+
+    // Right-click toggles mouse capture
+    if (input->isActionJustPressed(look)) {
+        input->setCursorCaptured(!input->isCursorCaptured());
+    }
+    if (input->isCursorCaptured()) {
+        camera->processMouseMovement(input->getMouseDeltaX(), input->getMouseDeltaY(), sensitivity);
+    }
+}
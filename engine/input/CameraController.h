@@ -0,0 +1,38 @@
+#ifndef ENGINE_CAMERACONTROLLER_H
+#define ENGINE_CAMERACONTROLLER_H
+
+#include "InputManager.h"
+
+class Camera;
+
+// Free-fly camera driven by the InputManager: WASD + Space/Shift to move,
+// right-click toggles mouse look (FPS-style, like the Unity controller)
+class CameraController {
+public:
+    CameraController() = default;
+
+    // Binds the movement actions on the manager; both must outlive the controller
+    void attach(InputManager* input, Camera* camera);
+
+    void setCamera(Camera* value) { camera = value; }
+    Camera* getCamera() const { return camera; }
+
+    void update(float deltaTime);
+
+    float speed = 1.0f;          // world units per second
+    float sensitivity = 0.1f;    // degrees per pixel
+
+private:
+    InputManager* input = nullptr;
+    Camera* camera = nullptr;
+
+    ActionId forward = invalidAction;
+    ActionId back = invalidAction;
+    ActionId left = invalidAction;
+    ActionId right = invalidAction;
+    ActionId up = invalidAction;
+    ActionId down = invalidAction;
+    ActionId look = invalidAction;
+};
+
+#endif //ENGINE_CAMERACONTROLLER_H
@@ -0,0 +1,24 @@
+#ifndef ENGINE_IINPUTSOURCE_H
+#define ENGINE_IINPUTSOURCE_H
+
+#include <cstdint>
+
+class InputManager;
+
+// Supplies the input of each fixed tick in place of the live GLFW callbacks (e.g. a replay)
+class IInputSource {
+public:
+    virtual ~IInputSource() = default;
+
+    // Push the events of the tick starting at tickStart into input; may override the tick's length
+    // Returns false once the source is exhausted
+    virtual bool beginTick(InputManager& input, double tickStart, float& deltaTime) = 0;
+
+    // True to pace ticks by the wall clock, false to run them back to back as fast as possible
+    virtual bool isRealtime() const = 0;
+
+    // State checksum expected at the end of the tick begun last, if the source knows one
+    virtual bool getExpectedChecksum(uint64_t& checksum) const { return false; }
+};
+
+#endif //ENGINE_IINPUTSOURCE_H
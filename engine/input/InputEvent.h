@@ -0,0 +1,25 @@
+#ifndef ENGINE_INPUTEVENT_H
+#define ENGINE_INPUTEVENT_H
+
+#include <cstdint>
+
+enum class InputEventType : uint8_t {
+    KeyDown,
+    KeyUp,
+    ButtonDown,
+    ButtonUp,
+    CursorMove,   // x, y = absolute cursor position in window pixels
+    Scroll        // y = vertical offset
+};
+
+// One input change, stamped with the time it was received (seconds, InputManager::now clock)
+// Live play and recorded sessions both feed these into the InputManager
+struct InputEvent {
+    double time = 0.0;
+    InputEventType type = InputEventType::KeyDown;
+    uint8_t code = 0;     // Key or MouseButton index for key/button events
+    float x = 0.0f;
+    float y = 0.0f;
+};
+
+#endif //ENGINE_INPUTEVENT_H
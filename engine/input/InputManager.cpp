@@ -0,0 +1,214 @@
+#include "InputManager.h"
+#include <array>
+#include <chrono>
+
+namespace {
+    // GLFW only allows one callback and one user pointer per window; the manager owns both
+    InputManager* managerFor(GLFWwindow* window) {
+        return static_cast<InputManager*>(glfwGetWindowUserPointer(window));
+    }
+}
+
+InputManager::InputManager(GLFWwindow* window) : window(window) {
+    tickEvents.reserve(queueCapacity);
+    if (!window) return;
+
+    // Callbacks only stamp and queue; the state changes when the simulation reaches the event
+    // push() is also the replay entry point, so the callbacks check liveInput before calling it
+    glfwSetWindowUserPointer(window, this);
+    glfwSetKeyCallback(window, [](GLFWwindow* w, int key, int, int action, int) {
+        InputManager* input = managerFor(w);
+        const Key code = keyFromGLFW(key);
+        if (!input || !input->isLiveInput() || code == Key::Count || action == GLFW_REPEAT) return;
+        input->push({now(), action == GLFW_PRESS ? InputEventType::KeyDown : InputEventType::KeyUp,
+                     static_cast<uint8_t>(code)});
+    });
+    glfwSetMouseButtonCallback(window, [](GLFWwindow* w, int button, int action, int) {
+        InputManager* input = managerFor(w);
+        const MouseButton code = mouseButtonFromGLFW(button);
+        if (!input || !input->isLiveInput() || code == MouseButton::Count) return;
+        input->push({now(), action == GLFW_PRESS ? InputEventType::ButtonDown : InputEventType::ButtonUp,
+                     static_cast<uint8_t>(code)});
+    });
+    glfwSetCursorPosCallback(window, [](GLFWwindow* w, double x, double y) {
+        InputManager* input = managerFor(w);
+        if (input && input->isLiveInput()) {
+            input->push({now(), InputEventType::CursorMove, 0, static_cast<float>(x), static_cast<float>(y)});
+        }
+    });
+    glfwSetScrollCallback(window, [](GLFWwindow* w, double, double offset) {
+        InputManager* input = managerFor(w);
+        if (input && input->isLiveInput()) {
+            input->push({now(), InputEventType::Scroll, 0, 0.0f, static_cast<float>(offset)});
+        }
+    });
+}
+
+double InputManager::now() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+InputManager::~InputManager() {
+    if (window && managerFor(window) == this) {
+        glfwSetKeyCallback(window, nullptr);
+        glfwSetMouseButtonCallback(window, nullptr);
+        glfwSetCursorPosCallback(window, nullptr);
+        glfwSetScrollCallback(window, nullptr);
+        glfwSetWindowUserPointer(window, nullptr);
+    }
+}
+
+// Convert a GLFW key code to the Key enum
+Key InputManager::keyFromGLFW(int glfwKey) {
+    // Built once; every event is then a single array load
+    static const std::array<Key, GLFW_KEY_LAST + 1> table = [] {
+        std::array<Key, GLFW_KEY_LAST + 1> codes;
+        codes.fill(Key::Count);
+        codes[GLFW_KEY_A] = Key::A;
+        codes[GLFW_KEY_S] = Key::S;
+        codes[GLFW_KEY_D] = Key::D;
+        codes[GLFW_KEY_W] = Key::W;
+        codes[GLFW_KEY_Q] = Key::Q;
+        codes[GLFW_KEY_E] = Key::E;
+        codes[GLFW_KEY_SPACE] = Key::Space;
+        codes[GLFW_KEY_LEFT_SHIFT] = Key::Shift;
+        codes[GLFW_KEY_ESCAPE] = Key::Escape;
+        codes[GLFW_KEY_TAB] = Key::Tab;
+        codes[GLFW_KEY_F3] = Key::F3;
+        return codes;
+    }();
+
+    if (glfwKey < 0 || glfwKey > GLFW_KEY_LAST) return Key::Count;
+    return table[glfwKey];
+}
+
+// Convert a GLFW mouse button code to the MouseButton enum
+MouseButton InputManager::mouseButtonFromGLFW(int glfwButton) {
+    switch (glfwButton) {
+        case GLFW_MOUSE_BUTTON_LEFT: return MouseButton::Left;
+        case GLFW_MOUSE_BUTTON_RIGHT: return MouseButton::Right;
+        case GLFW_MOUSE_BUTTON_MIDDLE: return MouseButton::Middle;
+        default: return MouseButton::Count;
+    }
+}
+
+bool InputManager::push(const InputEvent& event) {
+    if (!queue.push(event)) {
+        droppedEvents.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+void InputManager::advanceTo(double time) {
+    keysPressed.reset();
+    keysReleased.reset();
+    buttonsPressed.reset();
+    buttonsReleased.reset();
+    mouseDeltaX = 0.0f;
+    mouseDeltaY = 0.0f;
+    scrollDelta = 0.0f;
+    tickEvents.clear();
+
+    // Later events stay queued for the tick their timestamp belongs to
+    while (const InputEvent* event = queue.peek()) {
+        if (event->time > time) break;
+        apply(*event);
+        tickEvents.push_back(*event);
+        queue.pop();
+    }
+}
+
+void InputManager::apply(const InputEvent& event) {
+    switch (event.type) {
+        case InputEventType::KeyDown:
+            if (event.code >= keyCount) return;
+            keys.set(event.code);
+            keysPressed.set(event.code);
+            break;
+        case InputEventType::KeyUp:
+            if (event.code >= keyCount) return;
+            keys.reset(event.code);
+            keysReleased.set(event.code);
+            break;
+        case InputEventType::ButtonDown:
+            if (event.code >= buttonCount) return;
+            buttons.set(event.code);
+            buttonsPressed.set(event.code);
+            break;
+        case InputEventType::ButtonUp:
+            if (event.code >= buttonCount) return;
+            buttons.reset(event.code);
+            buttonsReleased.set(event.code);
+            break;
+        case InputEventType::CursorMove:
+            if (hasCursor) {
+                mouseDeltaX += event.x - cursorX;
+                mouseDeltaY += event.y - cursorY;
+            }
+            cursorX = event.x;
+            cursorY = event.y;
+            hasCursor = true;
+            break;
+        case InputEventType::Scroll:
+            scrollDelta += event.y;
+            break;
+    }
+}
+
+void InputManager::setCursorCaptured(bool captured) {
+    if (captured == cursorCaptured) return;
+    cursorCaptured = captured;
+    if (window) {
+        glfwSetInputMode(window, GLFW_CURSOR, captured ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+    }
+    // Reset to prevent a jump when the cursor is warped
+    hasCursor = false;
+}
+
+ActionId InputManager::internAction(std::string_view action) {
+    auto it = actionIds.find(std::string(action));
+    if (it != actionIds.end()) {
+        return it->second;
+    }
+
+    const auto id = static_cast<ActionId>(actions.size());
+    actions.emplace_back();
+    actionIds.emplace(std::string(action), id);
+    return id;
+}
+
+ActionId InputManager::bindAction(std::string_view action, Key key) {
+    const ActionId id = internAction(action);
+    actions[id].keys.set(index(key));
+    return id;
+}
+
+ActionId InputManager::bindAction(std::string_view action, MouseButton button) {
+    const ActionId id = internAction(action);
+    actions[id].buttons.set(index(button));
+    return id;
+}
+
+ActionId InputManager::findAction(std::string_view action) const {
+    auto it = actionIds.find(std::string(action));
+    return it != actionIds.end() ? it->second : invalidAction;
+}
+
+bool InputManager::isActionPressed(ActionId action) const {
+    if (action >= actions.size()) return false;
+    const ActionBinding& binding = actions[action];
+    return (keys & binding.keys).any() || (buttons & binding.buttons).any();
+}
+
+bool InputManager::isActionJustPressed(ActionId action) const {
+    if (action >= actions.size()) return false;
+    const ActionBinding& binding = actions[action];
+    return (keysPressed & binding.keys).any() || (buttonsPressed & binding.buttons).any();
+}
+
+bool InputManager::isActionJustReleased(ActionId action) const {
+    if (action >= actions.size()) return false;
+    const ActionBinding& binding = actions[action];
+    return (keysReleased & binding.keys).any() || (buttonsReleased & binding.buttons).any();
+}
@@ -1,64 +1,148 @@
 #ifndef ENGINE_INPUTMANAGER_H
 #define ENGINE_INPUTMANAGER_H
 
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 #include <glfw3.h>
 
+#include "InputEvent.h"
+#include "jobs/SpscQueue.h"
 #include "service/IService.h"
 
 
-enum class Key {
-    A, S, D, W, Space, Shift, Escape
+enum class Key : uint8_t {
+    A, S, D, W, Q, E, Space, Shift, Escape, Tab, F3,
+    Count
 };
 
-enum class MouseButton {
-    Left, Right
+enum class MouseButton : uint8_t {
+    Left, Right, Middle,
+    Count
 };
 
+// Interned action name; resolve once at bind time, query with the id every frame
+using ActionId = uint16_t;
+constexpr ActionId invalidAction = UINT16_MAX;
+
+// Keyboard and mouse state rebuilt from a stream of timestamped events
+// GLFW callbacks (or a recorded session) push InputEvents into a lock-free SPSC queue; the
+// simulation consumes them tick by tick with advanceTo(), so every event lands in the fixed tick
+// its timestamp falls in, whatever the frame rate. State lives in bitsets and presses/releases are
+// kept per tick, so a tap shorter than a tick still shows up as just-pressed. Queries never hash or allocate
 class InputManager : public IService{
 public:
+    static constexpr size_t keyCount = static_cast<size_t>(Key::Count);
+    static constexpr size_t buttonCount = static_cast<size_t>(MouseButton::Count);
+
     // no implicit conversions
     explicit InputManager(GLFWwindow* window);
+    ~InputManager() override;
+
+    InputManager(const InputManager&) = delete;
+    InputManager& operator=(const InputManager&) = delete;
+
+    static constexpr size_t queueCapacity = 1024;
+
+    // IService interface; input advances with the simulation through advanceTo() instead
+    void update(int dt) override {}
+
+    // Producer side: queue an event (GLFW callbacks, replays). Dropped when the queue is full
+    bool push(const InputEvent& event);
+
+    // Consumer side: apply every queued event stamped at or before time, resetting per-tick edges first
+    void advanceTo(double time);
+
+    // Events applied by the last advanceTo, in order, for consumers that want sub-tick timing
+    const std::vector<InputEvent>& getTickEvents() const { return tickEvents; }
+
+    // Clock the live events are stamped with (seconds, monotonic; needs no GLFW)
+    static double now();
 
-    // IService interface
-    void update(int dt) override;
+    // Whether the GLFW callbacks feed the queue (off while a replay drives input)
+    void setLiveInput(bool value) { liveInput.store(value, std::memory_order_relaxed); }
+    bool isLiveInput() const { return liveInput.load(std::memory_order_relaxed); }
 
-    bool isKeyPressed(Key key);      // True while held down
-    bool isKeyJustPressed(Key key);  // True only on the frame it was pressed
-    bool isKeyJustReleased(Key key); // True only on the frame it was released
+    size_t getDroppedEvents() const { return droppedEvents.load(std::memory_order_relaxed); }
 
-    bool isMouseButtonPressed(MouseButton button);
-    bool isMouseButtonJustPressed(MouseButton button);
-    bool isMouseButtonJustReleased(MouseButton button);
+    bool isKeyPressed(Key key) const { return keys.test(index(key)); }                  // True while held down
+    bool isKeyJustPressed(Key key) const { return keysPressed.test(index(key)); }      // True only on the frame it was pressed
+    bool isKeyJustReleased(Key key) const { return keysReleased.test(index(key)); }    // True only on the frame it was released
 
-    void bindAction(std::string_view action, Key key);
-    void bindAction(std::string_view action, MouseButton button);
+    bool isMouseButtonPressed(MouseButton button) const { return buttons.test(index(button)); }
+    bool isMouseButtonJustPressed(MouseButton button) const { return buttonsPressed.test(index(button)); }
+    bool isMouseButtonJustReleased(MouseButton button) const { return buttonsReleased.test(index(button)); }
 
-    bool isActionPressed(std::string_view action);      // "jump", "fire"
-    bool isActionJustPressed(std::string_view action);
+    // Cursor movement and scroll accumulated over the last tick
+    float getMouseDeltaX() const { return mouseDeltaX; }
+    float getMouseDeltaY() const { return mouseDeltaY; }
+    float getScrollDelta() const { return scrollDelta; }
+
+    // Hide and lock the cursor for mouse look; the first delta after capturing is dropped
+    void setCursorCaptured(bool captured);
+    bool isCursorCaptured() const { return cursorCaptured; }
+
+    // An action may have several bindings; binding an existing name adds to it
+    ActionId bindAction(std::string_view action, Key key);
+    ActionId bindAction(std::string_view action, MouseButton button);
+
+    // Id of a bound action, invalidAction if unknown (hashes: call at setup, not per frame)
+    ActionId findAction(std::string_view action) const;
+
+    bool isActionPressed(ActionId action) const;      // "jump", "fire"
+    bool isActionJustPressed(ActionId action) const;
+    bool isActionJustReleased(ActionId action) const;
 
 protected:
 
 private:
+    struct ActionBinding {
+        std::bitset<keyCount> keys;
+        std::bitset<buttonCount> buttons;
+    };
+
     GLFWwindow* window;
 
-    // State tracking for edge detection
-    std::unordered_map<Key, bool> currentKeyStates;
-    std::unordered_map<Key, bool> previousKeyStates;
-    std::unordered_map<MouseButton, bool> currentMouseStates;
-    std::unordered_map<MouseButton, bool> previousMouseStates;
+    // State as of the last advanceTo; edges and deltas cover that tick only
+    std::bitset<keyCount> keys;
+    std::bitset<keyCount> keysPressed;
+    std::bitset<keyCount> keysReleased;
+    std::bitset<buttonCount> buttons;
+    std::bitset<buttonCount> buttonsPressed;
+    std::bitset<buttonCount> buttonsReleased;
+    float mouseDeltaX = 0.0f;
+    float mouseDeltaY = 0.0f;
+    float scrollDelta = 0.0f;
+    float cursorX = 0.0f;
+    float cursorY = 0.0f;
+    bool hasCursor = false;
+    bool cursorCaptured = false;
+
+    SpscQueue<InputEvent, queueCapacity> queue;
+    std::atomic<size_t> droppedEvents{0};
+    std::atomic<bool> liveInput{true};
+    std::vector<InputEvent> tickEvents;
 
     // Action bindings
-    std::unordered_map<std::string, Key> keyBindings;
-    std::unordered_map<std::string, MouseButton> mouseBindings;
+    std::unordered_map<std::string, ActionId> actionIds;
+    std::vector<ActionBinding> actions;
 
-    // Helper to convert Key enum to GLFW key code
-    static int keyToGLFW(Key key);
-    static int mouseButtonToGLFW(MouseButton button);
-};
+    ActionId internAction(std::string_view action);
+
+    void apply(const InputEvent& event);
 
-#include "./InputManager.tpp"
+    static size_t index(Key key) { return static_cast<size_t>(key); }
+    static size_t index(MouseButton button) { return static_cast<size_t>(button); }
+
+    // GLFW code -> enum index, Count when untracked
+    static Key keyFromGLFW(int glfwKey);
+    static MouseButton mouseButtonFromGLFW(int glfwButton);
+};
 
 
-#endif //ENGINE_INPUTMANAGER_H
\ No newline at end of file
+#endif //ENGINE_INPUTMANAGER_H
@@ -0,0 +1,111 @@
+#include "InputRecording.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    struct InputRecordingHeader {
+        char magic[4];          // "TKIR"
+        uint32_t version;
+        float fixedStep;
+        uint32_t tickCount;
+        uint32_t eventCount;
+    };
+
+    constexpr char inputRecordingMagic[4] = {'T', 'K', 'I', 'R'};
+    constexpr uint32_t inputRecordingVersion = 1;
+}
+
+void InputRecording::clear(float step) {
+    fixedStep = step;
+    ticks.clear();
+    firstEvents.clear();
+    events.clear();
+}
+
+void InputRecording::addTick(float deltaTime, double tickStart, const std::vector<InputEvent>& tickEvents, uint64_t checksum) {
+    firstEvents.push_back(static_cast<uint32_t>(events.size()));
+    ticks.push_back({deltaTime, static_cast<uint32_t>(tickEvents.size()), checksum});
+
+    for (const InputEvent& event : tickEvents) {
+        RecordedEvent recorded {};
+        // Events carried over from a dropped backlog are older than the tick; pin them to its start
+        const double offset = std::clamp(event.time - tickStart, 0.0, static_cast<double>(deltaTime));
+        recorded.offset = static_cast<float>(offset);
+        recorded.type = static_cast<uint8_t>(event.type);
+        recorded.code = event.code;
+        recorded.x = event.x;
+        recorded.y = event.y;
+        events.push_back(recorded);
+    }
+}
+
+InputEvent InputRecording::toEvent(const RecordedEvent& recorded, double tickStart) {
+    InputEvent event;
+    event.time = tickStart + recorded.offset;
+    event.type = static_cast<InputEventType>(recorded.type);
+    event.code = recorded.code;
+    event.x = recorded.x;
+    event.y = recorded.y;
+    return event;
+}
+
+bool InputRecording::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "ERROR::INPUT_RECORDING::Cannot write: " << path << std::endl;
+        return false;
+    }
+
+    InputRecordingHeader header {};
+    std::copy(inputRecordingMagic, inputRecordingMagic + 4, header.magic);
+    header.version = inputRecordingVersion;
+    header.fixedStep = fixedStep;
+    header.tickCount = static_cast<uint32_t>(ticks.size());
+    header.eventCount = static_cast<uint32_t>(events.size());
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(ticks.data()), static_cast<std::streamsize>(ticks.size() * sizeof(RecordedTick)));
+    file.write(reinterpret_cast<const char*>(events.data()), static_cast<std::streamsize>(events.size() * sizeof(RecordedEvent)));
+    return file.good();
+}
+
+std::unique_ptr<InputRecording> InputRecording::fromFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "ERROR::INPUT_RECORDING::FILE_NOT_FOUND: " << path << std::endl;
+        return nullptr;
+    }
+
+    InputRecordingHeader header {};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        !std::equal(inputRecordingMagic, inputRecordingMagic + 4, header.magic) ||
+        header.version != inputRecordingVersion) {
+        std::cerr << "ERROR::INPUT_RECORDING::Not a version " << inputRecordingVersion << " recording: " << path << std::endl;
+        return nullptr;
+    }
+
+    auto recording = std::make_unique<InputRecording>();
+    recording->fixedStep = header.fixedStep;
+    recording->ticks.resize(header.tickCount);
+    recording->events.resize(header.eventCount);
+    file.read(reinterpret_cast<char*>(recording->ticks.data()), static_cast<std::streamsize>(header.tickCount * sizeof(RecordedTick)));
+    file.read(reinterpret_cast<char*>(recording->events.data()), static_cast<std::streamsize>(header.eventCount * sizeof(RecordedEvent)));
+    if (!file) {
+        std::cerr << "ERROR::INPUT_RECORDING::Truncated recording: " << path << std::endl;
+        return nullptr;
+    }
+
+    // Tick event counts must add up to the event table
+    uint64_t first = 0;
+    recording->firstEvents.reserve(header.tickCount);
+    for (const RecordedTick& tick : recording->ticks) {
+        recording->firstEvents.push_back(static_cast<uint32_t>(first));
+        first += tick.eventCount;
+    }
+    if (first != header.eventCount) {
+        std::cerr << "ERROR::INPUT_RECORDING::Corrupt tick table: " << path << std::endl;
+        return nullptr;
+    }
+    return recording;
+}
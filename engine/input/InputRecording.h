@@ -0,0 +1,62 @@
+#ifndef ENGINE_INPUTRECORDING_H
+#define ENGINE_INPUTRECORDING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "InputEvent.h"
+
+// One simulation tick of a recording
+struct RecordedTick {
+    float deltaTime;
+    uint32_t eventCount;
+    uint64_t checksum;    // world state after the tick, 0 when not recorded
+};
+
+// One input event, timed relative to the start of its tick
+struct RecordedEvent {
+    float offset;
+    uint8_t type;         // InputEventType
+    uint8_t code;
+    uint16_t reserved;
+    float x;
+    float y;
+};
+
+// The input stream and tick sequence of a session, enough to replay it tick for tick
+//
+// File layout: InputRecordingHeader, then tickCount RecordedTicks, then eventCount RecordedEvents
+// (each tick's events follow the previous tick's), all little-endian as written by the engine
+class InputRecording {
+public:
+    InputRecording() = default;
+
+    // Returns nullptr if the file is missing, truncated or of another version
+    static std::unique_ptr<InputRecording> fromFile(const std::string& path);
+    bool save(const std::string& path) const;
+
+    void clear(float fixedStep);
+
+    // Append a tick with the events applied in it (absolute times, as the InputManager saw them)
+    void addTick(float deltaTime, double tickStart, const std::vector<InputEvent>& tickEvents, uint64_t checksum);
+
+    float getFixedStep() const { return fixedStep; }
+    size_t getTickCount() const { return ticks.size(); }
+    const RecordedTick& getTick(size_t index) const { return ticks[index]; }
+    const RecordedEvent* getTickEvents(size_t index) const { return events.data() + firstEvents[index]; }
+    size_t getEventCount() const { return events.size(); }
+
+    // Rebuild an engine event of a tick that starts at tickStart
+    static InputEvent toEvent(const RecordedEvent& recorded, double tickStart);
+
+private:
+    float fixedStep = 0.0f;
+    std::vector<RecordedTick> ticks;
+    std::vector<uint32_t> firstEvents;   // index of each tick's first event
+    std::vector<RecordedEvent> events;
+};
+
+#endif //ENGINE_INPUTRECORDING_H
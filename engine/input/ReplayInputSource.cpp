@@ -0,0 +1,24 @@
+#include "ReplayInputSource.h"
+#include "InputManager.h"
+
+ReplayInputSource::ReplayInputSource(const InputRecording& recording, bool uncapped)
+    : recording(recording), uncapped(uncapped) {}
+
+bool ReplayInputSource::beginTick(InputManager& input, double tickStart, float& deltaTime) {
+    if (isFinished()) return false;
+
+    const RecordedTick& tick = recording.getTick(next);
+    const RecordedEvent* events = recording.getTickEvents(next);
+    for (uint32_t i = 0; i < tick.eventCount; ++i) {
+        input.push(InputRecording::toEvent(events[i], tickStart));
+    }
+    deltaTime = tick.deltaTime;
+    next++;
+    return true;
+}
+
+bool ReplayInputSource::getExpectedChecksum(uint64_t& checksum) const {
+    if (next == 0) return false;
+    checksum = recording.getTick(next - 1).checksum;
+    return checksum != 0;
+}
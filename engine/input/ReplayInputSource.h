@@ -0,0 +1,27 @@
+#ifndef ENGINE_REPLAYINPUTSOURCE_H
+#define ENGINE_REPLAYINPUTSOURCE_H
+
+#include "IInputSource.h"
+#include "InputRecording.h"
+
+// Plays an InputRecording back tick for tick, with the recorded tick lengths
+// Uncapped replays run ticks back to back, for benchmarking the same session repeatedly
+class ReplayInputSource : public IInputSource {
+public:
+    // The recording must outlive the source
+    explicit ReplayInputSource(const InputRecording& recording, bool uncapped = false);
+
+    bool beginTick(InputManager& input, double tickStart, float& deltaTime) override;
+    bool isRealtime() const override { return !uncapped; }
+    bool getExpectedChecksum(uint64_t& checksum) const override;
+
+    size_t getTick() const { return next; }
+    bool isFinished() const { return next >= recording.getTickCount(); }
+
+private:
+    const InputRecording& recording;
+    bool uncapped;
+    size_t next = 0;   // tick to play next
+};
+
+#endif //ENGINE_REPLAYINPUTSOURCE_H
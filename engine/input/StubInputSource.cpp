@@ -0,0 +1,23 @@
+#include "StubInputSource.h"
+
+StubInputSource::StubInputSource(uint64_t tickLimit, bool uncapped) : tickLimit(tickLimit), uncapped(uncapped) {}
+
+void StubInputSource::press(Key key, uint64_t at) {
+    schedule.push_back({at, InputEventType::KeyDown, key});
+}
+
+void StubInputSource::release(Key key, uint64_t at) {
+    schedule.push_back({at, InputEventType::KeyUp, key});
+}
+
+bool StubInputSource::beginTick(InputManager& input, double tickStart, float& deltaTime) {
+    if (tickLimit != 0 && tick >= tickLimit) return false;
+
+    for (const Scheduled& entry : schedule) {
+        if (entry.tick == tick) {
+            input.push({tickStart, entry.type, static_cast<uint8_t>(entry.key)});
+        }
+    }
+    tick++;
+    return true;
+}
@@ -0,0 +1,40 @@
+#ifndef ENGINE_STUBINPUTSOURCE_H
+#define ENGINE_STUBINPUTSOURCE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "IInputSource.h"
+#include "InputEvent.h"
+#include "InputManager.h"
+
+// Input source for runs without a player (servers, AI training, CI throughput tests)
+// Feeds no input except keys scheduled with press/release, and can stop after a tick limit
+class StubInputSource : public IInputSource {
+public:
+    // tickLimit 0 = run until stopped; uncapped runs ticks back to back instead of at the fixed rate
+    explicit StubInputSource(uint64_t tickLimit = 0, bool uncapped = true);
+
+    // Hold or release a key from the given tick on
+    void press(Key key, uint64_t tick = 0);
+    void release(Key key, uint64_t tick);
+
+    bool beginTick(InputManager& input, double tickStart, float& deltaTime) override;
+    bool isRealtime() const override { return !uncapped; }
+
+    uint64_t getTick() const { return tick; }
+
+private:
+    struct Scheduled {
+        uint64_t tick;
+        InputEventType type;
+        Key key;
+    };
+
+    uint64_t tickLimit;
+    bool uncapped;
+    uint64_t tick = 0;
+    std::vector<Scheduled> schedule;
+};
+
+#endif //ENGINE_STUBINPUTSOURCE_H
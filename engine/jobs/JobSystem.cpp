@@ -0,0 +1,101 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+JobSystem::JobSystem(unsigned int workerCount) {
+    if (workerCount == 0) {
+        unsigned int hardware = std::thread::hardware_concurrency();
+        workerCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i) {
+        workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::submit(std::function<void()> job, JobCounter* counter) {
+    if (counter) {
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        std::lock_guard lock(mutex);
+        queue.push_back({std::move(job), counter});
+    }
+    available.notify_one();
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    while (!counter.isDone()) {
+        if (!runOne()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) return;
+
+    grainSize = std::max<size_t>(grainSize, 1);
+    const size_t maxChunks = workers.size() + 1;
+    const size_t chunkCount = std::min(maxChunks, (count + grainSize - 1) / grainSize);
+    if (chunkCount <= 1) {
+        body(0, count);
+        return;
+    }
+
+    const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+    JobCounter counter;
+    for (size_t begin = chunkSize; begin < count; begin += chunkSize) {
+        const size_t end = std::min(begin + chunkSize, count);
+        submit([&body, begin, end] { body(begin, end); }, &counter);
+    }
+
+    // The caller takes the first chunk itself
+    body(0, std::min(chunkSize, count));
+    wait(counter);
+}
+
+bool JobSystem::runOne() {
+    Job job;
+    {
+        std::lock_guard lock(mutex);
+        if (queue.empty()) return false;
+        job = std::move(queue.front());
+        queue.pop_front();
+    }
+    execute(job);
+    return true;
+}
+
+void JobSystem::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(mutex);
+            available.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping && queue.empty()) return;
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+        execute(job);
+    }
+}
+
+void JobSystem::execute(Job& job) {
+    job.function();
+    if (job.counter) {
+        job.counter->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
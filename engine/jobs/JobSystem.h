@@ -0,0 +1,61 @@
+#ifndef ENGINE_JOBSYSTEM_H
+#define ENGINE_JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Tracks a group of submitted jobs; the group is done when the count drops to zero
+class JobCounter {
+public:
+    bool isDone() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> pending{0};
+};
+
+// Fixed pool of worker threads pulling jobs from one shared queue
+// Waiting threads help run queued jobs, so jobs may submit and wait on other jobs
+class JobSystem {
+public:
+    // 0 workers = one per hardware thread, minus the calling thread
+    explicit JobSystem(unsigned int workerCount = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    void submit(std::function<void()> job, JobCounter* counter = nullptr);
+
+    // Block until every job of the counter has finished, running queued jobs meanwhile
+    void wait(JobCounter& counter);
+
+    // Run body(begin, end) over [0, count) in chunks of at least grainSize, on the workers and the caller
+    void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& body);
+
+    unsigned int getWorkerCount() const { return static_cast<unsigned int>(workers.size()); }
+
+private:
+    struct Job {
+        std::function<void()> function;
+        JobCounter* counter;
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<Job> queue;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping = false;
+
+    bool runOne();
+    void workerLoop();
+    static void execute(Job& job);
+};
+
+#endif //ENGINE_JOBSYSTEM_H
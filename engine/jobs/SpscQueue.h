@@ -0,0 +1,37 @@
+#ifndef ENGINE_SPSCQUEUE_H
+#define ENGINE_SPSCQUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer thread
+// Capacity must be a power of two; push fails instead of blocking when the queue is full
+template<typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+    // Producer side
+    bool push(const T& value);
+
+    // Consumer side: oldest element without removing it, nullptr when empty
+    const T* peek() const;
+    void pop();
+    bool pop(T& out);
+
+    // Approximate when called while the other side is active
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    // Separate cache lines so producer and consumer do not false-share their indices
+    alignas(64) std::atomic<size_t> head{0};   // next slot to read, written by the consumer
+    alignas(64) std::atomic<size_t> tail{0};   // next slot to write, written by the producer
+    alignas(64) std::array<T, Capacity> slots{};
+};
+
+#include "SpscQueue.tpp"
+
+#endif //ENGINE_SPSCQUEUE_H
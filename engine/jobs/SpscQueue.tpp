@@ -0,0 +1,47 @@
+#ifndef ENGINE_SPSCQUEUE_TPP
+#define ENGINE_SPSCQUEUE_TPP
+
+#include "SpscQueue.h"
+
+template<typename T, size_t Capacity>
+bool SpscQueue<T, Capacity>::push(const T& value) {
+    const size_t write = tail.load(std::memory_order_relaxed);
+    if (write - head.load(std::memory_order_acquire) == Capacity) {
+        return false;
+    }
+    slots[write & (Capacity - 1)] = value;
+    // Publish the slot before the consumer can see the new tail
+    tail.store(write + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T, size_t Capacity>
+const T* SpscQueue<T, Capacity>::peek() const {
+    const size_t read = head.load(std::memory_order_relaxed);
+    if (read == tail.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    return &slots[read & (Capacity - 1)];
+}
+
+template<typename T, size_t Capacity>
+void SpscQueue<T, Capacity>::pop() {
+    // Hand the slot back to the producer only after it has been read
+    head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+template<typename T, size_t Capacity>
+bool SpscQueue<T, Capacity>::pop(T& out) {
+    const T* front = peek();
+    if (!front) return false;
+    out = *front;
+    pop();
+    return true;
+}
+
+template<typename T, size_t Capacity>
+size_t SpscQueue<T, Capacity>::size() const {
+    return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+}
+
+#endif //ENGINE_SPSCQUEUE_TPP
@@ -0,0 +1,130 @@
+#include "ParticleEmitterComponent.h"
+#include "renderer/components/Texture2DComponent.h"
+#include "transform/TransformComponent.h"
+#include <cmath>
+
+ParticleEmitterComponent::ParticleEmitterComponent(size_t capacity, const ParticleEmitterSettings& settings)
+    : pool(capacity), settings(settings) {}
+
+void ParticleEmitterComponent::setMesh(const std::string& name) {
+    meshName = name;
+    mesh = MeshHandle{};
+}
+
+float ParticleEmitterComponent::random(float min, float max) {
+    // xorshift32; quality is plenty for visual noise
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return min + (max - min) * static_cast<float>(rngState >> 8) * (1.0f / 16777216.0f);
+}
+
+void ParticleEmitterComponent::emit(int count) {
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+    if (auto* transform = getComponent<TransformComponent>("transform")) {
+        x = transform->position.x;
+        y = transform->position.y;
+        z = transform->position.z;
+    }
+
+    constexpr float degrees = 3.14159265358979323846f / 180.0f;
+    for (int i = 0; i < count; ++i) {
+        const float angle = (settings.direction + random(-0.5f, 0.5f) * settings.spread) * degrees;
+        const float speed = random(settings.speedMin, settings.speedMax);
+
+        ParticleSpawn particle;
+        particle.x = x;
+        particle.y = y;
+        particle.z = z;
+        particle.velocityX = std::cos(angle) * speed;
+        particle.velocityY = std::sin(angle) * speed;
+        particle.lifetime = random(settings.lifetimeMin, settings.lifetimeMax);
+        particle.size = random(settings.sizeMin, settings.sizeMax);
+        if (!pool.spawn(particle)) return;
+    }
+}
+
+void ParticleEmitterComponent::burst(int count) {
+    emit(count);
+}
+
+void ParticleEmitterComponent::update(float dt) {
+    if (emitting && settings.rate > 0.0f) {
+        emitAccumulator += settings.rate * dt;
+        const int count = static_cast<int>(emitAccumulator);
+        emitAccumulator -= static_cast<float>(count);
+        emit(count);
+    }
+
+    pool.simulate(dt, settings.forces, jobs);
+}
+
+ShaderFeature ParticleEmitterComponent::getShaderFeatures() {
+    ShaderFeature features = ShaderFeature::Instanced;
+
+    Texture2DComponent* texComponent = getComponent<Texture2DComponent>("texture");
+    if (texComponent && texComponent->isValid()) {
+        features |= ShaderFeature::Textured;
+        if (texComponent->isAtlasRegion()) {
+            features |= ShaderFeature::Atlas;
+        }
+    }
+    return features;
+}
+
+void ParticleEmitterComponent::prepareFrame() {
+    // Written once here and uploaded by the first view that draws the emitter
+    instances.resize(pool.size());
+    if (!instances.empty()) {
+        pool.writeInstances(instances.data(), settings.appearance, jobs);
+    }
+    uploadPending = true;
+}
+
+void ParticleEmitterComponent::render(const RenderContext& context, const float* modelMatrix) {
+    if (instances.empty()) return;
+
+    if (!mesh.isValid()) {
+        mesh = context.geometry->find(meshName);
+        if (!mesh.isValid()) return;
+    }
+
+    if (uploadPending) {
+        batch.upload(*context.geometry, instances.data(), instances.size());
+        uploadPending = false;
+    }
+
+    // Particles are simulated in world space, so the entity transform only sets the spawn point
+    static constexpr float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    Shader* shader = context.shader;
+    shader->use();
+    shader->setMat4("model", identity);
+
+    Texture2DComponent* texComponent = getComponent<Texture2DComponent>("texture");
+    bool hasTexture = texComponent && texComponent->isValid();
+    if (hasTexture) {
+        if (texComponent->isAtlasRegion()) {
+            const UVRect& uv = texComponent->getUVRect();
+            shader->setVec4("uvRect", uv.u, uv.v, uv.width, uv.height);
+        }
+        shader->setInt("textureSampler", 0);
+        texComponent->getTexture()->bind(0);
+    }
+
+    // Translucent and unsorted: test against depth but do not write it
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, settings.additive ? GL_ONE : GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+
+    batch.draw(*context.geometry, mesh);
+    if (context.stats) context.stats->drawCalls++;
+
+    glDepthMask(GL_TRUE);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    if (hasTexture) {
+        texComponent->getTexture()->unbind();
+    }
+
+    // Restore the shared geometry VAO for the entities drawn after us
+    context.geometry->bind();
+}
@@ -0,0 +1,81 @@
+#ifndef ENGINE_PARTICLEEMITTERCOMPONENT_H
+#define ENGINE_PARTICLEEMITTERCOMPONENT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ParticlePool.h"
+#include "renderer/InstancedQuadBatch.h"
+#include "renderer/components/RendererComponent.h"
+
+class JobSystem;
+
+struct ParticleEmitterSettings {
+    float rate = 0.0f;              // particles per second while emitting
+    float lifetimeMin = 0.5f, lifetimeMax = 1.0f;
+    float speedMin = 1.0f, speedMax = 2.0f;
+    float direction = 90.0f;        // degrees, 0 = +X, 90 = +Y
+    float spread = 360.0f;          // full cone angle in degrees
+    float sizeMin = 0.1f, sizeMax = 0.2f;
+    ParticleForces forces;
+    ParticleAppearance appearance;
+    bool additive = false;          // additive blending (flashes, sparks) instead of alpha blending
+};
+
+// Spawns, simulates and draws particles (muzzle flashes, smoke, sparks, debris)
+// Particles live in a ParticlePool in world space, emitted at the entity's position, and the whole
+// emitter is drawn with one instanced draw. A Texture2DComponent on the entity textures the particles
+class ParticleEmitterComponent : public RendererComponent {
+public:
+    explicit ParticleEmitterComponent(size_t capacity = 10000, const ParticleEmitterSettings& settings = {});
+
+    ParticleEmitterSettings& getSettings() { return settings; }
+
+    // Continuous emission at settings.rate
+    void setEmitting(bool value) { emitting = value; }
+    bool isEmitting() const { return emitting; }
+
+    // Spawn count particles at once (e.g. an explosion)
+    void burst(int count);
+
+    // Seed the spawn randomness (e.g. from the world's random stream), for reproducible runs
+    void setSeed(uint32_t seed) { rngState = seed != 0 ? seed : 0x9e3779b9u; }
+
+    // Split simulation across workers for large emitters
+    void setJobSystem(JobSystem* value) { jobs = value; }
+
+    // Mesh each particle is drawn with (defaults to the unit quad)
+    void setMesh(const std::string& name);
+
+    const ParticlePool& getPool() const { return pool; }
+
+    // Component interface
+    void update(float dt) override;
+
+    // RendererComponent interface
+    void initialize() override { initialized = true; }
+    ShaderFeature getShaderFeatures() override;
+    void prepareFrame() override;
+    void render(const RenderContext& context, const float* modelMatrix) override;
+    void cleanup() override {}
+
+private:
+    ParticlePool pool;
+    ParticleEmitterSettings settings;
+    JobSystem* jobs = nullptr;
+    bool emitting = true;
+    float emitAccumulator = 0.0f;
+    uint32_t rngState = 0x9e3779b9u;
+
+    std::string meshName = GeometryRegistry::quad;
+    MeshHandle mesh;
+    std::vector<QuadInstance> instances;
+    InstancedQuadBatch batch;
+    bool uploadPending = false;     // instances written this frame, not yet on the GPU
+
+    float random(float min, float max);
+    void emit(int count);
+};
+
+#endif //ENGINE_PARTICLEEMITTERCOMPONENT_H
@@ -0,0 +1,147 @@
+#include "ParticlePool.h"
+#include "jobs/JobSystem.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLES_SSE 1
+#endif
+
+namespace {
+    // Below this many particles per chunk, threading costs more than it saves
+    constexpr size_t simulateGrain = 16384;
+    constexpr size_t instanceGrain = 16384;
+
+    uint8_t toByte(float value) {
+        return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+}
+
+ParticlePool::ParticlePool(size_t capacity) : capacity(capacity) {
+    const size_t padded = (capacity + 3) & ~static_cast<size_t>(3);
+    for (auto* array : {&positionX, &positionY, &positionZ, &velocityX, &velocityY, &age, &lifetime, &size0}) {
+        array->assign(padded, 0.0f);
+    }
+}
+
+bool ParticlePool::spawn(const ParticleSpawn& particle) {
+    if (count >= capacity) return false;
+
+    positionX[count] = particle.x;
+    positionY[count] = particle.y;
+    positionZ[count] = particle.z;
+    velocityX[count] = particle.velocityX;
+    velocityY[count] = particle.velocityY;
+    age[count] = 0.0f;
+    lifetime[count] = particle.lifetime;
+    size0[count] = particle.size;
+    count++;
+    return true;
+}
+
+void ParticlePool::simulate(float dt, const ParticleForces& forces, JobSystem* jobs) {
+    if (jobs && count > simulateGrain) {
+        // Chunks start on multiples of 4 so each SIMD block belongs to one thread
+        const size_t blocks = (count + 3) / 4;
+        jobs->parallelFor(blocks, simulateGrain / 4, [this, dt, &forces](size_t begin, size_t end) {
+            integrate(begin * 4, std::min(end * 4, count), dt, forces);
+        });
+    } else {
+        integrate(0, count, dt, forces);
+    }
+    removeDead();
+}
+
+void ParticlePool::integrate(size_t begin, size_t end, float dt, const ParticleForces& forces) {
+    const float damping = std::max(0.0f, 1.0f - forces.drag * dt);
+    const float gravityX = forces.gravityX * dt;
+    const float gravityY = forces.gravityY * dt;
+
+    size_t i = begin;
+#ifdef PARTICLES_SSE
+    const __m128 dampingV = _mm_set1_ps(damping);
+    const __m128 gravityXV = _mm_set1_ps(gravityX);
+    const __m128 gravityYV = _mm_set1_ps(gravityY);
+    const __m128 dtV = _mm_set1_ps(dt);
+
+    for (; i + 4 <= end; i += 4) {
+        __m128 vx = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&velocityX[i]), dampingV), gravityXV);
+        __m128 vy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&velocityY[i]), dampingV), gravityYV);
+        _mm_storeu_ps(&velocityX[i], vx);
+        _mm_storeu_ps(&velocityY[i], vy);
+        _mm_storeu_ps(&positionX[i], _mm_add_ps(_mm_loadu_ps(&positionX[i]), _mm_mul_ps(vx, dtV)));
+        _mm_storeu_ps(&positionY[i], _mm_add_ps(_mm_loadu_ps(&positionY[i]), _mm_mul_ps(vy, dtV)));
+        _mm_storeu_ps(&age[i], _mm_add_ps(_mm_loadu_ps(&age[i]), dtV));
+    }
+#endif
+
+    for (; i < end; ++i) {
+        velocityX[i] = velocityX[i] * damping + gravityX;
+        velocityY[i] = velocityY[i] * damping + gravityY;
+        positionX[i] += velocityX[i] * dt;
+        positionY[i] += velocityY[i] * dt;
+        age[i] += dt;
+    }
+}
+
+void ParticlePool::moveParticle(size_t from, size_t to) {
+    positionX[to] = positionX[from];
+    positionY[to] = positionY[from];
+    positionZ[to] = positionZ[from];
+    velocityX[to] = velocityX[from];
+    velocityY[to] = velocityY[from];
+    age[to] = age[from];
+    lifetime[to] = lifetime[from];
+    size0[to] = size0[from];
+}
+
+void ParticlePool::removeDead() {
+    size_t i = 0;
+    while (i < count) {
+#ifdef PARTICLES_SSE
+        // Skip whole blocks of four live particles with one compare
+        if (i + 4 <= count) {
+            const __m128 dead = _mm_cmpge_ps(_mm_loadu_ps(&age[i]), _mm_loadu_ps(&lifetime[i]));
+            if (_mm_movemask_ps(dead) == 0) {
+                i += 4;
+                continue;
+            }
+        }
+#endif
+        if (age[i] >= lifetime[i]) {
+            // The swapped-in particle is checked on the next iteration
+            count--;
+            moveParticle(count, i);
+        } else {
+            i++;
+        }
+    }
+}
+
+void ParticlePool::writeInstances(QuadInstance* out, const ParticleAppearance& appearance, JobSystem* jobs) const {
+    if (jobs && count > instanceGrain) {
+        jobs->parallelFor(count, instanceGrain, [this, out, &appearance](size_t begin, size_t end) {
+            writeInstances(out, begin, end, appearance);
+        });
+    } else {
+        writeInstances(out, 0, count, appearance);
+    }
+}
+
+void ParticlePool::writeInstances(QuadInstance* out, size_t begin, size_t end, const ParticleAppearance& appearance) const {
+    const float* start = appearance.startColour;
+    const float* finish = appearance.endColour;
+    const float scaleDelta = appearance.endScale - 1.0f;
+
+    for (size_t i = begin; i < end; ++i) {
+        const float t = std::min(age[i] / lifetime[i], 1.0f);
+        QuadInstance& instance = out[i];
+        instance.x = positionX[i];
+        instance.y = positionY[i];
+        instance.z = positionZ[i];
+        instance.size = size0[i] * (1.0f + scaleDelta * t);
+        for (int c = 0; c < 4; ++c) {
+            instance.colour[c] = toByte(start[c] + (finish[c] - start[c]) * t);
+        }
+    }
+}
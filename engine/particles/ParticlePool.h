@@ -0,0 +1,79 @@
+#ifndef ENGINE_PARTICLEPOOL_H
+#define ENGINE_PARTICLEPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "renderer/QuadInstance.h"
+
+class JobSystem;
+
+struct ParticleSpawn {
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+    float velocityX = 0.0f, velocityY = 0.0f;
+    float lifetime = 1.0f;
+    float size = 1.0f;
+};
+
+// Forces applied to every particle of a pool each step
+struct ParticleForces {
+    float gravityX = 0.0f;
+    float gravityY = 0.0f;
+    float drag = 0.0f;  // fraction of velocity lost per second
+};
+
+// Look over a particle's life, interpolated from birth (start) to death (end)
+struct ParticleAppearance {
+    float startColour[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    float endColour[4] = {1.0f, 1.0f, 1.0f, 0.0f};
+    float endScale = 1.0f;  // size multiplier at the end of life
+};
+
+// Fixed-capacity particle storage in structure-of-arrays layout
+// Each attribute is a separate float array, so the update kernels process four particles per SSE
+// instruction. Dead particles are removed by swapping the last live particle into their slot.
+// Touches no GL state; rendering goes through ParticleEmitterComponent
+class ParticlePool {
+public:
+    explicit ParticlePool(size_t capacity);
+
+    // Add a particle; false if the pool is full
+    bool spawn(const ParticleSpawn& particle);
+
+    // Integrate, age and cull, split across the job system's workers when given one
+    void simulate(float dt, const ParticleForces& forces, JobSystem* jobs = nullptr);
+
+    // Integration kernel over [begin, end): velocity drag + gravity, position, age
+    void integrate(size_t begin, size_t end, float dt, const ParticleForces& forces);
+
+    // Swap-remove every particle whose age reached its lifetime
+    void removeDead();
+
+    // Fill out[0, size()) with render data, colour and size interpolated over life
+    void writeInstances(QuadInstance* out, const ParticleAppearance& appearance, JobSystem* jobs = nullptr) const;
+    void writeInstances(QuadInstance* out, size_t begin, size_t end, const ParticleAppearance& appearance) const;
+
+    void clear() { count = 0; }
+    size_t size() const { return count; }
+    size_t getCapacity() const { return capacity; }
+
+    // Raw attribute arrays, valid for [0, size())
+    const float* getPositionX() const { return positionX.data(); }
+    const float* getPositionY() const { return positionY.data(); }
+    const float* getAge() const { return age.data(); }
+    const float* getLifetime() const { return lifetime.data(); }
+
+private:
+    size_t capacity;
+    size_t count = 0;
+
+    // Rounded up to a multiple of 4 so the SIMD kernels never need a bounds check on loads
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> velocityX, velocityY;
+    std::vector<float> age, lifetime, size0;
+
+    void moveParticle(size_t from, size_t to);
+};
+
+#endif //ENGINE_PARTICLEPOOL_H
@@ -0,0 +1,773 @@
+#include "PathfindingService.h"
+#include "renderer/components/TilemapComponent.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace {
+    constexpr float diagonalCost = 1.41421356f;
+    constexpr float unreachable = std::numeric_limits<float>::infinity();
+    constexpr uint32_t invalidCell = ~0u;
+    constexpr uint8_t noDirection = 0xFF;
+
+    // Orthogonal neighbours first, then diagonals
+    constexpr int neighbourX[8] = {1, -1, 0, 0, 1, 1, -1, -1};
+    constexpr int neighbourY[8] = {0, 0, 1, -1, 1, -1, 1, -1};
+
+    // Openings at least this wide get a transition at each end rather than one in the middle
+    constexpr int wideEntrance = 6;
+    // Clusters per job when an edit touches many of them
+    constexpr size_t rebuildGrain = 8;
+    // Past this many entries the path cache starts over rather than growing without bound
+    constexpr size_t maxCachedPaths = 1 << 14;
+
+    struct Rect {
+        int x0, y0, x1, y1;
+    };
+
+    struct SearchScratch {
+        std::vector<float> cost;
+        std::vector<int32_t> parent;
+        std::vector<uint8_t> closed;
+        std::vector<std::pair<float, uint32_t>> open;   // min-heap of (priority, local index)
+    };
+
+    float octile(int dx, int dy) {
+        dx = std::abs(dx);
+        dy = std::abs(dy);
+        return static_cast<float>(std::max(dx, dy)) + (diagonalCost - 1.0f) * static_cast<float>(std::min(dx, dy));
+    }
+
+    uint64_t pathKey(uint32_t startCell, uint32_t goalCell) {
+        return (static_cast<uint64_t>(startCell) << 32) | goalCell;
+    }
+
+    // A move stays inside the rect on walkable tiles, and diagonals never cut a blocked corner
+    bool canStep(const uint8_t* walkable, int width, const Rect& rect, int x, int y, int direction, int& outX, int& outY) {
+        outX = x + neighbourX[direction];
+        outY = y + neighbourY[direction];
+        if (outX < rect.x0 || outY < rect.y0 || outX >= rect.x1 || outY >= rect.y1) return false;
+        if (!walkable[static_cast<size_t>(outY) * width + outX]) return false;
+        if (direction >= 4) {
+            return walkable[static_cast<size_t>(y) * width + outX] && walkable[static_cast<size_t>(outY) * width + x];
+        }
+        return true;
+    }
+
+    // Dijkstra from the start over the rect, or A* when toGoal is set; indices are local to the rect
+    bool searchRect(const uint8_t* walkable, int width, const Rect& rect, int startX, int startY,
+                    int goalX, int goalY, bool toGoal, SearchScratch& scratch) {
+        const int rectWidth = rect.x1 - rect.x0;
+        const size_t count = static_cast<size_t>(rectWidth) * (rect.y1 - rect.y0);
+        scratch.cost.assign(count, unreachable);
+        scratch.parent.assign(count, -1);
+        scratch.closed.assign(count, 0);
+        scratch.open.clear();
+
+        const auto local = [&](int x, int y) {
+            return static_cast<uint32_t>((y - rect.y0) * rectWidth + (x - rect.x0));
+        };
+        const std::greater<> later;
+
+        const uint32_t first = local(startX, startY);
+        scratch.cost[first] = 0.0f;
+        scratch.open.push_back({toGoal ? octile(goalX - startX, goalY - startY) : 0.0f, first});
+
+        while (!scratch.open.empty()) {
+            std::pop_heap(scratch.open.begin(), scratch.open.end(), later);
+            const uint32_t index = scratch.open.back().second;
+            scratch.open.pop_back();
+            if (scratch.closed[index]) continue;
+            scratch.closed[index] = 1;
+
+            const int x = rect.x0 + static_cast<int>(index % rectWidth);
+            const int y = rect.y0 + static_cast<int>(index / rectWidth);
+            if (toGoal && x == goalX && y == goalY) return true;
+
+            for (int direction = 0; direction < 8; ++direction) {
+                int nextX, nextY;
+                if (!canStep(walkable, width, rect, x, y, direction, nextX, nextY)) continue;
+                const uint32_t next = local(nextX, nextY);
+                if (scratch.closed[next]) continue;
+
+                const float cost = scratch.cost[index] + (direction < 4 ? 1.0f : diagonalCost);
+                if (cost < scratch.cost[next]) {
+                    scratch.cost[next] = cost;
+                    scratch.parent[next] = static_cast<int32_t>(index);
+                    const float priority = toGoal ? cost + octile(goalX - nextX, goalY - nextY) : cost;
+                    scratch.open.push_back({priority, next});
+                    std::push_heap(scratch.open.begin(), scratch.open.end(), later);
+                }
+            }
+        }
+        return !toGoal;
+    }
+}
+
+PathfindingService::PathfindingService(JobSystem* jobs) : jobs(jobs) {}
+
+PathfindingService::~PathfindingService() {
+    // Searches in flight point into this object
+    if (jobs) jobs->wait(inFlight);
+}
+
+void PathfindingService::setTilemap(const TilemapComponent* tilemap, float originX, float originY) {
+    this->tilemap = tilemap;
+    tilemapOriginX = originX;
+    tilemapOriginY = originY;
+    rebuildAll = true;
+}
+
+void PathfindingService::setBlocked(uint16_t type, bool blocked) {
+    if (blockedTypes.size() <= type) {
+        blockedTypes.resize(static_cast<size_t>(type) + 1, 0);
+    }
+    if (blockedTypes[type] == (blocked ? 1 : 0)) return;
+    blockedTypes[type] = blocked ? 1 : 0;
+    gridDirty = true;
+}
+
+void PathfindingService::setSettings(const PathfindingSettings& value) {
+    settings = value;
+    settings.clusterSize = std::max(settings.clusterSize, 4);
+    if (settings.clusterSize != clusterSize) {
+        rebuildAll = true;
+    }
+}
+
+bool PathfindingService::cellAt(float x, float y, uint32_t& outCell) const {
+    if (width == 0 || height == 0) return false;
+    const int cellX = static_cast<int>(std::floor((x - originX) / tileSize));
+    const int cellY = static_cast<int>(std::floor((y - originY) / tileSize));
+    if (cellX < 0 || cellY < 0 || cellX >= width || cellY >= height) return false;
+    outCell = static_cast<uint32_t>(cellY) * width + cellX;
+    return true;
+}
+
+uint32_t PathfindingService::clusterOf(uint32_t cell) const {
+    const int x = static_cast<int>(cell % width);
+    const int y = static_cast<int>(cell / width);
+    return static_cast<uint32_t>((y / clusterSize) * clustersX + x / clusterSize);
+}
+
+void PathfindingService::clusterRect(uint32_t cluster, int& x0, int& y0, int& x1, int& y1) const {
+    x0 = static_cast<int>(cluster % clustersX) * clusterSize;
+    y0 = static_cast<int>(cluster / clustersX) * clusterSize;
+    x1 = std::min(x0 + clusterSize, width);
+    y1 = std::min(y0 + clusterSize, height);
+}
+
+PathRequestId PathfindingService::requestPath(float startX, float startY, float goalX, float goalY) {
+    const PathRequestId id = nextRequestId++;
+    PathRequest& request = requests[id];
+    request = {startX, startY, goalX, goalY};
+
+    // The same trip searched since the last edit is answered straight away
+    uint32_t startCell, goalCell;
+    if (cellAt(startX, startY, startCell) && cellAt(goalX, goalY, goalCell)) {
+        auto it = pathCache.find(pathKey(startCell, goalCell));
+        if (it != pathCache.end()) {
+            request.result = it->second;
+            request.status = it->second->found ? PathStatus::Ready : PathStatus::NoPath;
+            stats.cacheHits++;
+            return id;
+        }
+    }
+
+    pathQueue.push_back(id);
+    return id;
+}
+
+PathStatus PathfindingService::getPathStatus(PathRequestId id) const {
+    auto it = requests.find(id);
+    return it != requests.end() ? it->second.status : PathStatus::Unknown;
+}
+
+const std::vector<PathPoint>& PathfindingService::getPath(PathRequestId id) const {
+    static const std::vector<PathPoint> none;
+    auto it = requests.find(id);
+    if (it == requests.end() || !it->second.result) return none;
+    return it->second.result->points;
+}
+
+void PathfindingService::releasePath(PathRequestId id) {
+    // Queued or running searches notice the request is gone when they come up
+    requests.erase(id);
+}
+
+FlowFieldId PathfindingService::acquireFlowField(float goalX, float goalY) {
+    uint32_t goalCell = invalidCell;
+    if (cellAt(goalX, goalY, goalCell)) {
+        auto it = fieldOfGoal.find(goalCell);
+        if (it != fieldOfGoal.end()) {
+            fields[it->second].refs++;
+            return it->second;
+        }
+    }
+
+    const FlowFieldId id = nextFieldId++;
+    FlowFieldEntry& entry = fields[id];
+    entry.goalX = goalX;
+    entry.goalY = goalY;
+    entry.goalCell = goalCell;
+    entry.queued = true;
+    if (goalCell != invalidCell) {
+        fieldOfGoal[goalCell] = id;
+    }
+    fieldQueue.push_back(id);
+    return id;
+}
+
+bool PathfindingService::isFlowFieldReady(FlowFieldId id) const {
+    auto it = fields.find(id);
+    return it != fields.end() && it->second.field != nullptr;
+}
+
+bool PathfindingService::sampleFlow(FlowFieldId id, float x, float y, float& outX, float& outY) const {
+    auto it = fields.find(id);
+    if (it == fields.end() || !it->second.field) return false;
+
+    const FlowField& field = *it->second.field;
+    uint32_t cell;
+    if (!cellAt(x, y, cell) || cell >= field.direction.size()) return false;
+
+    const uint8_t direction = field.direction[cell];
+    if (direction == noDirection) return false;
+
+    const float scale = direction < 4 ? 1.0f : 1.0f / diagonalCost;
+    outX = static_cast<float>(neighbourX[direction]) * scale;
+    outY = static_cast<float>(neighbourY[direction]) * scale;
+    return true;
+}
+
+void PathfindingService::releaseFlowField(FlowFieldId id) {
+    auto it = fields.find(id);
+    if (it == fields.end() || --it->second.refs > 0) return;
+
+    auto goal = fieldOfGoal.find(it->second.goalCell);
+    if (goal != fieldOfGoal.end() && goal->second == id) {
+        fieldOfGoal.erase(goal);
+    }
+    fields.erase(it);
+}
+
+bool PathfindingService::isWalkable(float x, float y) const {
+    uint32_t cell;
+    return cellAt(x, y, cell) && walkable[cell];
+}
+
+void PathfindingService::step() {
+    publish();
+    syncGrid();
+    launch();
+
+    stats.queuedPaths = pathQueue.size();
+    stats.queuedFields = fieldQueue.size();
+}
+
+void PathfindingService::publish() {
+    if (jobs) jobs->wait(inFlight);
+
+    for (PathTask& task : pathTasks) {
+        if (pathCache.size() >= maxCachedPaths) pathCache.clear();
+        pathCache[pathKey(task.startCell, task.goalCell)] = task.result;
+        stats.pathsSearched++;
+
+        for (const PathRequestId id : task.waiters) {
+            auto it = requests.find(id);
+            if (it == requests.end() || it->second.status != PathStatus::Pending) continue;
+            it->second.result = task.result;
+            it->second.status = task.result->found ? PathStatus::Ready : PathStatus::NoPath;
+        }
+    }
+    pathTasks.clear();
+
+    for (FieldTask& task : fieldTasks) {
+        auto it = fields.find(task.id);
+        if (it == fields.end()) continue;
+        it->second.field = std::move(task.field);
+        stats.fieldsBuilt++;
+    }
+    fieldTasks.clear();
+}
+
+void PathfindingService::syncGrid() {
+    const int mapWidth = tilemap ? tilemap->getWidth() : 0;
+    const int mapHeight = tilemap ? tilemap->getHeight() : 0;
+    const float mapTileSize = tilemap ? tilemap->getTileSize() : 1.0f;
+    const bool layout = rebuildAll || mapWidth != width || mapHeight != height || mapTileSize != tileSize ||
+                        tilemapOriginX != originX || tilemapOriginY != originY;
+    if (!layout && !gridDirty && (!tilemap || tilemap->getVersion() == gridVersion)) return;
+
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    if (layout) {
+        width = mapWidth;
+        height = mapHeight;
+        tileSize = mapTileSize;
+        originX = tilemapOriginX;
+        originY = tilemapOriginY;
+        clusterSize = settings.clusterSize;
+        clustersX = (width + clusterSize - 1) / clusterSize;
+        clustersY = (height + clusterSize - 1) / clusterSize;
+
+        const size_t clusterCount = static_cast<size_t>(clustersX) * clustersY;
+        clusters.assign(clusterCount, {});
+        eastBorders.assign(clusterCount, {});
+        northBorders.assign(clusterCount, {});
+        walkable.assign(static_cast<size_t>(width) * height, 0);
+        nodeOfCell.assign(walkable.size(), -1);
+        nodeCells.clear();
+    }
+    rebuildAll = false;
+    gridDirty = false;
+    if (tilemap) gridVersion = tilemap->getVersion();
+
+    // Diff against the last grid; only clusters holding a changed tile are rebuilt
+    std::vector<uint8_t> dirty(clusters.size(), layout ? 1 : 0);
+    bool anyDirty = layout;
+    if (tilemap) {
+        const uint16_t* tiles = tilemap->getTiles();
+        for (size_t i = 0; i < walkable.size(); ++i) {
+            const uint8_t open = tiles[i] < blockedTypes.size() && blockedTypes[tiles[i]] ? 0 : 1;
+            if (open == walkable[i]) continue;
+            walkable[i] = open;
+            dirty[clusterOf(static_cast<uint32_t>(i))] = 1;
+            anyDirty = true;
+        }
+    }
+    if (!anyDirty) return;
+
+    // Borders on every side of a dirty cluster, then each cluster that owns one of their transitions
+    std::vector<uint8_t> affected(clusters.size(), 0);
+    for (uint32_t c = 0; c < clusters.size(); ++c) {
+        if (!dirty[c]) continue;
+        const int cx = static_cast<int>(c % clustersX);
+        const int cy = static_cast<int>(c / clustersX);
+        affected[c] = 1;
+        if (cx > 0) affected[c - 1] = 1;
+        if (cx + 1 < clustersX) affected[c + 1] = 1;
+        if (cy > 0) affected[c - clustersX] = 1;
+        if (cy + 1 < clustersY) affected[c + clustersX] = 1;
+    }
+    for (uint32_t c = 0; c < clusters.size(); ++c) {
+        if (!affected[c]) continue;
+        int x0, y0, x1, y1;
+        clusterRect(c, x0, y0, x1, y1);
+        const int cx = static_cast<int>(c % clustersX);
+        const int cy = static_cast<int>(c / clustersX);
+        eastBorders[c].clear();
+        northBorders[c].clear();
+        if (cx + 1 < clustersX) buildBorder(eastBorders[c], x1 - 1, y0, 0, 1, y1 - y0, 1, 0);
+        if (cy + 1 < clustersY) buildBorder(northBorders[c], x0, y1 - 1, 1, 0, x1 - x0, 0, 1);
+    }
+
+    // A neighbour of an affected cluster may gain or lose nodes through their shared border
+    std::vector<uint32_t> rebuild;
+    for (uint32_t c = 0; c < clusters.size(); ++c) {
+        const int cx = static_cast<int>(c % clustersX);
+        const int cy = static_cast<int>(c / clustersX);
+        if (affected[c] || (cx > 0 && affected[c - 1]) || (cy > 0 && affected[c - clustersX])) {
+            rebuild.push_back(c);
+        }
+    }
+    if (jobs && rebuild.size() > rebuildGrain) {
+        jobs->parallelFor(rebuild.size(), rebuildGrain, [this, &rebuild](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                rebuildCluster(rebuild[i]);
+            }
+        });
+    } else {
+        for (const uint32_t c : rebuild) {
+            rebuildCluster(c);
+        }
+    }
+
+    rebuildGraph();
+    invalidate(dirty, layout);
+
+    stats.clustersRebuilt += rebuild.size();
+    stats.syncMillis = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void PathfindingService::buildBorder(std::vector<Entrance>& out, int x0, int y0, int stepX, int stepY, int length,
+                                     int offsetX, int offsetY) const {
+    // Each run of tiles open on both sides of the border is one entrance
+    int runStart = -1;
+    for (int k = 0; k <= length; ++k) {
+        bool open = false;
+        if (k < length) {
+            const size_t inside = static_cast<size_t>(y0 + k * stepY) * width + (x0 + k * stepX);
+            const size_t outside = static_cast<size_t>(y0 + k * stepY + offsetY) * width + (x0 + k * stepX + offsetX);
+            open = walkable[inside] && walkable[outside];
+        }
+        if (open && runStart < 0) {
+            runStart = k;
+        } else if (!open && runStart >= 0) {
+            const int runLength = k - runStart;
+            const auto add = [&](int at) {
+                const uint32_t inside = static_cast<uint32_t>(y0 + at * stepY) * width + (x0 + at * stepX);
+                out.push_back({inside, inside + static_cast<uint32_t>(offsetY * width + offsetX)});
+            };
+            if (runLength >= wideEntrance) {
+                add(runStart);
+                add(k - 1);
+            } else {
+                add(runStart + runLength / 2);
+            }
+            runStart = -1;
+        }
+    }
+}
+
+void PathfindingService::rebuildCluster(uint32_t c) {
+    Cluster& cluster = clusters[c];
+    cluster.nodes.clear();
+    cluster.edges.clear();
+
+    const int cx = static_cast<int>(c % clustersX);
+    const int cy = static_cast<int>(c / clustersX);
+    for (const Entrance& entrance : eastBorders[c]) cluster.nodes.push_back(entrance.inside);
+    for (const Entrance& entrance : northBorders[c]) cluster.nodes.push_back(entrance.inside);
+    if (cx > 0) {
+        for (const Entrance& entrance : eastBorders[c - 1]) cluster.nodes.push_back(entrance.outside);
+    }
+    if (cy > 0) {
+        for (const Entrance& entrance : northBorders[c - clustersX]) cluster.nodes.push_back(entrance.outside);
+    }
+    std::sort(cluster.nodes.begin(), cluster.nodes.end());
+    cluster.nodes.erase(std::unique(cluster.nodes.begin(), cluster.nodes.end()), cluster.nodes.end());
+
+    // Costs between the cluster's nodes without leaving it
+    Rect rect;
+    clusterRect(c, rect.x0, rect.y0, rect.x1, rect.y1);
+    const int rectWidth = rect.x1 - rect.x0;
+    SearchScratch scratch;
+    for (size_t i = 0; i + 1 < cluster.nodes.size(); ++i) {
+        const uint32_t from = cluster.nodes[i];
+        searchRect(walkable.data(), width, rect, static_cast<int>(from % width), static_cast<int>(from / width),
+                   0, 0, false, scratch);
+        for (size_t j = i + 1; j < cluster.nodes.size(); ++j) {
+            const uint32_t to = cluster.nodes[j];
+            const int local = (static_cast<int>(to / width) - rect.y0) * rectWidth + static_cast<int>(to % width) - rect.x0;
+            const float cost = scratch.cost[local];
+            if (cost != unreachable) {
+                cluster.edges.push_back({from, to, cost});
+            }
+        }
+    }
+}
+
+void PathfindingService::rebuildGraph() {
+    for (const uint32_t cell : nodeCells) {
+        nodeOfCell[cell] = -1;
+    }
+    nodeCells.clear();
+    nodeClusters.clear();
+    for (uint32_t c = 0; c < clusters.size(); ++c) {
+        for (const uint32_t cell : clusters[c].nodes) {
+            nodeOfCell[cell] = static_cast<int32_t>(nodeCells.size());
+            nodeCells.push_back(cell);
+            nodeClusters.push_back(c);
+        }
+    }
+
+    // Both directions of every intra-cluster edge and every border crossing
+    std::vector<std::pair<uint32_t, AbstractEdge>> links;
+    const auto link = [&](uint32_t a, uint32_t b, float cost) {
+        const auto nodeA = static_cast<uint32_t>(nodeOfCell[a]);
+        const auto nodeB = static_cast<uint32_t>(nodeOfCell[b]);
+        links.push_back({nodeA, {nodeB, cost}});
+        links.push_back({nodeB, {nodeA, cost}});
+    };
+    for (uint32_t c = 0; c < clusters.size(); ++c) {
+        for (const IntraEdge& edge : clusters[c].edges) link(edge.a, edge.b, edge.cost);
+        for (const Entrance& entrance : eastBorders[c]) link(entrance.inside, entrance.outside, 1.0f);
+        for (const Entrance& entrance : northBorders[c]) link(entrance.inside, entrance.outside, 1.0f);
+    }
+
+    edgeStart.assign(nodeCells.size() + 1, 0);
+    for (const auto& entry : links) edgeStart[entry.first + 1]++;
+    for (size_t i = 1; i < edgeStart.size(); ++i) edgeStart[i] += edgeStart[i - 1];
+    edges.resize(links.size());
+    std::vector<uint32_t> next(edgeStart.begin(), edgeStart.end() - 1);
+    for (const auto& entry : links) edges[next[entry.first]++] = entry.second;
+
+    stats.clusters = clusters.size();
+    stats.abstractNodes = nodeCells.size();
+    stats.abstractEdges = edges.size();
+}
+
+void PathfindingService::invalidate(const std::vector<uint8_t>& dirtyClusters, bool everything) {
+    // A route is only broken where a tile on it changed; "no path" may have opened up anywhere
+    const auto broken = [&](const PathResult& result) {
+        if (everything || !result.found) return true;
+        for (const uint32_t c : result.clusters) {
+            if (dirtyClusters[c]) return true;
+        }
+        return false;
+    };
+
+    for (auto it = pathCache.begin(); it != pathCache.end();) {
+        it = broken(*it->second) ? pathCache.erase(it) : std::next(it);
+    }
+    for (auto& [id, request] : requests) {
+        if (request.status != PathStatus::Ready && request.status != PathStatus::NoPath) continue;
+        if (request.result && broken(*request.result)) {
+            request.status = PathStatus::Stale;
+            stats.invalidated++;
+        }
+    }
+
+    // Every field spans the whole map; the old one keeps steering until its replacement lands
+    if (everything) fieldOfGoal.clear();
+    for (auto& [id, entry] : fields) {
+        if (everything) {
+            entry.field.reset();
+            if (!cellAt(entry.goalX, entry.goalY, entry.goalCell)) entry.goalCell = invalidCell;
+            if (entry.goalCell != invalidCell && !fieldOfGoal.count(entry.goalCell)) fieldOfGoal[entry.goalCell] = id;
+        }
+        if (!entry.queued) {
+            entry.queued = true;
+            fieldQueue.push_back(id);
+        }
+    }
+}
+
+void PathfindingService::launch() {
+    // Repeated trips in the queue share one search
+    std::unordered_map<uint64_t, size_t> batched;
+    while (!pathQueue.empty() && pathTasks.size() < settings.pathsPerTick) {
+        const PathRequestId id = pathQueue.front();
+        pathQueue.pop_front();
+        auto it = requests.find(id);
+        if (it == requests.end() || it->second.status != PathStatus::Pending) continue;
+        PathRequest& request = it->second;
+
+        uint32_t startCell, goalCell;
+        if (!cellAt(request.startX, request.startY, startCell) || !cellAt(request.goalX, request.goalY, goalCell)) {
+            request.status = PathStatus::NoPath;
+            continue;
+        }
+
+        const uint64_t key = pathKey(startCell, goalCell);
+        auto cached = pathCache.find(key);
+        if (cached != pathCache.end()) {
+            request.result = cached->second;
+            request.status = cached->second->found ? PathStatus::Ready : PathStatus::NoPath;
+            stats.cacheHits++;
+            continue;
+        }
+
+        auto [slot, added] = batched.try_emplace(key, pathTasks.size());
+        if (added) {
+            pathTasks.push_back({startCell, goalCell, std::make_shared<PathResult>(), {}});
+        }
+        pathTasks[slot->second].waiters.push_back(id);
+    }
+
+    while (!fieldQueue.empty() && fieldTasks.size() < settings.fieldsPerTick) {
+        const FlowFieldId id = fieldQueue.front();
+        fieldQueue.pop_front();
+        auto it = fields.find(id);
+        if (it == fields.end() || !it->second.queued) continue;
+        it->second.queued = false;
+        if (it->second.goalCell == invalidCell && cellAt(it->second.goalX, it->second.goalY, it->second.goalCell)) {
+            // Acquired before the grid existed; later agents with this goal can share it now
+            fieldOfGoal.try_emplace(it->second.goalCell, id);
+        }
+        fieldTasks.push_back({id, it->second.goalCell, std::make_shared<FlowField>()});
+    }
+
+    // Results are published by the next step() either way, so timing never shows in the simulation
+    if (jobs) {
+        for (PathTask& task : pathTasks) {
+            jobs->submit([this, &task] { searchPath(task); }, &inFlight);
+        }
+        for (FieldTask& task : fieldTasks) {
+            jobs->submit([this, &task] { buildField(task); }, &inFlight);
+        }
+    } else {
+        for (PathTask& task : pathTasks) searchPath(task);
+        for (FieldTask& task : fieldTasks) buildField(task);
+    }
+}
+
+void PathfindingService::searchPath(PathTask& task) const {
+    PathResult& result = *task.result;
+    const uint32_t start = task.startCell;
+    const uint32_t goal = task.goalCell;
+    if (!walkable[start] || !walkable[goal]) return;
+
+    const int goalX = static_cast<int>(goal % width);
+    const int goalY = static_cast<int>(goal / width);
+    const uint32_t startCluster = clusterOf(start);
+    const uint32_t goalCluster = clusterOf(goal);
+
+    SearchScratch scratch;
+    Rect rect;
+    const auto localIndex = [&](uint32_t cell) {
+        return (static_cast<int>(cell / width) - rect.y0) * (rect.x1 - rect.x0) + static_cast<int>(cell % width) - rect.x0;
+    };
+
+    // Link the start to its cluster's nodes; when the goal shares the cluster this also finds the direct route
+    clusterRect(startCluster, rect.x0, rect.y0, rect.x1, rect.y1);
+    searchRect(walkable.data(), width, rect, static_cast<int>(start % width), static_cast<int>(start / width), 0, 0, false, scratch);
+    std::vector<std::pair<uint32_t, float>> startLinks;
+    for (const uint32_t cell : clusters[startCluster].nodes) {
+        const float cost = scratch.cost[localIndex(cell)];
+        if (cost != unreachable) startLinks.push_back({static_cast<uint32_t>(nodeOfCell[cell]), cost});
+    }
+    float best = startCluster == goalCluster ? scratch.cost[localIndex(goal)] : unreachable;
+
+    // And the goal to its cluster's nodes; moves cost the same both ways
+    clusterRect(goalCluster, rect.x0, rect.y0, rect.x1, rect.y1);
+    searchRect(walkable.data(), width, rect, goalX, goalY, 0, 0, false, scratch);
+    std::vector<std::pair<uint32_t, float>> goalLinks;
+    for (const uint32_t cell : clusters[goalCluster].nodes) {
+        const float cost = scratch.cost[localIndex(cell)];
+        if (cost != unreachable) goalLinks.push_back({static_cast<uint32_t>(nodeOfCell[cell]), cost});
+    }
+
+    // A* over the abstract graph
+    const size_t nodeCount = nodeCells.size();
+    std::vector<float> cost(nodeCount, unreachable);
+    std::vector<int32_t> parent(nodeCount, -1);
+    std::vector<uint8_t> closed(nodeCount, 0);
+    std::vector<std::pair<float, uint32_t>> open;
+    const std::greater<> later;
+    const auto estimate = [&](uint32_t node) {
+        const uint32_t cell = nodeCells[node];
+        return octile(goalX - static_cast<int>(cell % width), goalY - static_cast<int>(cell / width));
+    };
+
+    for (const auto& [node, linkCost] : startLinks) {
+        if (linkCost < cost[node]) {
+            cost[node] = linkCost;
+            open.push_back({linkCost + estimate(node), node});
+            std::push_heap(open.begin(), open.end(), later);
+        }
+    }
+
+    int32_t lastNode = -1;     // node the best route enters the goal from; -1 = direct
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), later);
+        const auto [priority, node] = open.back();
+        open.pop_back();
+        if (priority >= best) break;
+        if (closed[node]) continue;
+        closed[node] = 1;
+
+        if (nodeClusters[node] == goalCluster) {
+            for (const auto& [goalNode, linkCost] : goalLinks) {
+                if (goalNode == node && cost[node] + linkCost < best) {
+                    best = cost[node] + linkCost;
+                    lastNode = static_cast<int32_t>(node);
+                }
+            }
+        }
+
+        for (uint32_t e = edgeStart[node]; e < edgeStart[node + 1]; ++e) {
+            const AbstractEdge& edge = edges[e];
+            const float next = cost[node] + edge.cost;
+            if (next < cost[edge.to]) {
+                cost[edge.to] = next;
+                parent[edge.to] = static_cast<int32_t>(node);
+                open.push_back({next + estimate(edge.to), edge.to});
+                std::push_heap(open.begin(), open.end(), later);
+            }
+        }
+    }
+    if (best == unreachable) return;
+
+    std::vector<uint32_t> waypoints;
+    for (int32_t node = lastNode; node >= 0; node = parent[node]) {
+        waypoints.push_back(nodeCells[node]);
+    }
+    std::reverse(waypoints.begin(), waypoints.end());
+    waypoints.push_back(goal);
+
+    // Refine: neighbouring nodes across a border are adjacent tiles, nodes in one cluster are joined by A* inside it
+    std::vector<uint32_t> cells{start};
+    std::vector<uint32_t> segment;
+    for (const uint32_t to : waypoints) {
+        const uint32_t from = cells.back();
+        if (from == to) continue;
+        const uint32_t cluster = clusterOf(from);
+        if (cluster != clusterOf(to)) {
+            cells.push_back(to);
+            continue;
+        }
+
+        clusterRect(cluster, rect.x0, rect.y0, rect.x1, rect.y1);
+        searchRect(walkable.data(), width, rect, static_cast<int>(from % width), static_cast<int>(from / width),
+                   static_cast<int>(to % width), static_cast<int>(to / width), true, scratch);
+        segment.clear();
+        for (int32_t local = localIndex(to); local != localIndex(from); local = scratch.parent[local]) {
+            const int rectWidth = rect.x1 - rect.x0;
+            segment.push_back(static_cast<uint32_t>((rect.y0 + local / rectWidth) * width + rect.x0 + local % rectWidth));
+        }
+        cells.insert(cells.end(), segment.rbegin(), segment.rend());
+    }
+
+    // Keep the ends and the tiles where the route turns
+    result.found = true;
+    for (size_t i = 0; i < cells.size(); ++i) {
+        const uint32_t cell = cells[i];
+        result.clusters.push_back(clusterOf(cell));
+        if (i > 0 && i + 1 < cells.size()) {
+            const int inX = static_cast<int>(cell % width) - static_cast<int>(cells[i - 1] % width);
+            const int inY = static_cast<int>(cell / width) - static_cast<int>(cells[i - 1] / width);
+            const int outX = static_cast<int>(cells[i + 1] % width) - static_cast<int>(cell % width);
+            const int outY = static_cast<int>(cells[i + 1] / width) - static_cast<int>(cell / width);
+            if (inX == outX && inY == outY) continue;
+        }
+        result.points.push_back({originX + (static_cast<float>(cell % width) + 0.5f) * tileSize,
+                                 originY + (static_cast<float>(cell / width) + 0.5f) * tileSize});
+    }
+    std::sort(result.clusters.begin(), result.clusters.end());
+    result.clusters.erase(std::unique(result.clusters.begin(), result.clusters.end()), result.clusters.end());
+}
+
+void PathfindingService::buildField(FieldTask& task) const {
+    FlowField& field = *task.field;
+    const size_t count = walkable.size();
+    field.cost.assign(count, unreachable);
+    field.direction.assign(count, noDirection);
+    if (task.goalCell >= count || !walkable[task.goalCell]) return;
+
+    // Dijkstra from the goal over the whole map
+    const Rect rect{0, 0, width, height};
+    SearchScratch scratch;
+    searchRect(walkable.data(), width, rect, static_cast<int>(task.goalCell % width),
+               static_cast<int>(task.goalCell / width), 0, 0, false, scratch);
+    field.cost = std::move(scratch.cost);
+
+    // Each tile points at its cheapest neighbour
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            const size_t cell = static_cast<size_t>(y) * width + x;
+            float best = field.cost[cell];
+            if (best == unreachable) continue;
+            for (int direction = 0; direction < 8; ++direction) {
+                int nextX, nextY;
+                if (!canStep(walkable.data(), width, rect, x, y, direction, nextX, nextY)) continue;
+                const float next = field.cost[static_cast<size_t>(nextY) * width + nextX];
+                if (next < best) {
+                    best = next;
+                    field.direction[cell] = static_cast<uint8_t>(direction);
+                }
+            }
+        }
+    }
+}
+
+void PathfindingService::reportStats(std::ostream& out) const {
+    out << "Pathfinding: " << stats.clusters << " clusters, " << stats.abstractNodes << " nodes, "
+        << stats.abstractEdges << " edges; " << stats.pathsSearched << " paths searched, " << stats.cacheHits
+        << " cache hits, " << stats.fieldsBuilt << " fields, " << stats.invalidated << " invalidated, "
+        << stats.queuedPaths << " paths queued, last edit " << stats.syncMillis << " ms" << std::endl;
+}
@@ -0,0 +1,237 @@
+#ifndef ENGINE_PATHFINDINGSERVICE_H
+#define ENGINE_PATHFINDINGSERVICE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include "jobs/JobSystem.h"
+#include "service/IService.h"
+
+class TilemapComponent;
+
+using PathRequestId = uint32_t;
+constexpr PathRequestId invalidPathRequest = 0;
+
+using FlowFieldId = uint32_t;
+constexpr FlowFieldId invalidFlowField = 0;
+
+enum class PathStatus : uint8_t {
+    Pending,    // queued or being searched
+    Ready,
+    NoPath,     // start or goal blocked, or no route between them
+    Stale,      // tiles changed under the result; it stays readable until requested again
+    Unknown     // never requested, or released
+};
+
+// Waypoint in world units, at a tile centre
+struct PathPoint {
+    float x;
+    float y;
+};
+
+struct PathfindingSettings {
+    int clusterSize = 16;           // tiles per side of a cluster in the abstract graph
+    size_t pathsPerTick = 64;       // new path searches started per tick
+    size_t fieldsPerTick = 1;       // new flow fields started per tick
+};
+
+struct PathfindingStats {
+    size_t clusters = 0;
+    size_t abstractNodes = 0;
+    size_t abstractEdges = 0;
+    size_t queuedPaths = 0;
+    size_t queuedFields = 0;
+    size_t pathsSearched = 0;       // totals from here on
+    size_t fieldsBuilt = 0;
+    size_t cacheHits = 0;
+    size_t invalidated = 0;         // results made stale by tile edits
+    size_t clustersRebuilt = 0;
+    double syncMillis = 0.0;        // last grid update
+};
+
+// Paths and flow fields over the arena tilemap, for many AI agents at once
+// Individual paths use hierarchical A*: the map is cut into square clusters, the walkable openings
+// between neighbouring clusters become nodes of a small abstract graph, and a search over that graph
+// is refined cluster by cluster into tiles. Agents that share a goal share one flow field instead: a
+// Dijkstra from the goal over the whole grid, sampled as a direction per tile.
+// Requests queue up and are started a bounded number per tick on the job system; their results appear
+// on the next step(), so they land on the same tick whether or not a job system is present. Results
+// are cached by start and goal tile. Tile edits rebuild only the clusters they touch and mark only the
+// paths crossing those clusters stale; flow fields are rebuilt in the background and keep answering
+// from the old field until the new one is ready
+class PathfindingService : public IService {
+public:
+    explicit PathfindingService(JobSystem* jobs = nullptr);
+    ~PathfindingService() override;
+
+    PathfindingService(const PathfindingService&) = delete;
+    PathfindingService& operator=(const PathfindingService&) = delete;
+
+    // Tile (x, y) covers origin + [x, x + 1] * tileSize by [y, y + 1] * tileSize in world space
+    void setTilemap(const TilemapComponent* tilemap, float originX, float originY);
+    void setBlocked(uint16_t type, bool blocked = true);
+
+    void setSettings(const PathfindingSettings& value);
+    const PathfindingSettings& getSettings() const { return settings; }
+
+    // Requests hold their result until released
+    PathRequestId requestPath(float startX, float startY, float goalX, float goalY);
+    PathStatus getPathStatus(PathRequestId id) const;
+    // Start to goal; empty unless the status is Ready or Stale
+    const std::vector<PathPoint>& getPath(PathRequestId id) const;
+    void releasePath(PathRequestId id);
+
+    // Shared by every agent heading for the same goal tile; released once per acquire
+    FlowFieldId acquireFlowField(float goalX, float goalY);
+    bool isFlowFieldReady(FlowFieldId id) const;
+    // Unit direction towards the goal; false until the field is ready, at the goal, or when unreachable
+    bool sampleFlow(FlowFieldId id, float x, float y, float& outX, float& outY) const;
+    void releaseFlowField(FlowFieldId id);
+
+    bool isWalkable(float x, float y) const;
+
+    // Publish last tick's searches, apply tile edits, then start this tick's share of the queue
+    void step();
+
+    const PathfindingStats& getStats() const { return stats; }
+    void reportStats(std::ostream& out) const;
+
+    // Driven from the fixed tick (WorldEngine::physicsTick), not the frame
+    void update(int dt) override {}
+
+private:
+    struct PathResult {
+        bool found = false;
+        std::vector<PathPoint> points;
+        std::vector<uint32_t> clusters;     // crossed by the route, sorted
+    };
+
+    struct PathRequest {
+        float startX, startY, goalX, goalY;
+        PathStatus status = PathStatus::Pending;
+        std::shared_ptr<const PathResult> result;
+    };
+
+    struct PathTask {
+        uint32_t startCell;
+        uint32_t goalCell;
+        std::shared_ptr<PathResult> result;
+        std::vector<PathRequestId> waiters;
+    };
+
+    struct FlowField {
+        std::vector<float> cost;            // tiles to the goal, infinity when unreachable
+        std::vector<uint8_t> direction;     // index into the eight neighbours; noDirection at the goal or unreachable
+    };
+
+    struct FlowFieldEntry {
+        float goalX, goalY;
+        uint32_t goalCell;
+        int refs = 1;
+        bool queued = false;
+        std::shared_ptr<const FlowField> field;
+    };
+
+    struct FieldTask {
+        FlowFieldId id;
+        uint32_t goalCell;
+        std::shared_ptr<FlowField> field;
+    };
+
+    // One transition between neighbouring clusters: a walkable tile on each side of the border
+    struct Entrance {
+        uint32_t inside;
+        uint32_t outside;
+    };
+
+    struct IntraEdge {
+        uint32_t a;
+        uint32_t b;
+        float cost;
+    };
+
+    // Abstract graph nodes of one cluster and the costs between them through its interior
+    struct Cluster {
+        std::vector<uint32_t> nodes;        // cells, sorted
+        std::vector<IntraEdge> edges;
+    };
+
+    struct AbstractEdge {
+        uint32_t to;
+        float cost;
+    };
+
+    JobSystem* jobs;
+    JobCounter inFlight;
+    PathfindingSettings settings;
+
+    // As set by the game; read only by step()
+    const TilemapComponent* tilemap = nullptr;
+    float tilemapOriginX = 0.0f;
+    float tilemapOriginY = 0.0f;
+    std::vector<uint8_t> blockedTypes;
+    unsigned int gridVersion = 0;       // tilemap version the grid was built from
+    bool rebuildAll = true;             // layout changed
+    bool gridDirty = false;             // blocked types changed
+
+    // The grid the searches run on, changed only by step() while no job is running
+    float originX = 0.0f;
+    float originY = 0.0f;
+    float tileSize = 1.0f;
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> walkable;      // one byte per tile
+
+    // Hierarchy; eastBorders[c] / northBorders[c] link cluster c to its right / upper neighbour
+    int clusterSize = 16;
+    int clustersX = 0;
+    int clustersY = 0;
+    std::vector<Cluster> clusters;
+    std::vector<std::vector<Entrance>> eastBorders;
+    std::vector<std::vector<Entrance>> northBorders;
+
+    // Abstract graph in compressed rows, rebuilt from the clusters after every edit
+    std::vector<uint32_t> nodeCells;
+    std::vector<uint32_t> nodeClusters;
+    std::vector<uint32_t> edgeStart;
+    std::vector<AbstractEdge> edges;
+    std::vector<int32_t> nodeOfCell;
+
+    std::unordered_map<PathRequestId, PathRequest> requests;
+    std::deque<PathRequestId> pathQueue;
+    std::unordered_map<uint64_t, std::shared_ptr<const PathResult>> pathCache;
+    PathRequestId nextRequestId = 1;
+
+    std::unordered_map<FlowFieldId, FlowFieldEntry> fields;
+    std::unordered_map<uint32_t, FlowFieldId> fieldOfGoal;
+    std::deque<FlowFieldId> fieldQueue;
+    FlowFieldId nextFieldId = 1;
+
+    // Running between one step() and the next; the grid and graph stay untouched meanwhile
+    std::vector<PathTask> pathTasks;
+    std::vector<FieldTask> fieldTasks;
+
+    PathfindingStats stats;
+
+    bool cellAt(float x, float y, uint32_t& outCell) const;
+    uint32_t clusterOf(uint32_t cell) const;
+    void clusterRect(uint32_t cluster, int& x0, int& y0, int& x1, int& y1) const;
+
+    void publish();
+    void syncGrid();
+    void buildBorder(std::vector<Entrance>& out, int x0, int y0, int stepX, int stepY, int length, int offsetX, int offsetY) const;
+    void rebuildCluster(uint32_t cluster);
+    void rebuildGraph();
+    void invalidate(const std::vector<uint8_t>& dirtyClusters, bool everything);
+    void launch();
+
+    void searchPath(PathTask& task) const;
+    void buildField(FieldTask& task) const;
+};
+
+#endif //ENGINE_PATHFINDINGSERVICE_H
@@ -0,0 +1,629 @@
+#include "PhysicsWorld.h"
+#include "collision/CollisionWorld.h"
+#include "jobs/JobSystem.h"
+#include "transform/TransformComponent.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+namespace {
+    // Below this many awake bodies, threading costs more than it saves
+    constexpr size_t parallelBodies = 256;
+    constexpr uint32_t noIsland = ~0u;
+
+    float cross(float ax, float ay, float bx, float by) {
+        return ax * by - ay * bx;
+    }
+}
+
+PhysicsWorld::PhysicsWorld(JobSystem* jobs) : jobs(jobs) {}
+
+BodyId PhysicsWorld::createBody(const BodyDesc& desc) {
+    BodyId id;
+    if (!freeBodies.empty()) {
+        id = freeBodies.back();
+        freeBodies.pop_back();
+    } else {
+        id = static_cast<BodyId>(active.size());
+        const size_t count = static_cast<size_t>(id) + 1;
+        for (auto* array : {&positionX, &positionY, &angle, &velocityX, &velocityY, &angularVelocity,
+                            &forceX, &forceY, &torque, &mass, &inverseMass, &inverseInertia,
+                            &friction, &restitution, &linearDamping, &angularDamping, &sleepTime}) {
+            array->resize(count, 0.0f);
+        }
+        active.resize(count, 0);
+        awake.resize(count, 0);
+        fixedRotation.resize(count, 0);
+        type.resize(count, BodyType::Static);
+        collider.resize(count, invalidCollider);
+        transform.resize(count, nullptr);
+    }
+
+    const bool dynamic = desc.type == BodyType::Dynamic;
+    active[id] = 1;
+    awake[id] = dynamic ? 1 : 0;
+    type[id] = desc.type;
+    fixedRotation[id] = desc.fixedRotation ? 1 : 0;
+    positionX[id] = desc.x;
+    positionY[id] = desc.y;
+    angle[id] = desc.angle;
+    velocityX[id] = velocityY[id] = angularVelocity[id] = 0.0f;
+    forceX[id] = forceY[id] = torque[id] = 0.0f;
+    mass[id] = desc.mass;
+    inverseMass[id] = dynamic && desc.mass > 0.0f ? 1.0f / desc.mass : 0.0f;
+    inverseInertia[id] = dynamic && !desc.fixedRotation && desc.inertia > 0.0f ? 1.0f / desc.inertia : 0.0f;
+    friction[id] = desc.friction;
+    restitution[id] = desc.restitution;
+    linearDamping[id] = desc.linearDamping;
+    angularDamping[id] = desc.angularDamping;
+    sleepTime[id] = 0.0f;
+    collider[id] = invalidCollider;
+    transform[id] = nullptr;
+    return id;
+}
+
+void PhysicsWorld::destroyBody(BodyId id) {
+    if (!isValid(id)) return;
+
+    for (JointId joint = 0; joint < joints.size(); ++joint) {
+        if (joints[joint].active && (joints[joint].desc.a == id || joints[joint].desc.b == id)) {
+            destroyJoint(joint);
+        }
+    }
+    if (collider[id] != invalidCollider && collider[id] < colliderToBody.size()) {
+        colliderToBody[collider[id]] = invalidBody;
+    }
+    active[id] = 0;
+    awake[id] = 0;
+    collider[id] = invalidCollider;
+    transform[id] = nullptr;
+    freeBodies.push_back(id);
+}
+
+void PhysicsWorld::attach(BodyId id, TransformComponent* target, ColliderId colliderId, const CollisionShape& shape) {
+    if (!isValid(id)) return;
+
+    transform[id] = target;
+    if (target) {
+        positionX[id] = target->position.x;
+        positionY[id] = target->position.y;
+        angle[id] = target->rotation;
+    }
+
+    if (collider[id] != invalidCollider && collider[id] < colliderToBody.size()) {
+        colliderToBody[collider[id]] = invalidBody;
+    }
+    collider[id] = colliderId;
+    if (colliderId != invalidCollider) {
+        if (colliderId >= colliderToBody.size()) {
+            colliderToBody.resize(static_cast<size_t>(colliderId) + 1, invalidBody);
+        }
+        colliderToBody[colliderId] = id;
+        setInertiaFromShape(id, shape);
+    }
+    wake(id);
+}
+
+void PhysicsWorld::setInertiaFromShape(BodyId id, const CollisionShape& shape) {
+    if (!isDynamic(id) || fixedRotation[id] || inverseInertia[id] > 0.0f) return;
+
+    // Solid disc and solid rectangle about their centres
+    float inertia = 0.0f;
+    if (shape.type == ShapeType::Circle) {
+        inertia = 0.5f * mass[id] * shape.radius * shape.radius;
+    } else {
+        inertia = mass[id] * (shape.halfWidth * shape.halfWidth + shape.halfHeight * shape.halfHeight) / 3.0f;
+    }
+    inverseInertia[id] = inertia > 0.0f ? 1.0f / inertia : 0.0f;
+}
+
+JointId PhysicsWorld::createJoint(const JointDesc& desc) {
+    if (!isValid(desc.a) || !isValid(desc.b) || desc.a == desc.b) {
+        std::cerr << "ERROR::PHYSICS::Joint needs two different valid bodies" << std::endl;
+        return invalidJoint;
+    }
+
+    JointId id;
+    if (!freeJoints.empty()) {
+        id = freeJoints.back();
+        freeJoints.pop_back();
+    } else {
+        id = static_cast<JointId>(joints.size());
+        joints.emplace_back();
+    }
+
+    Joint& joint = joints[id];
+    joint.desc = desc;
+    joint.active = true;
+
+    if (desc.type == JointType::Distance && desc.length < 0.0f) {
+        const float ca = std::cos(angle[desc.a]), sa = std::sin(angle[desc.a]);
+        const float cb = std::cos(angle[desc.b]), sb = std::sin(angle[desc.b]);
+        const float dx = positionX[desc.b] + cb * desc.anchorBX - sb * desc.anchorBY
+                       - positionX[desc.a] - ca * desc.anchorAX + sa * desc.anchorAY;
+        const float dy = positionY[desc.b] + sb * desc.anchorBX + cb * desc.anchorBY
+                       - positionY[desc.a] - sa * desc.anchorAX - ca * desc.anchorAY;
+        joint.desc.length = std::sqrt(dx * dx + dy * dy);
+    }
+
+    wake(desc.a);
+    wake(desc.b);
+    return id;
+}
+
+void PhysicsWorld::destroyJoint(JointId id) {
+    if (id >= joints.size() || !joints[id].active) return;
+
+    joints[id].active = false;
+    wake(joints[id].desc.a);
+    wake(joints[id].desc.b);
+    freeJoints.push_back(id);
+}
+
+void PhysicsWorld::applyForce(BodyId id, float x, float y) {
+    if (!isValid(id) || !isDynamic(id)) return;
+    forceX[id] += x;
+    forceY[id] += y;
+    wake(id);
+}
+
+void PhysicsWorld::applyTorque(BodyId id, float value) {
+    if (!isValid(id) || !isDynamic(id)) return;
+    torque[id] += value;
+    wake(id);
+}
+
+void PhysicsWorld::applyImpulse(BodyId id, float x, float y) {
+    if (!isValid(id) || !isDynamic(id)) return;
+    velocityX[id] += x * inverseMass[id];
+    velocityY[id] += y * inverseMass[id];
+    wake(id);
+}
+
+void PhysicsWorld::setVelocity(BodyId id, float x, float y, float angular) {
+    if (!isValid(id) || !isDynamic(id)) return;
+    velocityX[id] = x;
+    velocityY[id] = y;
+    angularVelocity[id] = fixedRotation[id] ? 0.0f : angular;
+    wake(id);
+}
+
+void PhysicsWorld::setPose(BodyId id, float x, float y, float value) {
+    if (!isValid(id)) return;
+    positionX[id] = x;
+    positionY[id] = y;
+    angle[id] = value;
+    wake(id);
+}
+
+void PhysicsWorld::getPose(BodyId id, float& outX, float& outY, float& outAngle) const {
+    if (!isValid(id)) {
+        outX = outY = outAngle = 0.0f;
+        return;
+    }
+    outX = positionX[id];
+    outY = positionY[id];
+    outAngle = angle[id];
+}
+
+void PhysicsWorld::getVelocity(BodyId id, float& outX, float& outY, float& outAngular) const {
+    if (!isValid(id)) {
+        outX = outY = outAngular = 0.0f;
+        return;
+    }
+    outX = velocityX[id];
+    outY = velocityY[id];
+    outAngular = angularVelocity[id];
+}
+
+void PhysicsWorld::wake(BodyId id) {
+    if (!isValid(id) || !isDynamic(id)) return;
+    awake[id] = 1;
+    sleepTime[id] = 0.0f;
+}
+
+BodyId PhysicsWorld::find(BodyId id) {
+    // Path halving keeps the trees flat without recursion
+    while (parent[id] != id) {
+        parent[id] = parent[parent[id]];
+        id = parent[id];
+    }
+    return id;
+}
+
+void PhysicsWorld::unite(BodyId a, BodyId b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) return;
+    // Lowest id stays the root, so island order only depends on body ids
+    if (a < b) {
+        parent[b] = a;
+    } else {
+        parent[a] = b;
+    }
+}
+
+void PhysicsWorld::buildIslands(const CollisionWorld& collision) {
+    const size_t count = active.size();
+    parent.resize(count);
+    for (BodyId id = 0; id < count; ++id) {
+        parent[id] = id;
+    }
+
+    // Contacts touching at least one dynamic body; colliders without a body act as static scenery
+    std::vector<ContactConstraint>& pending = islandContacts;
+    pending.clear();
+    for (const ContactPair& pair : collision.getContacts()) {
+        const BodyId a = pair.a < colliderToBody.size() ? colliderToBody[pair.a] : invalidBody;
+        const BodyId b = pair.b < colliderToBody.size() ? colliderToBody[pair.b] : invalidBody;
+        if (!isDynamic(a) && !isDynamic(b)) continue;
+        if (isDynamic(a) && isDynamic(b)) {
+            unite(a, b);
+        }
+
+        // Centre of the bounds overlap stands in for the contact point
+        float aMinX, aMinY, aMaxX, aMaxY, bMinX, bMinY, bMaxX, bMaxY;
+        collision.getBounds(pair.a, aMinX, aMinY, aMaxX, aMaxY);
+        collision.getBounds(pair.b, bMinX, bMinY, bMaxX, bMaxY);
+
+        ContactConstraint contact {};
+        contact.a = a;
+        contact.b = b;
+        contact.normalX = pair.normalX;
+        contact.normalY = pair.normalY;
+        contact.depth = pair.depth;
+        contact.pointX = 0.5f * (std::max(aMinX, bMinX) + std::min(aMaxX, bMaxX));
+        contact.pointY = 0.5f * (std::max(aMinY, bMinY) + std::min(aMaxY, bMaxY));
+        const float frictionA = a != invalidBody ? friction[a] : friction[b];
+        const float frictionB = b != invalidBody ? friction[b] : friction[a];
+        contact.friction = std::sqrt(frictionA * frictionB);
+        contact.restitution = std::max(a != invalidBody ? restitution[a] : 0.0f, b != invalidBody ? restitution[b] : 0.0f);
+        pending.push_back(contact);
+    }
+
+    size_t jointCount = 0;
+    for (const Joint& joint : joints) {
+        if (!joint.active) continue;
+        jointCount++;
+        if (isDynamic(joint.desc.a) && isDynamic(joint.desc.b)) {
+            unite(joint.desc.a, joint.desc.b);
+        }
+    }
+
+    // An island is awake if any of its bodies is; touching a sleeping island wakes all of it
+    islandOfRoot.assign(count, noIsland);
+    for (BodyId id = 0; id < count; ++id) {
+        if (active[id] && isDynamic(id) && awake[id]) {
+            islandOfRoot[find(id)] = 0;
+        }
+    }
+    islands.clear();
+    for (BodyId id = 0; id < count; ++id) {
+        if (!active[id] || !isDynamic(id)) continue;
+        const BodyId root = find(id);
+        if (islandOfRoot[root] == noIsland) continue;
+        if (!awake[id]) {
+            awake[id] = 1;
+            sleepTime[id] = 0.0f;
+        }
+        // Numbered in order of each island's lowest body id
+        if (root == id) {
+            islandOfRoot[root] = static_cast<uint32_t>(islands.size());
+            islands.push_back({});
+        }
+    }
+
+    // Counting sort bodies, contacts and joints into island order
+    std::vector<size_t> bodyCounts(islands.size() + 1, 0), contactCounts(islands.size() + 1, 0), jointCounts(islands.size() + 1, 0);
+    auto islandOfBody = [this](BodyId id) { return isDynamic(id) ? islandOfRoot[find(id)] : noIsland; };
+    auto islandOfContact = [&](const ContactConstraint& contact) {
+        return isDynamic(contact.a) ? islandOfBody(contact.a) : islandOfBody(contact.b);
+    };
+    auto islandOfJoint = [&](const JointDesc& desc) {
+        return isDynamic(desc.a) ? islandOfBody(desc.a) : islandOfBody(desc.b);
+    };
+
+    for (BodyId id = 0; id < count; ++id) {
+        if (!active[id]) continue;
+        const uint32_t island = islandOfBody(id);
+        if (island != noIsland) bodyCounts[island + 1]++;
+    }
+    for (const ContactConstraint& contact : pending) {
+        const uint32_t island = islandOfContact(contact);
+        if (island != noIsland) contactCounts[island + 1]++;
+    }
+    for (const Joint& joint : joints) {
+        if (!joint.active) continue;
+        const uint32_t island = islandOfJoint(joint.desc);
+        if (island != noIsland) jointCounts[island + 1]++;
+    }
+    for (size_t i = 1; i <= islands.size(); ++i) {
+        bodyCounts[i] += bodyCounts[i - 1];
+        contactCounts[i] += contactCounts[i - 1];
+        jointCounts[i] += jointCounts[i - 1];
+    }
+    for (size_t i = 0; i < islands.size(); ++i) {
+        islands[i] = {bodyCounts[i], bodyCounts[i + 1], contactCounts[i], contactCounts[i + 1], jointCounts[i], jointCounts[i + 1]};
+    }
+
+    islandBodies.resize(bodyCounts[islands.size()]);
+    for (BodyId id = 0; id < count; ++id) {
+        if (!active[id]) continue;
+        const uint32_t island = islandOfBody(id);
+        if (island != noIsland) islandBodies[bodyCounts[island]++] = id;
+    }
+
+    std::vector<ContactConstraint> sorted(contactCounts[islands.size()]);
+    for (const ContactConstraint& contact : pending) {
+        const uint32_t island = islandOfContact(contact);
+        if (island != noIsland) sorted[contactCounts[island]++] = contact;
+    }
+    islandContacts.swap(sorted);
+
+    islandJoints.resize(jointCounts[islands.size()]);
+    for (JointId id = 0; id < joints.size(); ++id) {
+        if (!joints[id].active) continue;
+        const uint32_t island = islandOfJoint(joints[id].desc);
+        if (island != noIsland) islandJoints[jointCounts[island]++] = id;
+    }
+
+    stats.joints = jointCount;
+}
+
+void PhysicsWorld::relativeVelocity(const ContactConstraint& contact, float& outX, float& outY) const {
+    // Velocity of b's contact point relative to a's
+    outX = 0.0f;
+    outY = 0.0f;
+    if (contact.b != invalidBody) {
+        outX += velocityX[contact.b] - angularVelocity[contact.b] * contact.rBY;
+        outY += velocityY[contact.b] + angularVelocity[contact.b] * contact.rBX;
+    }
+    if (contact.a != invalidBody) {
+        outX -= velocityX[contact.a] - angularVelocity[contact.a] * contact.rAY;
+        outY -= velocityY[contact.a] + angularVelocity[contact.a] * contact.rAX;
+    }
+}
+
+void PhysicsWorld::applyImpulseAt(BodyId id, float impulseX, float impulseY, float rX, float rY) {
+    // Static bodies and scenery are shared between islands; never write to them
+    if (!isDynamic(id)) return;
+    velocityX[id] += impulseX * inverseMass[id];
+    velocityY[id] += impulseY * inverseMass[id];
+    angularVelocity[id] += cross(rX, rY, impulseX, impulseY) * inverseInertia[id];
+}
+
+void PhysicsWorld::prepareContact(ContactConstraint& contact, float dt) const {
+    const BodyId a = contact.a;
+    const BodyId b = contact.b;
+    const float massA = a != invalidBody ? inverseMass[a] : 0.0f;
+    const float massB = b != invalidBody ? inverseMass[b] : 0.0f;
+    const float inertiaA = a != invalidBody ? inverseInertia[a] : 0.0f;
+    const float inertiaB = b != invalidBody ? inverseInertia[b] : 0.0f;
+
+    contact.rAX = a != invalidBody ? contact.pointX - positionX[a] : 0.0f;
+    contact.rAY = a != invalidBody ? contact.pointY - positionY[a] : 0.0f;
+    contact.rBX = b != invalidBody ? contact.pointX - positionX[b] : 0.0f;
+    contact.rBY = b != invalidBody ? contact.pointY - positionY[b] : 0.0f;
+
+    const float nx = contact.normalX;
+    const float ny = contact.normalY;
+    const float rnA = cross(contact.rAX, contact.rAY, nx, ny);
+    const float rnB = cross(contact.rBX, contact.rBY, nx, ny);
+    const float normalK = massA + massB + inertiaA * rnA * rnA + inertiaB * rnB * rnB;
+    contact.normalMass = normalK > 0.0f ? 1.0f / normalK : 0.0f;
+
+    const float rtA = cross(contact.rAX, contact.rAY, -ny, nx);
+    const float rtB = cross(contact.rBX, contact.rBY, -ny, nx);
+    const float tangentK = massA + massB + inertiaA * rtA * rtA + inertiaB * rtB * rtB;
+    contact.tangentMass = tangentK > 0.0f ? 1.0f / tangentK : 0.0f;
+
+    // Push apart a fraction of the penetration per step, and bounce fast impacts
+    contact.bias = settings.baumgarte / dt * std::max(contact.depth - settings.slop, 0.0f);
+    float dvx, dvy;
+    relativeVelocity(contact, dvx, dvy);
+    const float approach = dvx * nx + dvy * ny;
+    if (approach < -settings.restitutionThreshold) {
+        contact.bias = std::max(contact.bias, -contact.restitution * approach);
+    }
+    contact.normalImpulse = 0.0f;
+    contact.tangentImpulse = 0.0f;
+}
+
+void PhysicsWorld::solveContact(ContactConstraint& contact) {
+    const float nx = contact.normalX;
+    const float ny = contact.normalY;
+
+    // Normal: accumulated impulse never pulls the bodies together
+    float dvx, dvy;
+    relativeVelocity(contact, dvx, dvy);
+    float lambda = contact.normalMass * (contact.bias - (dvx * nx + dvy * ny));
+    const float previousNormal = contact.normalImpulse;
+    contact.normalImpulse = std::max(previousNormal + lambda, 0.0f);
+    lambda = contact.normalImpulse - previousNormal;
+    applyImpulseAt(contact.a, -lambda * nx, -lambda * ny, contact.rAX, contact.rAY);
+    applyImpulseAt(contact.b, lambda * nx, lambda * ny, contact.rBX, contact.rBY);
+
+    // Friction: Coulomb cone bounded by the normal impulse
+    const float tx = -ny;
+    const float ty = nx;
+    relativeVelocity(contact, dvx, dvy);
+    lambda = -contact.tangentMass * (dvx * tx + dvy * ty);
+    const float limit = contact.friction * contact.normalImpulse;
+    const float previousTangent = contact.tangentImpulse;
+    contact.tangentImpulse = std::clamp(previousTangent + lambda, -limit, limit);
+    lambda = contact.tangentImpulse - previousTangent;
+    applyImpulseAt(contact.a, -lambda * tx, -lambda * ty, contact.rAX, contact.rAY);
+    applyImpulseAt(contact.b, lambda * tx, lambda * ty, contact.rBX, contact.rBY);
+}
+
+void PhysicsWorld::solveJoint(const JointDesc& joint, float dt) {
+    const BodyId a = joint.a;
+    const BodyId b = joint.b;
+    const float massA = inverseMass[a], massB = inverseMass[b];
+    const float inertiaA = inverseInertia[a], inertiaB = inverseInertia[b];
+
+    // World-space anchor offsets from each body's centre
+    const float ca = std::cos(angle[a]), sa = std::sin(angle[a]);
+    const float cb = std::cos(angle[b]), sb = std::sin(angle[b]);
+    const float rAX = ca * joint.anchorAX - sa * joint.anchorAY;
+    const float rAY = sa * joint.anchorAX + ca * joint.anchorAY;
+    const float rBX = cb * joint.anchorBX - sb * joint.anchorBY;
+    const float rBY = sb * joint.anchorBX + cb * joint.anchorBY;
+
+    const float dvx = velocityX[b] - angularVelocity[b] * rBY - velocityX[a] + angularVelocity[a] * rAY;
+    const float dvy = velocityY[b] + angularVelocity[b] * rBX - velocityY[a] - angularVelocity[a] * rAX;
+    const float errorX = positionX[b] + rBX - positionX[a] - rAX;
+    const float errorY = positionY[b] + rBY - positionY[a] - rAY;
+    const float beta = settings.baumgarte / dt;
+
+    if (joint.type == JointType::Revolute) {
+        // 2x2 point constraint: drive the anchors' relative velocity and separation to zero
+        const float k11 = massA + massB + inertiaA * rAY * rAY + inertiaB * rBY * rBY;
+        const float k12 = -inertiaA * rAX * rAY - inertiaB * rBX * rBY;
+        const float k22 = massA + massB + inertiaA * rAX * rAX + inertiaB * rBX * rBX;
+        const float determinant = k11 * k22 - k12 * k12;
+        if (determinant == 0.0f) return;
+
+        const float bx = -(dvx + beta * errorX);
+        const float by = -(dvy + beta * errorY);
+        const float impulseX = (k22 * bx - k12 * by) / determinant;
+        const float impulseY = (k11 * by - k12 * bx) / determinant;
+        applyImpulseAt(a, -impulseX, -impulseY, rAX, rAY);
+        applyImpulseAt(b, impulseX, impulseY, rBX, rBY);
+    } else {
+        const float length = std::sqrt(errorX * errorX + errorY * errorY);
+        if (length < 1e-6f) return;
+        const float nx = errorX / length;
+        const float ny = errorY / length;
+        const float rnA = cross(rAX, rAY, nx, ny);
+        const float rnB = cross(rBX, rBY, nx, ny);
+        const float k = massA + massB + inertiaA * rnA * rnA + inertiaB * rnB * rnB;
+        if (k == 0.0f) return;
+
+        const float lambda = -(dvx * nx + dvy * ny + beta * (length - joint.length)) / k;
+        applyImpulseAt(a, -lambda * nx, -lambda * ny, rAX, rAY);
+        applyImpulseAt(b, lambda * nx, lambda * ny, rBX, rBY);
+    }
+}
+
+void PhysicsWorld::solveIsland(const Island& island, float dt) {
+    // Forces and damping
+    for (size_t i = island.bodyBegin; i < island.bodyEnd; ++i) {
+        const BodyId id = islandBodies[i];
+        velocityX[id] += (settings.gravityX + forceX[id] * inverseMass[id]) * dt;
+        velocityY[id] += (settings.gravityY + forceY[id] * inverseMass[id]) * dt;
+        angularVelocity[id] += torque[id] * inverseInertia[id] * dt;
+        velocityX[id] /= 1.0f + dt * linearDamping[id];
+        velocityY[id] /= 1.0f + dt * linearDamping[id];
+        angularVelocity[id] /= 1.0f + dt * angularDamping[id];
+    }
+
+    for (size_t i = island.contactBegin; i < island.contactEnd; ++i) {
+        prepareContact(islandContacts[i], dt);
+    }
+    for (int iteration = 0; iteration < settings.velocityIterations; ++iteration) {
+        for (size_t i = island.jointBegin; i < island.jointEnd; ++i) {
+            solveJoint(joints[islandJoints[i]].desc, dt);
+        }
+        for (size_t i = island.contactBegin; i < island.contactEnd; ++i) {
+            solveContact(islandContacts[i]);
+        }
+    }
+
+    // Integrate positions, then decide whether the whole island can sleep
+    const float linearSq = settings.sleepLinear * settings.sleepLinear;
+    float minSleep = settings.sleepDelay;
+    for (size_t i = island.bodyBegin; i < island.bodyEnd; ++i) {
+        const BodyId id = islandBodies[i];
+        positionX[id] += velocityX[id] * dt;
+        positionY[id] += velocityY[id] * dt;
+        angle[id] += angularVelocity[id] * dt;
+        forceX[id] = forceY[id] = torque[id] = 0.0f;
+
+        const float speedSq = velocityX[id] * velocityX[id] + velocityY[id] * velocityY[id];
+        if (speedSq > linearSq || std::abs(angularVelocity[id]) > settings.sleepAngular) {
+            sleepTime[id] = 0.0f;
+        } else {
+            sleepTime[id] += dt;
+        }
+        minSleep = std::min(minSleep, sleepTime[id]);
+    }
+
+    if (minSleep >= settings.sleepDelay) {
+        for (size_t i = island.bodyBegin; i < island.bodyEnd; ++i) {
+            const BodyId id = islandBodies[i];
+            awake[id] = 0;
+            velocityX[id] = velocityY[id] = angularVelocity[id] = 0.0f;
+        }
+    }
+}
+
+void PhysicsWorld::writeBack(CollisionWorld& collision) {
+    // One pass over the bodies that moved; sleeping bodies keep their last pose
+    for (const BodyId id : islandBodies) {
+        if (TransformComponent* target = transform[id]) {
+            target->position.x = positionX[id];
+            target->position.y = positionY[id];
+            target->rotation = angle[id];
+        }
+        if (collider[id] != invalidCollider) {
+            collision.setPose(collider[id], positionX[id], positionY[id], angle[id]);
+        }
+    }
+}
+
+void PhysicsWorld::step(float dt, CollisionWorld& collision) {
+    if (dt <= 0.0f) return;
+
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    buildIslands(collision);
+
+    // Islands share no dynamic bodies, so each one is solved without locking
+    if (jobs && islands.size() > 1 && islandBodies.size() >= parallelBodies) {
+        jobs->parallelFor(islands.size(), 1, [this, dt](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                solveIsland(islands[i], dt);
+            }
+        });
+    } else {
+        for (const Island& island : islands) {
+            solveIsland(island, dt);
+        }
+    }
+
+    writeBack(collision);
+
+    stats.bodies = 0;
+    for (const uint8_t flag : active) {
+        stats.bodies += flag;
+    }
+    stats.awakeBodies = 0;
+    for (const BodyId id : islandBodies) {
+        stats.awakeBodies += awake[id];
+    }
+    stats.islands = islands.size();
+    stats.contacts = islandContacts.size();
+    stats.stepMillis = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    StepBucket& bucket = buckets[std::min<size_t>(std::bit_width(islands.size()), 32)];
+    bucket.steps++;
+    bucket.totalMillis += stats.stepMillis;
+}
+
+void PhysicsWorld::reportStats(std::ostream& out) const {
+    out << "Physics: " << stats.bodies << " bodies (" << stats.awakeBodies << " awake), " << stats.islands
+        << " islands, " << stats.contacts << " contacts, " << stats.joints << " joints, last step "
+        << stats.stepMillis << " ms" << std::endl;
+
+    for (size_t i = 0; i < std::size(buckets); ++i) {
+        if (buckets[i].steps == 0) continue;
+        const size_t low = i == 0 ? 0 : size_t{1} << (i - 1);
+        const size_t high = i == 0 ? 0 : (size_t{1} << i) - 1;
+        out << "  " << low << "-" << high << " islands: " << buckets[i].steps << " steps, "
+            << buckets[i].totalMillis / static_cast<double>(buckets[i].steps) << " ms avg" << std::endl;
+    }
+}
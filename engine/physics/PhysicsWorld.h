@@ -0,0 +1,201 @@
+#ifndef ENGINE_PHYSICSWORLD_H
+#define ENGINE_PHYSICSWORLD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "collision/CollisionShape.h"
+#include "service/IService.h"
+
+class CollisionWorld;
+class JobSystem;
+class TransformComponent;
+
+using BodyId = uint32_t;
+constexpr BodyId invalidBody = ~0u;
+
+using JointId = uint32_t;
+constexpr JointId invalidJoint = ~0u;
+
+enum class BodyType : uint8_t {
+    Dynamic,    // moved by forces, impulses and contacts
+    Static      // walls and terrain; infinite mass, never moves
+};
+
+struct BodyDesc {
+    BodyType type = BodyType::Dynamic;
+    float x = 0.0f, y = 0.0f;
+    float angle = 0.0f;             // radians, counter-clockwise
+    float mass = 1.0f;
+    float inertia = 0.0f;           // 0 = derived from the collider shape when attached
+    float friction = 0.5f;
+    float restitution = 0.1f;
+    float linearDamping = 0.0f;     // fraction of velocity lost per second (tracks on ground)
+    float angularDamping = 0.0f;
+    bool fixedRotation = false;
+};
+
+enum class JointType : uint8_t {
+    Revolute,   // anchors pinned together, free to rotate (turret on hull)
+    Distance    // anchors kept at a fixed length (track links, tow cables)
+};
+
+// Anchors are in each body's local space
+struct JointDesc {
+    JointType type = JointType::Revolute;
+    BodyId a = invalidBody;
+    BodyId b = invalidBody;
+    float anchorAX = 0.0f, anchorAY = 0.0f;
+    float anchorBX = 0.0f, anchorBY = 0.0f;
+    float length = -1.0f;           // distance joints; negative = the anchors' distance at creation
+};
+
+struct PhysicsSettings {
+    float gravityX = 0.0f;          // top-down arena: no gravity by default
+    float gravityY = 0.0f;
+    int velocityIterations = 8;
+    float baumgarte = 0.2f;         // fraction of penetration / joint error corrected per step
+    float slop = 0.01f;             // penetration left alone, keeps resting contacts stable
+    float restitutionThreshold = 1.0f;  // slower impacts do not bounce
+    float sleepLinear = 0.05f;      // below these speeds for sleepDelay seconds, an island sleeps
+    float sleepAngular = 0.05f;
+    float sleepDelay = 0.5f;
+};
+
+struct PhysicsStats {
+    size_t bodies = 0;
+    size_t awakeBodies = 0;
+    size_t islands = 0;             // awake islands solved this step
+    size_t contacts = 0;
+    size_t joints = 0;
+    double stepMillis = 0.0;
+};
+
+// Fixed-step 2D rigid bodies with a sequential impulse solver
+// Bodies live in flat per-attribute arrays indexed by id. Each step the bodies touching through
+// contacts or joints are grouped into islands (union-find); awake islands are solved independently on
+// the job system, islands at rest go to sleep and are skipped until something touches them. Contacts
+// come from the CollisionWorld, and the results are written back to the bound transforms in one pass.
+class PhysicsWorld : public IService {
+public:
+    explicit PhysicsWorld(JobSystem* jobs = nullptr);
+
+    void setSettings(const PhysicsSettings& value) { settings = value; }
+    const PhysicsSettings& getSettings() const { return settings; }
+
+    BodyId createBody(const BodyDesc& desc);
+    void destroyBody(BodyId id);   // also destroys its joints
+    bool isValid(BodyId id) const { return id < active.size() && active[id]; }
+
+    // Link a body to the transform it drives and the collider whose contacts it responds to
+    // Takes its pose from the transform; a zero inertia is derived from the shape
+    void attach(BodyId id, TransformComponent* transform, ColliderId collider, const CollisionShape& shape);
+
+    JointId createJoint(const JointDesc& desc);
+    void destroyJoint(JointId id);
+
+    // Forces and torques are cleared after each step; anything applied wakes the body
+    void applyForce(BodyId id, float forceX, float forceY);
+    void applyTorque(BodyId id, float value);
+    void applyImpulse(BodyId id, float impulseX, float impulseY);
+    void setVelocity(BodyId id, float velocityX, float velocityY, float angular);
+    void setPose(BodyId id, float x, float y, float angle);
+
+    void getPose(BodyId id, float& outX, float& outY, float& outAngle) const;
+    void getVelocity(BodyId id, float& outX, float& outY, float& outAngular) const;
+
+    void wake(BodyId id);
+    bool isAwake(BodyId id) const { return isValid(id) && awake[id]; }
+
+    // Integrate one fixed step with the contacts of the last CollisionWorld::detect()
+    // Moves the colliders with their bodies, so the next detect sees the new poses
+    void step(float dt, CollisionWorld& collision);
+
+    const PhysicsStats& getStats() const { return stats; }
+
+    // Step times grouped by how many islands the step solved
+    void reportStats(std::ostream& out) const;
+
+    // Driven from the fixed tick (WorldEngine::physicsTick), not the frame
+    void update(int dt) override {}
+
+private:
+    // Either body may be invalidBody: a collider without a body acts as immovable scenery
+    struct ContactConstraint {
+        BodyId a, b;
+        float normalX, normalY;
+        float pointX, pointY;
+        float depth;
+        float friction, restitution;
+        float rAX, rAY, rBX, rBY;
+        float normalMass, tangentMass;
+        float bias;
+        float normalImpulse, tangentImpulse;
+    };
+
+    struct Joint {
+        JointDesc desc;
+        bool active = false;
+    };
+
+    // Contiguous ranges of the island-ordered body, contact and joint lists
+    struct Island {
+        size_t bodyBegin, bodyEnd;
+        size_t contactBegin, contactEnd;
+        size_t jointBegin, jointEnd;
+    };
+
+    struct StepBucket {
+        uint64_t steps = 0;
+        double totalMillis = 0.0;
+    };
+
+    JobSystem* jobs;
+    PhysicsSettings settings;
+
+    // Per body, indexed by id
+    std::vector<float> positionX, positionY, angle;
+    std::vector<float> velocityX, velocityY, angularVelocity;
+    std::vector<float> forceX, forceY, torque;
+    std::vector<float> mass, inverseMass, inverseInertia;
+    std::vector<float> friction, restitution, linearDamping, angularDamping;
+    std::vector<float> sleepTime;
+    std::vector<uint8_t> active, awake, fixedRotation;
+    std::vector<BodyType> type;
+    std::vector<ColliderId> collider;
+    std::vector<TransformComponent*> transform;
+    std::vector<BodyId> freeBodies;
+
+    std::vector<BodyId> colliderToBody;     // indexed by collider id
+    std::vector<Joint> joints;
+    std::vector<JointId> freeJoints;
+
+    // Rebuilt every step
+    std::vector<BodyId> parent;             // union-find forest over body ids
+    std::vector<uint32_t> islandOfRoot;     // union-find root -> awake island index
+    std::vector<BodyId> islandBodies;
+    std::vector<ContactConstraint> islandContacts;
+    std::vector<JointId> islandJoints;
+    std::vector<Island> islands;
+
+    PhysicsStats stats;
+    StepBucket buckets[33];                 // by bit width of the island count
+
+    bool isDynamic(BodyId id) const { return id != invalidBody && type[id] == BodyType::Dynamic; }
+    BodyId find(BodyId id);
+    void unite(BodyId a, BodyId b);
+    void setInertiaFromShape(BodyId id, const CollisionShape& shape);
+
+    void buildIslands(const CollisionWorld& collision);
+    void prepareContact(ContactConstraint& contact, float dt) const;
+    void solveIsland(const Island& island, float dt);
+    void solveContact(ContactConstraint& contact);
+    void solveJoint(const JointDesc& joint, float dt);
+    void applyImpulseAt(BodyId id, float impulseX, float impulseY, float rX, float rY);
+    void relativeVelocity(const ContactConstraint& contact, float& outX, float& outY) const;
+    void writeBack(CollisionWorld& collision);
+};
+
+#endif //ENGINE_PHYSICSWORLD_H
@@ -0,0 +1,25 @@
+#include "RigidBodyComponent.h"
+#include "collision/ColliderComponent.h"
+#include "collision/CollisionWorld.h"
+#include "entity/Entity.h"
+#include "transform/TransformComponent.h"
+
+RigidBodyComponent::RigidBodyComponent(PhysicsWorld& world, const BodyDesc& desc)
+    : world(world), id(world.createBody(desc)) {}
+
+RigidBodyComponent::~RigidBodyComponent() {
+    world.destroyBody(id);
+}
+
+void RigidBodyComponent::update(float dt) {
+    if (attached) return;
+
+    // Owner and sibling components only exist once the entity is assembled
+    auto* transform = getComponent<TransformComponent>("transform");
+    if (auto* collider = getComponent<ColliderComponent>("collider")) {
+        world.attach(id, transform, collider->getId(), collider->getWorld().getShape(collider->getId()));
+    } else {
+        world.attach(id, transform, invalidCollider, {});
+    }
+    attached = true;
+}
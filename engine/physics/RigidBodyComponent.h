@@ -0,0 +1,35 @@
+#ifndef ENGINE_RIGIDBODYCOMPONENT_H
+#define ENGINE_RIGIDBODYCOMPONENT_H
+
+#include "PhysicsWorld.h"
+#include "component/Component.h"
+
+// Gives the entity a body in a PhysicsWorld; the world must outlive the component
+// On its first update the body takes the entity's transform pose and its "collider" component's
+// shape, and from then on physics owns the transform: move the entity through the body, not the transform
+class RigidBodyComponent : public Component {
+public:
+    RigidBodyComponent(PhysicsWorld& world, const BodyDesc& desc = {});
+    ~RigidBodyComponent() override;
+
+    RigidBodyComponent(const RigidBodyComponent&) = delete;
+    RigidBodyComponent& operator=(const RigidBodyComponent&) = delete;
+
+    BodyId getId() const { return id; }
+    PhysicsWorld& getWorld() { return world; }
+
+    void applyForce(float x, float y) { world.applyForce(id, x, y); }
+    void applyTorque(float value) { world.applyTorque(id, value); }
+    void applyImpulse(float x, float y) { world.applyImpulse(id, x, y); }
+    void setVelocity(float x, float y, float angular) { world.setVelocity(id, x, y, angular); }
+
+    // Component interface: binds the body to the entity once it has an owner
+    void update(float dt) override;
+
+private:
+    PhysicsWorld& world;
+    BodyId id;
+    bool attached = false;
+};
+
+#endif //ENGINE_RIGIDBODYCOMPONENT_H
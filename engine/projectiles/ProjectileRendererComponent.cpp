@@ -0,0 +1,80 @@
+#include "ProjectileRendererComponent.h"
+#include "renderer/components/Texture2DComponent.h"
+#include <algorithm>
+
+namespace {
+    uint8_t toByte(float value) {
+        return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+}
+
+ProjectileRendererComponent::ProjectileRendererComponent(const ProjectileSystem& projectiles, float r, float g, float b, float a)
+    : projectiles(projectiles), colour{toByte(r), toByte(g), toByte(b), toByte(a)} {}
+
+void ProjectileRendererComponent::setMesh(const std::string& name) {
+    meshName = name;
+    mesh = MeshHandle{};
+}
+
+ShaderFeature ProjectileRendererComponent::getShaderFeatures() {
+    ShaderFeature features = ShaderFeature::Instanced;
+
+    Texture2DComponent* texComponent = getComponent<Texture2DComponent>("texture");
+    if (texComponent && texComponent->isValid()) {
+        features |= ShaderFeature::Textured;
+        if (texComponent->isAtlasRegion()) {
+            features |= ShaderFeature::Atlas;
+        }
+    }
+    return features;
+}
+
+void ProjectileRendererComponent::prepareFrame() {
+    // Written once here and uploaded by the first view that draws the shells
+    instances.resize(projectiles.size());
+    if (!instances.empty()) {
+        projectiles.writeInstances(instances.data(), colour);
+    }
+    uploadPending = true;
+}
+
+void ProjectileRendererComponent::render(const RenderContext& context, const float* modelMatrix) {
+    if (instances.empty()) return;
+
+    if (!mesh.isValid()) {
+        mesh = context.geometry->find(meshName);
+        if (!mesh.isValid()) return;
+    }
+
+    if (uploadPending) {
+        batch.upload(*context.geometry, instances.data(), instances.size());
+        uploadPending = false;
+    }
+
+    static constexpr float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    Shader* shader = context.shader;
+    shader->use();
+    shader->setMat4("model", identity);
+
+    Texture2DComponent* texComponent = getComponent<Texture2DComponent>("texture");
+    bool hasTexture = texComponent && texComponent->isValid();
+    if (hasTexture) {
+        if (texComponent->isAtlasRegion()) {
+            const UVRect& uv = texComponent->getUVRect();
+            shader->setVec4("uvRect", uv.u, uv.v, uv.width, uv.height);
+        }
+        shader->setInt("textureSampler", 0);
+        texComponent->getTexture()->bind(0);
+    }
+
+    // Shells are opaque, so they depth-test and write like any other quad
+    batch.draw(*context.geometry, mesh);
+    if (context.stats) context.stats->drawCalls++;
+
+    if (hasTexture) {
+        texComponent->getTexture()->unbind();
+    }
+
+    // Restore the shared geometry VAO for the entities drawn after us
+    context.geometry->bind();
+}
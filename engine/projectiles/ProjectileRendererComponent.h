@@ -0,0 +1,40 @@
+#ifndef ENGINE_PROJECTILERENDERERCOMPONENT_H
+#define ENGINE_PROJECTILERENDERERCOMPONENT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ProjectileSystem.h"
+#include "renderer/InstancedQuadBatch.h"
+#include "renderer/components/RendererComponent.h"
+
+// Draws every live shell of a ProjectileSystem with one instanced draw
+// Shells are simulated in world space, so the entity only has to be in the scene; a
+// Texture2DComponent on the entity textures the shells
+class ProjectileRendererComponent : public RendererComponent {
+public:
+    explicit ProjectileRendererComponent(const ProjectileSystem& projectiles, float r = 1.0f, float g = 0.8f, float b = 0.3f, float a = 1.0f);
+
+    // Mesh each shell is drawn with (defaults to the unit quad)
+    void setMesh(const std::string& name);
+
+    // RendererComponent interface
+    void initialize() override { initialized = true; }
+    ShaderFeature getShaderFeatures() override;
+    void prepareFrame() override;
+    void render(const RenderContext& context, const float* modelMatrix) override;
+    void cleanup() override {}
+
+private:
+    const ProjectileSystem& projectiles;
+    uint8_t colour[4];
+
+    std::string meshName = GeometryRegistry::quad;
+    MeshHandle mesh;
+    std::vector<QuadInstance> instances;
+    InstancedQuadBatch batch;
+    bool uploadPending = false;     // instances written this frame, not yet on the GPU
+};
+
+#endif //ENGINE_PROJECTILERENDERERCOMPONENT_H
@@ -0,0 +1,195 @@
+#include "ProjectileSystem.h"
+#include "assets/ContentHash.h"
+#include "collision/CollisionWorld.h"
+#include "jobs/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PROJECTILES_SSE 1
+#endif
+
+namespace {
+    // Below this many shells per chunk, threading costs more than it saves
+    constexpr size_t integrateGrain = 16384;
+    constexpr size_t sweepGrain = 512;
+}
+
+ProjectileSystem::ProjectileSystem(JobSystem* jobs, size_t capacity) : jobs(jobs), capacity(capacity) {
+    const size_t padded = (capacity + 3) & ~static_cast<size_t>(3);
+    for (auto* array : {&positionX, &positionY, &positionZ, &previousX, &previousY, &velocityX, &velocityY,
+                        &age, &lifetime, &size0, &damage}) {
+        array->assign(padded, 0.0f);
+    }
+    mask.assign(padded, 0);
+    ignore.assign(padded, invalidCollider);
+    sweepHits.resize(padded);
+    hits.reserve(256);
+}
+
+bool ProjectileSystem::fire(const ProjectileSpawn& spawn) {
+    if (count >= capacity) {
+        droppedThisTick++;
+        return false;
+    }
+
+    positionX[count] = previousX[count] = spawn.x;
+    positionY[count] = previousY[count] = spawn.y;
+    positionZ[count] = spawn.z;
+    velocityX[count] = spawn.velocityX;
+    velocityY[count] = spawn.velocityY;
+    age[count] = 0.0f;
+    lifetime[count] = spawn.lifetime;
+    size0[count] = spawn.size;
+    damage[count] = spawn.damage;
+    mask[count] = spawn.mask;
+    ignore[count] = spawn.ignore;
+    count++;
+    firedThisTick++;
+    return true;
+}
+
+void ProjectileSystem::integrate(size_t begin, size_t end, float dt) {
+    size_t i = begin;
+#ifdef PROJECTILES_SSE
+    const __m128 dtV = _mm_set1_ps(dt);
+    for (; i + 4 <= end; i += 4) {
+        const __m128 x = _mm_loadu_ps(&positionX[i]);
+        const __m128 y = _mm_loadu_ps(&positionY[i]);
+        _mm_storeu_ps(&previousX[i], x);
+        _mm_storeu_ps(&previousY[i], y);
+        _mm_storeu_ps(&positionX[i], _mm_add_ps(x, _mm_mul_ps(_mm_loadu_ps(&velocityX[i]), dtV)));
+        _mm_storeu_ps(&positionY[i], _mm_add_ps(y, _mm_mul_ps(_mm_loadu_ps(&velocityY[i]), dtV)));
+        _mm_storeu_ps(&age[i], _mm_add_ps(_mm_loadu_ps(&age[i]), dtV));
+    }
+#endif
+
+    for (; i < end; ++i) {
+        previousX[i] = positionX[i];
+        previousY[i] = positionY[i];
+        positionX[i] += velocityX[i] * dt;
+        positionY[i] += velocityY[i] * dt;
+        age[i] += dt;
+    }
+}
+
+void ProjectileSystem::sweep(size_t begin, size_t end, const CollisionWorld& collision) {
+    for (size_t i = begin; i < end; ++i) {
+        sweepHits[i].collider = invalidCollider;
+        collision.raycast(previousX[i], previousY[i], positionX[i], positionY[i], mask[i], sweepHits[i], ignore[i]);
+    }
+}
+
+void ProjectileSystem::step(float dt, CollisionWorld* collision) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    if (jobs && count > integrateGrain) {
+        // Chunks start on multiples of 4 so each SIMD block belongs to one thread
+        const size_t blocks = (count + 3) / 4;
+        jobs->parallelFor(blocks, integrateGrain / 4, [this, dt](size_t begin, size_t end) {
+            integrate(begin * 4, std::min(end * 4, count), dt);
+        });
+    } else {
+        integrate(0, count, dt);
+    }
+
+    // The path covered this tick is a ray from the previous position; the first thing it crosses stops the shell
+    hits.clear();
+    if (collision && count > 0) {
+        collision->prepareQueries();
+        const CollisionWorld& world = *collision;
+        if (jobs && count > sweepGrain) {
+            jobs->parallelFor(count, sweepGrain, [this, &world](size_t begin, size_t end) {
+                sweep(begin, end, world);
+            });
+        } else {
+            sweep(0, count, world);
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            const RaycastHit& hit = sweepHits[i];
+            if (hit.collider == invalidCollider) continue;
+
+            const float t = hit.fraction;
+            hits.push_back({hit.collider,
+                            previousX[i] + (positionX[i] - previousX[i]) * t,
+                            previousY[i] + (positionY[i] - previousY[i]) * t,
+                            hit.normalX, hit.normalY, velocityX[i], velocityY[i], damage[i]});
+            age[i] = lifetime[i];
+        }
+    }
+
+    removeDead();
+
+    stats.live = count;
+    stats.fired = firedThisTick;
+    stats.dropped = droppedThisTick;
+    stats.hits = hits.size();
+    stats.stepMillis = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    firedThisTick = 0;
+    droppedThisTick = 0;
+}
+
+void ProjectileSystem::moveProjectile(size_t from, size_t to) {
+    positionX[to] = positionX[from];
+    positionY[to] = positionY[from];
+    positionZ[to] = positionZ[from];
+    previousX[to] = previousX[from];
+    previousY[to] = previousY[from];
+    velocityX[to] = velocityX[from];
+    velocityY[to] = velocityY[from];
+    age[to] = age[from];
+    lifetime[to] = lifetime[from];
+    size0[to] = size0[from];
+    damage[to] = damage[from];
+    mask[to] = mask[from];
+    ignore[to] = ignore[from];
+}
+
+void ProjectileSystem::removeDead() {
+    size_t i = 0;
+    while (i < count) {
+#ifdef PROJECTILES_SSE
+        // Skip whole blocks of four live shells with one compare
+        if (i + 4 <= count) {
+            const __m128 dead = _mm_cmpge_ps(_mm_loadu_ps(&age[i]), _mm_loadu_ps(&lifetime[i]));
+            if (_mm_movemask_ps(dead) == 0) {
+                i += 4;
+                continue;
+            }
+        }
+#endif
+        if (age[i] >= lifetime[i]) {
+            // The swapped-in shell is checked on the next iteration
+            count--;
+            moveProjectile(count, i);
+        } else {
+            i++;
+        }
+    }
+}
+
+void ProjectileSystem::writeInstances(QuadInstance* out, const uint8_t colour[4]) const {
+    for (size_t i = 0; i < count; ++i) {
+        QuadInstance& instance = out[i];
+        instance.x = positionX[i];
+        instance.y = positionY[i];
+        instance.z = positionZ[i];
+        instance.size = size0[i];
+        for (int c = 0; c < 4; ++c) {
+            instance.colour[c] = colour[c];
+        }
+    }
+}
+
+uint64_t ProjectileSystem::hashState(uint64_t hash) const {
+    hash = hashBytes(positionX.data(), count * sizeof(float), hash);
+    return hashBytes(positionY.data(), count * sizeof(float), hash);
+}
+
+void ProjectileSystem::reportStats(std::ostream& out) const {
+    out << "Projectiles: " << stats.live << "/" << capacity << " live, " << stats.fired << " fired, "
+        << stats.hits << " hits, " << stats.dropped << " dropped, " << stats.stepMillis << " ms" << std::endl;
+}
@@ -0,0 +1,102 @@
+#ifndef ENGINE_PROJECTILESYSTEM_H
+#define ENGINE_PROJECTILESYSTEM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "collision/CollisionShape.h"
+#include "renderer/QuadInstance.h"
+#include "service/IService.h"
+
+class CollisionWorld;
+class JobSystem;
+
+struct ProjectileSpawn {
+    float x = 0.0f, y = 0.0f, z = 0.0f;
+    float velocityX = 0.0f, velocityY = 0.0f;
+    float lifetime = 2.0f;
+    float size = 0.2f;                      // drawn quad size
+    float damage = 1.0f;
+    uint32_t mask = ~0u;                    // collider layers it hits
+    ColliderId ignore = invalidCollider;    // the shooter's own hull
+};
+
+// A shell stopped by a collider this tick
+struct ProjectileHit {
+    ColliderId collider;
+    float x, y;                 // impact point
+    float normalX, normalY;     // surface normal, facing the shell
+    float velocityX, velocityY;
+    float damage;
+};
+
+struct ProjectileStats {
+    size_t live = 0;
+    size_t fired = 0;           // this tick
+    size_t dropped = 0;         // this tick, pool full
+    size_t hits = 0;            // this tick
+    double stepMillis = 0.0;
+};
+
+// Fixed-capacity shell pool in structure-of-arrays layout, stepped once per simulation tick
+// Positions integrate four shells per SSE instruction; each shell's path since the last tick is then
+// swept against the CollisionWorld as a ray, so fast shells cannot tunnel through thin walls. Shells
+// that hit or expire are swap-removed. Touches no GL state; ProjectileRendererComponent draws the pool
+class ProjectileSystem : public IService {
+public:
+    explicit ProjectileSystem(JobSystem* jobs = nullptr, size_t capacity = 8192);
+
+    // False when the pool is full
+    bool fire(const ProjectileSpawn& spawn);
+
+    // Move every shell and sweep its path; hits replace the previous tick's
+    void step(float dt, CollisionWorld* collision);
+
+    const std::vector<ProjectileHit>& getHits() const { return hits; }
+
+    // Render data for [0, size()), one instance per shell
+    void writeInstances(QuadInstance* out, const uint8_t colour[4]) const;
+
+    void clear() { count = 0; }
+    size_t size() const { return count; }
+    size_t getCapacity() const { return capacity; }
+
+    // Folds every shell's position into a state hash (record/replay checks)
+    uint64_t hashState(uint64_t hash) const;
+
+    const ProjectileStats& getStats() const { return stats; }
+    void reportStats(std::ostream& out) const;
+
+    // Driven from the fixed tick (WorldEngine::physicsTick), not the frame
+    void update(int dt) override {}
+
+private:
+    JobSystem* jobs;
+    size_t capacity;
+    size_t count = 0;
+
+    // Rounded up to a multiple of 4 so the SIMD kernel never needs a bounds check on loads
+    std::vector<float> positionX, positionY, positionZ;
+    std::vector<float> previousX, previousY;
+    std::vector<float> velocityX, velocityY;
+    std::vector<float> age, lifetime, size0, damage;
+    std::vector<uint32_t> mask;
+    std::vector<ColliderId> ignore;
+
+    // Written per shell by the sweep, so workers never share an output
+    std::vector<RaycastHit> sweepHits;
+
+    std::vector<ProjectileHit> hits;
+    ProjectileStats stats;
+    size_t firedThisTick = 0;
+    size_t droppedThisTick = 0;
+
+    void integrate(size_t begin, size_t end, float dt);
+    void sweep(size_t begin, size_t end, const CollisionWorld& collision);
+    void moveProjectile(size_t from, size_t to);
+    void removeDead();
+};
+
+#endif //ENGINE_PROJECTILESYSTEM_H
@@ -0,0 +1,272 @@
+#include "RaycastService.h"
+#include "assets/ContentHash.h"
+#include "collision/CollisionWorld.h"
+#include "jobs/JobSystem.h"
+#include "renderer/components/TilemapComponent.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace {
+    // Rays per job; a short ray is well under a microsecond, so small batches stay on the caller
+    constexpr size_t batchGrain = 256;
+    // Past this many entries a cache starts over rather than growing without bound
+    constexpr size_t maxCached = 1 << 16;
+
+    uint64_t queryKey(const RayQuery& query) {
+        uint64_t hash = hashBytes(&query.x0, sizeof(float) * 4);
+        hash = hashBytes(&query.mask, sizeof(query.mask), hash);
+        hash = hashBytes(&query.ignore, sizeof(query.ignore), hash);
+        return hashBytes(&query.target, sizeof(query.target), hash);
+    }
+
+    bool sameQuery(const RayQuery& a, const RayQuery& b) {
+        return a.x0 == b.x0 && a.y0 == b.y0 && a.x1 == b.x1 && a.y1 == b.y1 &&
+               a.mask == b.mask && a.ignore == b.ignore && a.target == b.target;
+    }
+
+    bool isVisible(const RayQuery& query, const RayHit& hit) {
+        // The closest hit being the target means nothing stands in front of it
+        return hit.type == RayHitType::None ||
+               (hit.type == RayHitType::Collider && query.target != invalidCollider && hit.collider == query.target);
+    }
+}
+
+RaycastService::RaycastService(JobSystem* jobs) : jobs(jobs) {}
+
+void RaycastService::setCollisionWorld(CollisionWorld* collision) {
+    this->collision = collision;
+    fullCache.clear();
+}
+
+void RaycastService::setTilemap(const TilemapComponent* tilemap, float originX, float originY) {
+    this->tilemap = tilemap;
+    this->originX = originX;
+    this->originY = originY;
+    gridDirty = true;
+}
+
+void RaycastService::setSolid(uint16_t type, bool solid) {
+    if (solidTypes.size() <= type) {
+        solidTypes.resize(static_cast<size_t>(type) + 1, 0);
+    }
+    if (solidTypes[type] == (solid ? 1 : 0)) return;
+    solidTypes[type] = solid ? 1 : 0;
+    gridDirty = true;
+}
+
+void RaycastService::rebuildGrid() {
+    gridDirty = false;
+    gridEpoch++;
+    stats.gridRebuilds++;
+
+    if (!tilemap) {
+        width = height = 0;
+        solid.clear();
+        return;
+    }
+
+    width = tilemap->getWidth();
+    height = tilemap->getHeight();
+    tileSize = tilemap->getTileSize();
+    gridVersion = tilemap->getVersion();
+
+    const uint16_t* tiles = tilemap->getTiles();
+    solid.resize(static_cast<size_t>(width) * height);
+    for (size_t i = 0; i < solid.size(); ++i) {
+        solid[i] = tiles[i] < solidTypes.size() ? solidTypes[tiles[i]] : 0;
+    }
+}
+
+void RaycastService::validateCache() {
+    if (cacheGridEpoch != gridEpoch) {
+        tileCache.clear();
+        fullCache.clear();
+        cacheGridEpoch = gridEpoch;
+    }
+    if (collision && collision->getVersion() != cacheColliderVersion) {
+        fullCache.clear();
+        cacheColliderVersion = collision->getVersion();
+    }
+}
+
+void RaycastService::prepare() {
+    if (gridDirty || (tilemap && tilemap->getVersion() != gridVersion)) {
+        rebuildGrid();
+    }
+    if (collision) {
+        collision->prepareQueries();
+    }
+    validateCache();
+}
+
+float RaycastService::castTiles(const RayQuery& query, RayHit& out) const {
+    if (solid.empty()) return 1.0f;
+
+    // Work in tile units: cell (x, y) covers [x, x + 1] by [y, y + 1]
+    const float inverseSize = 1.0f / tileSize;
+    const float gx = (query.x0 - originX) * inverseSize;
+    const float gy = (query.y0 - originY) * inverseSize;
+    const float dx = (query.x1 - query.x0) * inverseSize;
+    const float dy = (query.y1 - query.y0) * inverseSize;
+
+    // Clip the segment to the map; enterAxis remembers which side it came in through
+    float tEnter = 0.0f;
+    float tExit = 1.0f;
+    int enterAxis = -1;
+    const float start[2] = {gx, gy};
+    const float delta[2] = {dx, dy};
+    const float limit[2] = {static_cast<float>(width), static_cast<float>(height)};
+    for (int axis = 0; axis < 2; ++axis) {
+        if (delta[axis] == 0.0f) {
+            if (start[axis] < 0.0f || start[axis] >= limit[axis]) return 1.0f;
+            continue;
+        }
+        float t0 = -start[axis] / delta[axis];
+        float t1 = (limit[axis] - start[axis]) / delta[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        if (t0 > tEnter) {
+            tEnter = t0;
+            enterAxis = axis;
+        }
+        tExit = std::min(tExit, t1);
+    }
+    if (tEnter > tExit) return 1.0f;
+
+    int cellX = std::clamp(static_cast<int>(std::floor(gx + dx * tEnter)), 0, width - 1);
+    int cellY = std::clamp(static_cast<int>(std::floor(gy + dy * tEnter)), 0, height - 1);
+
+    // Amanatides-Woo: step into whichever neighbour the segment reaches first
+    constexpr float never = std::numeric_limits<float>::infinity();
+    const int stepX = dx > 0.0f ? 1 : (dx < 0.0f ? -1 : 0);
+    const int stepY = dy > 0.0f ? 1 : (dy < 0.0f ? -1 : 0);
+    const float tDeltaX = stepX != 0 ? std::abs(1.0f / dx) : never;
+    const float tDeltaY = stepY != 0 ? std::abs(1.0f / dy) : never;
+    float tMaxX = stepX > 0 ? (static_cast<float>(cellX + 1) - gx) / dx : (stepX < 0 ? (static_cast<float>(cellX) - gx) / dx : never);
+    float tMaxY = stepY > 0 ? (static_cast<float>(cellY + 1) - gy) / dy : (stepY < 0 ? (static_cast<float>(cellY) - gy) / dy : never);
+
+    float t = tEnter;
+    int axis = enterAxis;
+    while (true) {
+        if (solid[static_cast<size_t>(cellY) * width + cellX]) {
+            out.type = RayHitType::Tile;
+            out.fraction = t;
+            out.tileX = cellX;
+            out.tileY = cellY;
+            out.normalX = axis == 0 ? static_cast<float>(-stepX) : 0.0f;
+            out.normalY = axis == 1 ? static_cast<float>(-stepY) : 0.0f;
+            return t;
+        }
+
+        if (tMaxX < tMaxY) {
+            t = tMaxX;
+            if (t > tExit) break;
+            cellX += stepX;
+            tMaxX += tDeltaX;
+            axis = 0;
+        } else {
+            t = tMaxY;
+            if (t > tExit) break;
+            cellY += stepY;
+            tMaxY += tDeltaY;
+            axis = 1;
+        }
+        if (cellX < 0 || cellY < 0 || cellX >= width || cellY >= height) break;
+    }
+    return 1.0f;
+}
+
+bool RaycastService::raycast(const RayQuery& query, RayHit& out) const {
+    out = {};
+    const float limit = castTiles(query, out);
+
+    // Only colliders in front of the first wall matter
+    if (collision && query.mask != 0 && limit > 0.0f) {
+        const float endX = query.x0 + (query.x1 - query.x0) * limit;
+        const float endY = query.y0 + (query.y1 - query.y0) * limit;
+        RaycastHit hit;
+        if (collision->raycast(query.x0, query.y0, endX, endY, query.mask, hit, query.ignore)) {
+            out.type = RayHitType::Collider;
+            out.fraction = hit.fraction * limit;
+            out.normalX = hit.normalX;
+            out.normalY = hit.normalY;
+            out.tileX = out.tileY = -1;
+            out.collider = hit.collider;
+        }
+    }
+
+    out.x = query.x0 + (query.x1 - query.x0) * out.fraction;
+    out.y = query.y0 + (query.y1 - query.y0) * out.fraction;
+    return out.type != RayHitType::None;
+}
+
+bool RaycastService::lineOfSight(const RayQuery& query) const {
+    RayHit hit;
+    raycast(query, hit);
+    return isVisible(query, hit);
+}
+
+void RaycastService::raycastBatch(const RayQuery* queries, size_t count, RayHit* out) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+
+    prepare();
+
+    misses.clear();
+    for (size_t i = 0; i < count; ++i) {
+        const auto& cache = queries[i].mask != 0 ? fullCache : tileCache;
+        auto it = cache.find(queryKey(queries[i]));
+        if (it != cache.end() && sameQuery(it->second.query, queries[i])) {
+            out[i] = it->second.hit;
+            stats.cacheHits++;
+        } else {
+            misses.push_back(i);
+        }
+    }
+
+    // Each miss writes its own slot, so workers share nothing but the read-only world
+    if (jobs && misses.size() > batchGrain) {
+        jobs->parallelFor(misses.size(), batchGrain, [this, queries, out](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) {
+                raycast(queries[misses[k]], out[misses[k]]);
+            }
+        });
+    } else {
+        for (const size_t i : misses) {
+            raycast(queries[i], out[i]);
+        }
+    }
+
+    for (const size_t i : misses) {
+        auto& cache = queries[i].mask != 0 ? fullCache : tileCache;
+        if (cache.size() >= maxCached) cache.clear();
+        cache[queryKey(queries[i])] = {queries[i], out[i]};
+    }
+
+    stats.batches++;
+    stats.queries += count;
+    stats.cached = tileCache.size() + fullCache.size();
+    stats.batchMillis += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void RaycastService::lineOfSightBatch(const RayQuery* queries, size_t count, uint8_t* visible) {
+    scratch.resize(count);
+    raycastBatch(queries, count, scratch.data());
+    for (size_t i = 0; i < count; ++i) {
+        visible[i] = isVisible(queries[i], scratch[i]) ? 1 : 0;
+    }
+}
+
+void RaycastService::clearCache() {
+    tileCache.clear();
+    fullCache.clear();
+    stats.cached = 0;
+}
+
+void RaycastService::reportStats(std::ostream& out) const {
+    const double hitRate = stats.queries > 0 ? 100.0 * static_cast<double>(stats.cacheHits) / static_cast<double>(stats.queries) : 0.0;
+    out << "Raycasts: " << stats.queries << " queries in " << stats.batches << " batches, " << hitRate
+        << "% cached (" << stats.cached << " held), " << stats.gridRebuilds << " grid rebuilds, "
+        << stats.batchMillis << " ms" << std::endl;
+}
@@ -0,0 +1,127 @@
+#ifndef ENGINE_RAYCASTSERVICE_H
+#define ENGINE_RAYCASTSERVICE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+#include "collision/CollisionShape.h"
+#include "service/IService.h"
+
+class CollisionWorld;
+class JobSystem;
+class TilemapComponent;
+
+// A segment from (x0, y0) to (x1, y1) in world units
+struct RayQuery {
+    float x0 = 0.0f, y0 = 0.0f;
+    float x1 = 0.0f, y1 = 0.0f;
+    uint32_t mask = ~0u;                    // collider layers that block; 0 = tiles only
+    ColliderId ignore = invalidCollider;    // usually the looker's own hull
+    ColliderId target = invalidCollider;    // line of sight: reaching this collider counts as seeing it
+};
+
+enum class RayHitType : uint8_t {
+    None,
+    Tile,
+    Collider
+};
+
+struct RayHit {
+    RayHitType type = RayHitType::None;
+    float fraction = 1.0f;          // along the segment, 0 = start, 1 = end
+    float x = 0.0f, y = 0.0f;       // hit point, or the segment end
+    float normalX = 0.0f;           // surface normal facing the ray; zero when starting inside a wall
+    float normalY = 0.0f;
+    int tileX = -1, tileY = -1;     // tile hits
+    ColliderId collider = invalidCollider;
+};
+
+struct RaycastStats {
+    size_t batches = 0;
+    size_t queries = 0;             // through the batch calls
+    size_t cacheHits = 0;
+    size_t cached = 0;              // entries held now
+    size_t gridRebuilds = 0;
+    double batchMillis = 0.0;
+};
+
+// Ray and line-of-sight queries against the arena's tile grid and the dynamic colliders
+// Tiles of solid types block rays; the grid is walked cell by cell (DDA), so a query costs the tiles
+// it crosses rather than the size of the map. The nearest blocking tile shortens the segment before
+// the CollisionWorld is searched. Single queries are read-only and may run on any thread; batches
+// fan out over the job system and remember their answers until a tile is edited or a collider moves
+class RaycastService : public IService {
+public:
+    explicit RaycastService(JobSystem* jobs = nullptr);
+
+    void setCollisionWorld(CollisionWorld* collision);
+
+    // Tile (x, y) covers origin + [x, x + 1] * tileSize by [y, y + 1] * tileSize in world space
+    void setTilemap(const TilemapComponent* tilemap, float originX, float originY);
+    void setSolid(uint16_t type, bool solid = true);
+
+    // Bring the grid and the collider sweep order up to date; call before casting from threads
+    // The batch calls do this themselves
+    void prepare();
+
+    // Closest tile or collider crossed by the query; false when the segment is clear
+    bool raycast(const RayQuery& query, RayHit& out) const;
+
+    // True when nothing blocks the segment before its end (or before the query's target)
+    bool lineOfSight(const RayQuery& query) const;
+
+    // out[i] / visible[i] answers queries[i]; repeated queries are served from the cache
+    void raycastBatch(const RayQuery* queries, size_t count, RayHit* out);
+    void lineOfSightBatch(const RayQuery* queries, size_t count, uint8_t* visible);
+
+    void clearCache();
+
+    const RaycastStats& getStats() const { return stats; }
+    void reportStats(std::ostream& out) const;
+
+    // Prepared from the fixed tick (WorldEngine::physicsTick), not the frame
+    void update(int dt) override {}
+
+private:
+    struct CacheEntry {
+        RayQuery query;
+        RayHit hit;
+    };
+
+    JobSystem* jobs;
+    CollisionWorld* collision = nullptr;
+
+    const TilemapComponent* tilemap = nullptr;
+    float originX = 0.0f;
+    float originY = 0.0f;
+    float tileSize = 1.0f;
+    int width = 0;
+    int height = 0;
+
+    // One byte per tile, 1 = blocks rays; rebuilt when the tilemap or the solid set changes
+    std::vector<uint8_t> solid;
+    std::vector<uint8_t> solidTypes;
+    unsigned int gridVersion = 0;       // tilemap version the grid was built from
+    bool gridDirty = true;
+
+    // Keyed by a hash of the query; tile-only queries outlive collider movement
+    std::unordered_map<uint64_t, CacheEntry> tileCache;
+    std::unordered_map<uint64_t, CacheEntry> fullCache;
+    unsigned int cacheGridEpoch = 0;
+    unsigned int gridEpoch = 0;         // bumped on every grid rebuild
+    unsigned int cacheColliderVersion = 0;
+
+    std::vector<size_t> misses;
+    std::vector<RayHit> scratch;
+
+    RaycastStats stats;
+
+    void rebuildGrid();
+    void validateCache();
+    float castTiles(const RayQuery& query, RayHit& out) const;
+};
+
+#endif //ENGINE_RAYCASTSERVICE_H
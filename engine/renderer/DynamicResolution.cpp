@@ -0,0 +1,142 @@
+#include "DynamicResolution.h"
+#include <algorithm>
+#include <cmath>
+
+DynamicResolution::DynamicResolution(const DynamicResolutionSettings& settings) : settings(settings) {
+    scale = settings.maxScale;
+}
+
+DynamicResolution::~DynamicResolution() {
+    if (queries[0] != 0) {
+        glDeleteQueries(queryCount, queries);
+    }
+}
+
+void DynamicResolution::setSettings(const DynamicResolutionSettings& value) {
+    const bool resize = value.maxScale != settings.maxScale;
+    settings = value;
+    if (resize) {
+        target.reset();
+    }
+    applyScale(scale);
+}
+
+void DynamicResolution::setScale(float value) {
+    applyScale(value);
+    overFrames = 0;
+    underFrames = 0;
+    cooldown = queryCount;
+}
+
+void DynamicResolution::applyScale(float value) {
+    const float clamped = std::clamp(value, settings.minScale, settings.maxScale);
+    if (clamped != scale) {
+        scale = clamped;
+        changes++;
+    }
+}
+
+void DynamicResolution::ensureTarget() {
+    const int width = std::max(1, static_cast<int>(std::ceil(framebufferWidth * settings.maxScale)));
+    const int height = std::max(1, static_cast<int>(std::ceil(framebufferHeight * settings.maxScale)));
+    if (target && target->getWidth() == width && target->getHeight() == height) return;
+
+    target = RenderTarget::create(width, height, true);
+}
+
+void DynamicResolution::collectQueries() {
+    // Newest finished result wins; anything still in flight is left for a later frame
+    for (int i = 1; i <= queryCount; ++i) {
+        const int slot = (queryIndex + i) % queryCount;
+        if (!queryPending[slot]) continue;
+
+        GLint available = 0;
+        glGetQueryObjectiv(queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) continue;
+
+        GLuint64 nanoseconds = 0;
+        glGetQueryObjectui64v(queries[slot], GL_QUERY_RESULT, &nanoseconds);
+        gpuMillis = static_cast<float>(nanoseconds) / 1000000.0f;
+        queryPending[slot] = false;
+    }
+}
+
+void DynamicResolution::begin(int width, int height, int& outWidth, int& outHeight) {
+    framebufferWidth = width;
+    framebufferHeight = height;
+    outWidth = width;
+    outHeight = height;
+    active = false;
+    if (!settings.enabled || width <= 0 || height <= 0) return;
+
+    ensureTarget();
+    if (!target) return;
+
+    if (queries[0] == 0) {
+        glGenQueries(queryCount, queries);
+    }
+    collectQueries();
+
+    sceneWidth = std::max(1, static_cast<int>(static_cast<float>(width) * scale));
+    sceneHeight = std::max(1, static_cast<int>(static_cast<float>(height) * scale));
+    outWidth = sceneWidth;
+    outHeight = sceneHeight;
+
+    target->bind();
+    glViewport(0, 0, sceneWidth, sceneHeight);
+
+    // A slot whose result never arrived is reused only once it has; skip timing this frame otherwise
+    timing = !queryPending[queryIndex];
+    if (timing) {
+        glBeginQuery(GL_TIME_ELAPSED, queries[queryIndex]);
+    }
+    active = true;
+}
+
+void DynamicResolution::end() {
+    if (!active) return;
+
+    if (timing) {
+        glEndQuery(GL_TIME_ELAPSED);
+        queryPending[queryIndex] = true;
+        queryIndex = (queryIndex + 1) % queryCount;
+        timing = false;
+    }
+
+    // Upscale pass: bilinear stretch of the rendered corner over the whole window
+    target->blitRegionToScreen(sceneWidth, sceneHeight, 0, 0, framebufferWidth, framebufferHeight);
+    RenderTarget::unbind(framebufferWidth, framebufferHeight);
+    active = false;
+}
+
+void DynamicResolution::endFrame(float cpuMillis) {
+    if (!settings.enabled) return;
+
+    const float cost = std::max(cpuMillis, gpuMillis);
+    smoothedMillis = smoothedMillis <= 0.0f ? cost : smoothedMillis + (cost - smoothedMillis) * 0.2f;
+
+    if (cooldown > 0) {
+        // Restart the average from the first frame measured entirely at the new scale
+        if (--cooldown == 0) {
+            smoothedMillis = cost;
+        }
+        return;
+    }
+
+    overFrames = smoothedMillis > settings.targetFrameMillis * settings.overBudget ? overFrames + 1 : 0;
+    underFrames = smoothedMillis < settings.targetFrameMillis * settings.underBudget ? underFrames + 1 : 0;
+
+    if (overFrames >= settings.framesToDecrease) {
+        // Cost is roughly proportional to pixel count, so shrink each axis by the square root
+        const float ratio = std::sqrt(settings.targetFrameMillis / smoothedMillis);
+        applyScale(scale * std::max(ratio, 0.75f));
+    } else if (underFrames >= settings.framesToIncrease) {
+        applyScale(scale + settings.increaseStep);
+    } else {
+        return;
+    }
+
+    overFrames = 0;
+    underFrames = 0;
+    cooldown = queryCount;
+}
@@ -0,0 +1,83 @@
+#ifndef ENGINE_DYNAMICRESOLUTION_H
+#define ENGINE_DYNAMICRESOLUTION_H
+
+#include <memory>
+#include <glad/glad.h>
+
+#include "texture/RenderTarget.h"
+
+// Runtime knobs; change them at any time through setSettings
+struct DynamicResolutionSettings {
+    bool enabled = true;
+    float targetFrameMillis = 16.6f;
+    float minScale = 0.5f;          // per axis, of the window's framebuffer size
+    float maxScale = 1.0f;
+
+    // Hysteresis: drop quickly when over budget, climb back only after a sustained margin
+    float overBudget = 1.05f;       // frame cost above target * overBudget counts as over
+    float underBudget = 0.8f;       // frame cost below target * underBudget counts as under
+    int framesToDecrease = 4;
+    int framesToIncrease = 90;
+    float increaseStep = 0.05f;
+};
+
+// Renders the scene into an offscreen target whose size follows the measured frame cost, then
+// upscales it to the window. Frame cost is the larger of the CPU time passed to endFrame and the
+// GPU time of the scene pass, read back from timer queries a few frames late so nothing stalls.
+// The target is allocated at maxScale once; lower scales render into its bottom-left corner
+class DynamicResolution {
+public:
+    explicit DynamicResolution(const DynamicResolutionSettings& settings = {});
+    ~DynamicResolution();
+
+    DynamicResolution(const DynamicResolution&) = delete;
+    DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+    // Bind the scaled target for the scene pass; returns the size the scene should render at
+    void begin(int framebufferWidth, int framebufferHeight, int& sceneWidth, int& sceneHeight);
+
+    // Upscale the scene onto the window and leave the window framebuffer bound
+    void end();
+
+    // Feed the CPU cost of the frame (update + render, excluding the swap) and adapt the scale
+    void endFrame(float cpuMillis);
+
+    void setSettings(const DynamicResolutionSettings& value);
+    const DynamicResolutionSettings& getSettings() const { return settings; }
+
+    float getScale() const { return scale; }
+    void setScale(float value);                     // until the controller moves it again
+    float getGpuMillis() const { return gpuMillis; }
+    float getFrameCostMillis() const { return smoothedMillis; }
+    int getChanges() const { return changes; }
+
+private:
+    static constexpr int queryCount = 4;            // frames a timer result may lag behind
+
+    DynamicResolutionSettings settings;
+    std::unique_ptr<RenderTarget> target;
+    int framebufferWidth = 0;
+    int framebufferHeight = 0;
+    int sceneWidth = 0;
+    int sceneHeight = 0;
+    bool active = false;                            // between begin and end with the target bound
+
+    GLuint queries[queryCount] = {};
+    bool queryPending[queryCount] = {};
+    int queryIndex = 0;
+    bool timing = false;
+
+    float scale = 1.0f;
+    float gpuMillis = 0.0f;
+    float smoothedMillis = 0.0f;
+    int overFrames = 0;
+    int underFrames = 0;
+    int cooldown = 0;                               // frames to ignore while old-scale timings drain
+    int changes = 0;
+
+    void collectQueries();
+    void ensureTarget();
+    void applyScale(float value);
+};
+
+#endif //ENGINE_DYNAMICRESOLUTION_H
@@ -0,0 +1,52 @@
+#include "Frustum.h"
+#include <cmath>
+
+Frustum Frustum::fromMatrix(const float* m) {
+    // Gribb/Hartmann: each plane is the w row plus or minus the x, y or z row
+    Frustum frustum;
+    for (int i = 0; i < 3; ++i) {
+        for (int c = 0; c < 4; ++c) {
+            const float w = m[c * 4 + 3];
+            const float axis = m[c * 4 + i];
+            frustum.planes[i * 2][c] = w + axis;
+            frustum.planes[i * 2 + 1][c] = w - axis;
+        }
+    }
+
+    for (auto& plane : frustum.planes) {
+        const float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        if (length > 0.0f) {
+            for (float& value : plane) {
+                value /= length;
+            }
+        }
+    }
+    return frustum;
+}
+
+Frustum Frustum::fromMatrices(const float* viewProjection, const float* model) {
+    float clip[16];
+    for (int col = 0; col < 4; ++col) {
+        for (int row = 0; row < 4; ++row) {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; ++k) {
+                sum += viewProjection[k * 4 + row] * model[col * 4 + k];
+            }
+            clip[col * 4 + row] = sum;
+        }
+    }
+    return fromMatrix(clip);
+}
+
+bool Frustum::intersectsBox(float minX, float minY, float minZ, float maxX, float maxY, float maxZ) const {
+    for (const auto& plane : planes) {
+        // Corner furthest along the plane normal; if even that is outside, the whole box is
+        const float x = plane[0] >= 0.0f ? maxX : minX;
+        const float y = plane[1] >= 0.0f ? maxY : minY;
+        const float z = plane[2] >= 0.0f ? maxZ : minZ;
+        if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,21 @@
+#ifndef ENGINE_FRUSTUM_H
+#define ENGINE_FRUSTUM_H
+
+// View frustum as six planes (ax + by + cz + d >= 0 inside), extracted from a clip matrix
+// Built from viewProjection * model, boxes can be tested directly in the model's local space
+class Frustum {
+public:
+    Frustum() = default;
+
+    // Column-major clip matrix, as used everywhere in the renderer
+    static Frustum fromMatrix(const float* clip);
+    static Frustum fromMatrices(const float* viewProjection, const float* model);
+
+    // Conservative: may accept boxes just outside a corner, never rejects visible ones
+    bool intersectsBox(float minX, float minY, float minZ, float maxX, float maxY, float maxZ) const;
+
+private:
+    float planes[6][4] = {};
+};
+
+#endif //ENGINE_FRUSTUM_H
@@ -0,0 +1,80 @@
+#include "InstancedQuadBatch.h"
+#include <algorithm>
+
+InstancedQuadBatch::~InstancedQuadBatch() {
+    if (VAO != 0) {
+        glDeleteVertexArrays(1, &VAO);
+    }
+    if (instanceBuffer != 0) {
+        glDeleteBuffers(1, &instanceBuffer);
+    }
+}
+
+void InstancedQuadBatch::setup(GeometryRegistry& geometry) {
+    // Make sure the registry's buffers exist and hold every mesh
+    geometry.bind();
+
+    if (VAO == 0) {
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &instanceBuffer);
+    }
+
+    glBindVertexArray(VAO);
+
+    // Mesh attributes, same layout as the registry's own VAO
+    glBindBuffer(GL_ARRAY_BUFFER, geometry.getVertexBuffer());
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(GeometryVertex), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(GeometryVertex), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, geometry.getIndexBuffer());
+
+    // Instance attributes: position + size (location = 2), colour (location = 6)
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(QuadInstance), (void*)0);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glVertexAttribPointer(6, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(QuadInstance), (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(6);
+    glVertexAttribDivisor(6, 1);
+
+    boundVertexBuffer = geometry.getVertexBuffer();
+}
+
+void InstancedQuadBatch::bind(GeometryRegistry& geometry) {
+    if (VAO == 0 || boundVertexBuffer != geometry.getVertexBuffer()) {
+        setup(geometry);
+    } else {
+        glBindVertexArray(VAO);
+    }
+}
+
+void InstancedQuadBatch::upload(GeometryRegistry& geometry, const QuadInstance* instances, size_t count) {
+    uploaded = count;
+    if (count == 0) return;
+
+    bind(geometry);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    if (count > capacity) {
+        capacity = std::max(count, capacity * 2);
+    }
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity * sizeof(QuadInstance)), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(count * sizeof(QuadInstance)), instances);
+}
+
+void InstancedQuadBatch::draw(GeometryRegistry& geometry, MeshHandle mesh) {
+    if (uploaded == 0 || !mesh.isValid()) return;
+
+    bind(geometry);
+    const MeshRange& range = geometry.getRange(mesh);
+    glDrawElementsInstancedBaseVertex(GL_TRIANGLES, range.indexCount, GL_UNSIGNED_INT,
+                                      (void*)(range.firstIndex * sizeof(uint32_t)),
+                                      static_cast<GLsizei>(uploaded), range.baseVertex);
+}
+
+void InstancedQuadBatch::draw(GeometryRegistry& geometry, MeshHandle mesh, const QuadInstance* instances, size_t count) {
+    if (count == 0 || !mesh.isValid()) return;
+
+    upload(geometry, instances, count);
+    draw(geometry, mesh);
+}
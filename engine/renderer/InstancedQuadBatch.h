@@ -0,0 +1,42 @@
+#ifndef ENGINE_INSTANCEDQUADBATCH_H
+#define ENGINE_INSTANCEDQUADBATCH_H
+
+#include <cstddef>
+#include <glad/glad.h>
+
+#include "QuadInstance.h"
+#include "geometry/GeometryRegistry.h"
+
+// Draws a registry mesh once per QuadInstance with a single instanced call
+// Owns a VAO over the registry's shared buffers plus a streamed instance buffer
+// that is orphaned every upload, so the driver never stalls on last frame's data
+class InstancedQuadBatch {
+public:
+    InstancedQuadBatch() = default;
+    ~InstancedQuadBatch();
+
+    InstancedQuadBatch(const InstancedQuadBatch&) = delete;
+    InstancedQuadBatch& operator=(const InstancedQuadBatch&) = delete;
+
+    // Needs the INSTANCED shader variant bound; leaves the batch's VAO bound
+    void draw(GeometryRegistry& geometry, MeshHandle mesh, const QuadInstance* instances, size_t count);
+
+    // Split form for drawing the same instances into several views: upload once per frame,
+    // then draw the uploaded instances as often as needed
+    void upload(GeometryRegistry& geometry, const QuadInstance* instances, size_t count);
+    void draw(GeometryRegistry& geometry, MeshHandle mesh);
+
+    size_t getCapacity() const { return capacity; }
+
+private:
+    GLuint VAO = 0;
+    GLuint instanceBuffer = 0;
+    GLuint boundVertexBuffer = 0;  // registry buffer the VAO was set up against
+    size_t capacity = 0;           // instances allocated on the GPU
+    size_t uploaded = 0;           // instances in the buffer since the last upload
+
+    void setup(GeometryRegistry& geometry);
+    void bind(GeometryRegistry& geometry);
+};
+
+#endif //ENGINE_INSTANCEDQUADBATCH_H
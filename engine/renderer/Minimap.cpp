@@ -0,0 +1,125 @@
+#include "Minimap.h"
+#include "SceneRenderer.h"
+#include "entity/Entity.h"
+#include "transform/TransformComponent.h"
+#include <algorithm>
+#include <iostream>
+
+Minimap::Minimap(float minX, float minY, float maxX, float maxY, const MinimapSettings& settings)
+    : settings(settings),
+      camera(-(maxX - minX) * 0.5f, (maxX - minX) * 0.5f, -(maxY - minY) * 0.5f, (maxY - minY) * 0.5f, -1000.0f, 1000.0f) {
+    // Centred over the rect, looking straight down -Z
+    camera.setPosition((minX + maxX) * 0.5f, (minY + maxY) * 0.5f, 0.0f);
+    camera.setRotation(-90.0f, 0.0f);
+}
+
+bool Minimap::initialize() {
+    staticLayer = RenderTarget::create(settings.resolution, settings.resolution, true);
+    // Icons ignore depth, so the composite only needs colour
+    composite = RenderTarget::create(settings.resolution, settings.resolution, false);
+    if (!staticLayer || !composite) {
+        std::cerr << "ERROR::MINIMAP::Failed to create render targets" << std::endl;
+        staticLayer.reset();
+        composite.reset();
+        return false;
+    }
+    staticDirty = true;
+    return true;
+}
+
+void Minimap::track(Entity* entity, float r, float g, float b, float a) {
+    auto toByte = [](float value) { return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+
+    Icon icon{entity, {toByte(r), toByte(g), toByte(b), toByte(a)}};
+    auto it = std::find_if(icons.begin(), icons.end(), [entity](const Icon& existing) { return existing.entity == entity; });
+    if (it != icons.end()) {
+        *it = icon;
+    } else {
+        icons.push_back(icon);
+    }
+    iconsDirty = true;
+}
+
+void Minimap::untrack(Entity* entity) {
+    icons.erase(std::remove_if(icons.begin(), icons.end(), [entity](const Icon& icon) { return icon.entity == entity; }),
+                icons.end());
+    iconsDirty = true;
+}
+
+void Minimap::update(float deltaTime, SceneRenderer& renderer, SceneTree* root, int framebufferWidth, int framebufferHeight) {
+    if (!visible || !composite) return;
+
+    sinceRefresh += deltaTime;
+    const bool iconsDue = settings.updateRate <= 0.0f || sinceRefresh >= 1.0f / settings.updateRate;
+    if (!staticDirty && !iconsDirty && !iconsDue) return;
+
+    if (staticDirty) {
+        staticLayer->bind();
+        staticLayer->clear(settings.background[0], settings.background[1], settings.background[2], settings.background[3]);
+        renderer.renderStatic(root, &camera);
+        staticDirty = false;
+        stats.staticRenders++;
+    }
+
+    // Start every composite from the cached layer; only the icons are drawn again
+    composite->copyFrom(*staticLayer);
+    composite->bind();
+    renderIcons(renderer);
+
+    RenderTarget::unbind(framebufferWidth, framebufferHeight);
+    sinceRefresh = 0.0f;
+    iconsDirty = false;
+    stats.iconRenders++;
+}
+
+void Minimap::renderIcons(SceneRenderer& renderer) {
+    instances.clear();
+    for (const Icon& icon : icons) {
+        auto* transform = icon.entity->getComponent<TransformComponent>("transform");
+        if (!transform) continue;
+
+        QuadInstance instance;
+        instance.x = transform->position.x;
+        instance.y = transform->position.y;
+        instance.z = 0.0f;
+        instance.size = settings.iconSize;
+        std::copy(icon.colour, icon.colour + 4, instance.colour);
+        instances.push_back(instance);
+    }
+    stats.icons = static_cast<int>(instances.size());
+    if (instances.empty()) return;
+
+    Shader* shader = renderer.getShaderVariants()->get(ShaderFeature::Instanced);
+    if (!shader) return;
+
+    static constexpr float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    shader->use();
+    shader->setMat4("viewProjection", camera.getViewProjectionMatrix());
+    shader->setMat4("model", identity);
+
+    // Icons are an overlay: always on top of the cached terrain, then the caller's depth state again
+    const GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    glDisable(GL_DEPTH_TEST);
+    GeometryRegistry& geometry = renderer.getGeometry();
+    iconBatch.draw(geometry, geometry.find(GeometryRegistry::quad), instances.data(), instances.size());
+    glBindVertexArray(0);
+    if (depthTest) {
+        glEnable(GL_DEPTH_TEST);
+    }
+}
+
+void Minimap::draw(int framebufferWidth, int framebufferHeight) const {
+    if (!visible || !composite) return;
+
+    const int size = static_cast<int>(settings.screenSize * static_cast<float>(framebufferHeight));
+    const int x = static_cast<int>(settings.screenX * static_cast<float>(framebufferWidth));
+    const int y = static_cast<int>(settings.screenY * static_cast<float>(framebufferHeight));
+    composite->blitToScreen(x, y, size, size);
+}
+
+size_t Minimap::getGpuBytes() const {
+    size_t bytes = 0;
+    if (staticLayer) bytes += staticLayer->getGpuBytes();
+    if (composite) bytes += composite->getGpuBytes();
+    return bytes;
+}
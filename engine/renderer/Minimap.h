@@ -0,0 +1,89 @@
+#ifndef ENGINE_MINIMAP_H
+#define ENGINE_MINIMAP_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Camera.h"
+#include "InstancedQuadBatch.h"
+#include "QuadInstance.h"
+#include "texture/RenderTarget.h"
+
+class Entity;
+class SceneRenderer;
+class SceneTree;
+
+struct MinimapSettings {
+    int resolution = 256;       // square texture size in pixels
+    float updateRate = 10.0f;   // icon refreshes per second; 0 refreshes every frame
+    float iconSize = 4.0f;      // world units
+    float background[4] = {0.05f, 0.05f, 0.08f, 1.0f};
+
+    // Placement on screen, normalized with a bottom-left origin; size is a fraction of the window height
+    float screenX = 0.78f;
+    float screenY = 0.68f;
+    float screenSize = 0.3f;
+};
+
+struct MinimapStats {
+    int staticRenders = 0;   // times the cached static layer was re-rendered
+    int iconRenders = 0;     // times icons were composited over it
+    int icons = 0;           // last composite
+};
+
+// Top-down map of a rectangle of the XY plane, rendered through an OrthographicCamera
+// The static part of the scene is rendered once into a cached target and only re-rendered after
+// invalidateStatic(). Tracked units are drawn as coloured icons over a copy of that cache, at
+// most updateRate times a second; every frame in between just blits the last composite to the window
+class Minimap {
+public:
+    Minimap(float minX, float minY, float maxX, float maxY, const MinimapSettings& settings = {});
+
+    // Create the render targets (needs a GL context); false if the framebuffers are unsupported
+    bool initialize();
+
+    // Show an entity as an icon of the given colour
+    void track(Entity* entity, float r, float g, float b, float a = 1.0f);
+    void untrack(Entity* entity);
+
+    // The static layer changed (terrain edited, static entity removed)
+    void invalidateStatic() { staticDirty = true; }
+
+    // Refresh whatever is due; renders offscreen and leaves the window framebuffer bound
+    void update(float deltaTime, SceneRenderer& renderer, SceneTree* root, int framebufferWidth, int framebufferHeight);
+
+    // Copy the last composite onto the window
+    void draw(int framebufferWidth, int framebufferHeight) const;
+
+    void setVisible(bool value) { visible = value; }
+    bool isVisible() const { return visible; }
+    void setUpdateRate(float rate) { settings.updateRate = rate; }
+
+    OrthographicCamera& getCamera() { return camera; }
+    const MinimapStats& getStats() const { return stats; }
+    size_t getGpuBytes() const;
+
+private:
+    struct Icon {
+        Entity* entity;
+        uint8_t colour[4];
+    };
+
+    MinimapSettings settings;
+    OrthographicCamera camera;
+    std::unique_ptr<RenderTarget> staticLayer;   // cached terrain and static entities
+    std::unique_ptr<RenderTarget> composite;     // static layer plus icons, what gets shown
+    std::vector<Icon> icons;
+    std::vector<QuadInstance> instances;
+    InstancedQuadBatch iconBatch;
+    float sinceRefresh = 0.0f;
+    bool staticDirty = true;
+    bool iconsDirty = true;
+    bool visible = true;
+    MinimapStats stats;
+
+    void renderIcons(SceneRenderer& renderer);
+};
+
+#endif //ENGINE_MINIMAP_H
@@ -0,0 +1,14 @@
+#ifndef ENGINE_QUADINSTANCE_H
+#define ENGINE_QUADINSTANCE_H
+
+#include <cstdint>
+
+// Per-instance data of the INSTANCED shader variant (20 bytes)
+// The mesh is scaled by size and offset by the position; colour is normalized 8-bit RGBA
+struct QuadInstance {
+    float x, y, z;
+    float size;
+    uint8_t colour[4];
+};
+
+#endif //ENGINE_QUADINSTANCE_H
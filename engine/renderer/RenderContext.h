@@ -0,0 +1,26 @@
+#ifndef ENGINE_RENDERCONTEXT_H
+#define ENGINE_RENDERCONTEXT_H
+
+class Camera;
+class GeometryRegistry;
+class Shader;
+
+// Counters for one rendered frame
+struct RenderStats {
+    int drawCalls = 0;
+    int views = 0;
+    int entities = 0;         // entities visited while preparing the frame (once, not per view)
+    int renderedEntities = 0; // draw list items submitted, summed over views
+    int culledItems = 0;      // draw list items rejected by a view's frustum
+    int debugVertices = 0;
+};
+
+// Per-draw state handed to renderer components by the SceneRenderer
+struct RenderContext {
+    Shader* shader = nullptr;              // variant bound for the component's features
+    GeometryRegistry* geometry = nullptr;  // shared meshes, VAO already bound
+    Camera* camera = nullptr;
+    RenderStats* stats = nullptr;           // components add the draw calls they issue
+};
+
+#endif //ENGINE_RENDERCONTEXT_H
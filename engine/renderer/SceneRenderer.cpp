@@ -1,25 +1,50 @@
 #include "SceneRenderer.h"
 #include "components/RendererComponent.h"
 #include "transform/TransformComponent.h"
+#include "Frustum.h"
 #include <glad/glad.h>
+#include <algorithm>
 #include <queue>
 #include <cstring>
 #include <iostream>
 
-SceneRenderer::SceneRenderer(const std::string& shaderPath) : shaderPath(shaderPath) {}
+SceneRenderer::SceneRenderer(const std::string& shaderPath, const std::string& programCachePath)
+    : shaderPath(shaderPath), programCache(programCachePath) {}
 
-SceneRenderer::~SceneRenderer() = default;
+SceneRenderer::~SceneRenderer() {
+    if (Shader::getProgramCache() == &programCache) {
+        Shader::setProgramCache(nullptr);
+    }
+}
 
 void SceneRenderer::initialize() {
     if (initialized) return;
-    
-    // Load shader (supports both solid colour and textured rendering)
-    shader = Shader::fromFiles(shaderPath + "scene.vert", shaderPath + "scene.frag");
-    if (!shader || !shader->isValid()) {
+
+    Shader::setProgramCache(&programCache);
+
+    // Load the scene shader and build the variants the built-in renderers use
+    // Anything else is compiled the first time an entity asks for it
+    shaders = std::make_unique<ShaderVariants>(shaderPath + "scene.vert", shaderPath + "scene.frag");
+    if (!shaders->load()) {
         std::cerr << "ERROR::SCENE_RENDERER::Failed to load shaders from: " << shaderPath << std::endl;
+        shaders.reset();
+        return;
+    }
+    shaders->precompile({
+        ShaderFeature::None,
+        ShaderFeature::Textured,
+        ShaderFeature::Textured | ShaderFeature::Atlas,
+        ShaderFeature::VertexColour,
+        ShaderFeature::VertexColour | ShaderFeature::Textured,
+    });
+    if (!getShader()) {
+        std::cerr << "ERROR::SCENE_RENDERER::Failed to build the base shader from: " << shaderPath << std::endl;
+        shaders.reset();
         return;
     }
     
+    geometry.registerBuiltins();
+
     initialized = true;
 }
 
@@ -32,53 +57,199 @@ void SceneRenderer::clear(float r, float g, float b, float a) {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
+size_t SceneRenderer::addViewport(const Viewport& viewport) {
+    viewports.push_back(viewport);
+    return viewports.size() - 1;
+}
+
+void SceneRenderer::setFramebufferSize(int width, int height) {
+    framebufferWidth = width;
+    framebufferHeight = height;
+}
+
+void SceneRenderer::setOverlaySize(int width, int height) {
+    overlayWidth = width;
+    overlayHeight = height;
+}
+
 void SceneRenderer::render(SceneTree* root) {
-    if (!initialized || !camera || !root || !shader) return;
+    renderScene(root);
+    renderOverlay();
+}
 
-    // Set up shader with camera matrices
-    shader->use();
-    shader->setMat4("viewProjection", camera->getViewProjectionMatrix());
+void SceneRenderer::renderScene(SceneTree* root) {
+    if (!initialized || !root || !shaders) return;
+
+    // Without explicit viewports, the single camera fills the window
+    if (viewports.empty()) {
+        if (!camera) return;
+        Viewport full;
+        full.camera = camera;
+        full.clearDepth = false;
+        viewports.push_back(full);
+        renderScene(root);
+        viewports.clear();
+        return;
+    }
+
+    if (framebufferWidth <= 0 || framebufferHeight <= 0) {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        framebufferWidth = viewport[2];
+        framebufferHeight = viewport[3];
+    }
+    const int screenWidth = overlayWidth > 0 ? overlayWidth : framebufferWidth;
+    const int screenHeight = overlayHeight > 0 ? overlayHeight : framebufferHeight;
+
+    stats = RenderStats{};
+    prepare(root);
+    hasDebug = debugDraw.upload(screenWidth, screenHeight);
 
-    Tree::Traverse<SceneTree>(root, [this](SceneTree* node) {
-        if (auto* sceneNode = dynamic_cast<Entity*>(node)) {
-            renderEntity(sceneNode);
+    for (size_t i = 0; i < viewports.size(); ++i) {
+        if (viewports[i].enabled && viewports[i].camera) {
+            renderView(viewports[i]);
         }
+    }
+}
+
+void SceneRenderer::renderOverlay() {
+    // Screen overlay once, over the whole framebuffer
+    const int screenWidth = overlayWidth > 0 ? overlayWidth : framebufferWidth;
+    const int screenHeight = overlayHeight > 0 ? overlayHeight : framebufferHeight;
+    glViewport(0, 0, screenWidth, screenHeight);
+    if (hasDebug) {
+        debugDraw.drawScreen();
+        stats.drawCalls += debugDraw.getLastDrawCalls();
+        stats.debugVertices = static_cast<int>(debugDraw.getLastVertexCount());
+    }
+    hasDebug = false;
+    debugDraw.clear();
+}
+
+void SceneRenderer::prepare(SceneTree* root, bool staticOnly) {
+    drawList.clear();
+
+    Tree::Traverse<SceneTree>(root, [this, staticOnly](SceneTree* node) {
+        auto* entity = dynamic_cast<Entity*>(node);
+        if (!entity) return;
+        stats.entities++;
+
+        // Dynamic renderers are neither listed nor asked to rebuild their per-frame data
+        if (staticOnly && !entity->isStatic()) return;
+
+        // Already drawn as part of a static batch
+        if (entity->isStatic() && staticBatcher.contains(entity)) return;
+
+        TransformComponent* transform = entity->getComponent<TransformComponent>("transform");
+        RendererComponent* renderer = entity->getComponent<RendererComponent>("renderer");
+        if (!transform || !renderer) return;
+
+        DrawItem item;
+        item.renderer = renderer;
+        item.variant = shaders->get(renderer->getShaderFeatures());
+        if (!item.variant) return;
+        item.texture = renderer->getMaterialTexture();
+        buildModelMatrix(*transform, item.model);
+        item.bounded = renderer->getBounds(item.model, item.boundsMin, item.boundsMax);
+        item.isStatic = entity->isStatic();
+        renderer->prepareFrame();
+        drawList.push_back(item);
     });
+
+    // Group by material so consecutive draws share program and texture; stable keeps scene order within a group
+    std::stable_sort(drawList.begin(), drawList.end(), [](const DrawItem& a, const DrawItem& b) {
+        if (a.variant != b.variant) return a.variant < b.variant;
+        return a.texture < b.texture;
+    });
+}
+
+void SceneRenderer::renderView(const Viewport& viewport) {
+    const int x = static_cast<int>(viewport.x * static_cast<float>(framebufferWidth));
+    const int y = static_cast<int>(viewport.y * static_cast<float>(framebufferHeight));
+    const int width = static_cast<int>(viewport.width * static_cast<float>(framebufferWidth));
+    const int height = static_cast<int>(viewport.height * static_cast<float>(framebufferHeight));
+    glViewport(x, y, width, height);
+
+    if (viewport.clearColour || viewport.clearDepth) {
+        // Scissor keeps the clear inside this view
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(x, y, width, height);
+        GLbitfield mask = 0;
+        if (viewport.clearColour) {
+            glClearColor(viewport.colour[0], viewport.colour[1], viewport.colour[2], viewport.colour[3]);
+            mask |= GL_COLOR_BUFFER_BIT;
+        }
+        if (viewport.clearDepth) {
+            mask |= GL_DEPTH_BUFFER_BIT;
+        }
+        glClear(mask);
+        glDisable(GL_SCISSOR_TEST);
+    }
+
+    submit(viewport.camera, false);
+
+    debugDraw.drawWorld(viewport.camera->getViewProjectionMatrix());
+    stats.views++;
+}
+
+void SceneRenderer::submit(Camera* viewCamera, bool staticOnly) {
+    const float* viewProjection = viewCamera->getViewProjectionMatrix();
+    const Frustum frustum = Frustum::fromMatrix(viewProjection);
+
+    // Static entities first, a few draws for all of them
+    stats.drawCalls += staticBatcher.draw(*shaders, viewProjection, geometry);
+    boundShader = nullptr;
+
+    // Every built-in mesh lives behind one VAO, bound once for the whole view
+    geometry.bind();
+
+    RenderContext context;
+    context.geometry = &geometry;
+    context.camera = viewCamera;
+    context.stats = &stats;
+
+    for (DrawItem& item : drawList) {
+        if (staticOnly && !item.isStatic) continue;
+        if (item.bounded && !frustum.intersectsBox(item.boundsMin[0], item.boundsMin[1], item.boundsMin[2],
+                                                   item.boundsMax[0], item.boundsMax[1], item.boundsMax[2])) {
+            stats.culledItems++;
+            continue;
+        }
+
+        // Render with the variant compiled for exactly this component's features
+        bindVariant(item.variant, viewCamera);
+        context.shader = item.variant;
+        item.renderer->render(context, item.model);
+        stats.renderedEntities++;
+    }
+
+    glBindVertexArray(0);
 }
 
-void SceneRenderer::renderEntity(Entity* entity) {
-    if (!entity) return;
+void SceneRenderer::renderStatic(SceneTree* root, Camera* viewCamera) {
+    if (!initialized || !root || !viewCamera || !shaders) return;
 
-    // Get the transform component
-    TransformComponent* transform = entity->getComponent<TransformComponent>("transform");
-    if (!transform) return;
+    // Off the per-frame books: this runs only when a cached layer is invalidated
+    const RenderStats frameStats = stats;
+    prepare(root, true);
+    submit(viewCamera, true);
+    stats = frameStats;
+}
 
-    // Get the renderer component (if any)
-    RendererComponent* renderer = entity->getComponent<RendererComponent>("renderer");
-    if (!renderer) return;
+void SceneRenderer::bakeStatic(SceneTree* root) {
+    if (!initialized || !root) return;
+    staticBatcher.build(root, geometry);
+}
 
-    // Build model matrix from transform
-    float modelMatrix[16];
-    buildModelMatrix(*transform, modelMatrix);
+void SceneRenderer::bindVariant(Shader* variant, Camera* viewCamera) {
+    if (variant == boundShader) return;
 
-    // Render using the component (shader handles both textured and solid colour)
-    renderer->render(shader.get(), modelMatrix);
+    // Set up shader with camera matrices
+    variant->use();
+    variant->setMat4("viewProjection", viewCamera->getViewProjectionMatrix());
+    boundShader = variant;
 }
 
 void SceneRenderer::buildModelMatrix(const TransformComponent& transform, float* outMatrix) {
-    // Simple 2D model matrix: translation + scale (no rotation for simplicity)
-    // For 2D, we ignore z translation but can use it for depth sorting later
-    
-    std::memset(outMatrix, 0, 16 * sizeof(float));
-    
-    // Scale
-    outMatrix[0] = transform.scale.x;
-    outMatrix[5] = transform.scale.y;
-    outMatrix[10] = transform.scale.z;
-    outMatrix[15] = 1.0f;
-    
-    // Translation
-    outMatrix[12] = transform.position.x;
-    outMatrix[13] = transform.position.y;
-    outMatrix[14] = transform.position.z;
+    transform.getModelMatrix(outMatrix);
 }
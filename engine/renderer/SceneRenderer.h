@@ -2,51 +2,142 @@
 #define ENGINE_SCENERENDERER_H
 
 #include "Camera.h"
+#include "RenderContext.h"
+#include "StaticBatcher.h"
+#include "Viewport.h"
+#include "debug/DebugDraw.h"
+#include "geometry/GeometryRegistry.h"
+#include "shader/ProgramCache.h"
 #include "shader/Shader.h"
+#include "shader/ShaderVariants.h"
 #include "scene/SceneTree.h"
 #include "entity/Entity.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 // Forward declaration
 class RendererComponent;
 
 // SceneRenderer traverses a scene tree and renders all entities with renderer components
+// The scene is prepared once per frame (model matrices, shader variants, material sort) into a
+// draw list; each viewport then only culls that list against its camera and submits it
 class SceneRenderer {
 public:
-    // Constructor takes path to shaders directory (e.g., "shaders/")
-    explicit SceneRenderer(const std::string& shaderPath = "shaders/");
+    // Constructor takes path to shaders directory (e.g., "shaders/") and where linked program binaries are cached
+    explicit SceneRenderer(const std::string& shaderPath = "shaders/", const std::string& programCachePath = "shadercache/");
     ~SceneRenderer();
 
-    // Initialize the renderer (loads shaders, etc.)
+    // Initialize the renderer (loads shaders and compiles the declared variant set)
     void initialize();
     
-    // Set the camera used for rendering
+    // Set the camera used for rendering when no viewports were added (full window)
     void setCamera(Camera* camera);
-    
-    // Render the entire scene tree
+
+    // Split-screen / picture-in-picture views, drawn in the order they were added
+    size_t addViewport(const Viewport& viewport);
+    Viewport& getViewport(size_t index) { return viewports[index]; }
+    size_t getViewportCount() const { return viewports.size(); }
+    void clearViewports() { viewports.clear(); }
+
+    // Framebuffer size the normalized viewport rects map to (queried from GL when never set)
+    void setFramebufferSize(int width, int height);
+
+    // Size of the framebuffer the screen-space overlay is drawn into, when it differs from the
+    // scene's (e.g. the scene renders into a scaled offscreen target); 0 follows the framebuffer size
+    void setOverlaySize(int width, int height);
+
+    // Render the entire scene tree into every viewport, then the screen overlay
     void render(SceneTree* root);
+
+    // The two halves of render(), for callers that put a pass in between (e.g. an upscale)
+    void renderScene(SceneTree* root);
+    void renderOverlay();
+
+    // Render only the static part of the scene (baked batches and entities flagged static) with one
+    // camera into whatever framebuffer is bound; for cached layers such as the minimap terrain
+    void renderStatic(SceneTree* root, Camera* camera);
     
     // Clear the screen with a colour
     void clear(float r = 0.1f, float g = 0.1f, float b = 0.1f, float a = 1.0f);
 
-    // Get the shader
-    Shader* getShader() { return shader.get(); }
+    // Get the base (untextured) shader variant
+    Shader* getShader() { return shaders ? shaders->get(ShaderFeature::None) : nullptr; }
+
+    // Scene shader permutations, chosen per entity from its renderer's feature flags
+    ShaderVariants* getShaderVariants() { return shaders.get(); }
+
+    // Merge the static entities under root into pre-transformed batches (call once the level is loaded)
+    void bakeStatic(SceneTree* root);
+
+    // A baked entity is about to be destroyed; only its batch is rebuilt
+    void removeStatic(Entity* entity) { staticBatcher.remove(entity); }
+
+    // A baked entity changed colour, texture or position
+    void invalidateStatic(Entity* entity) { staticBatcher.invalidate(entity); }
+
+    const StaticBatcher& getStaticBatcher() const { return staticBatcher; }
+
+    // Immediate-mode debug shapes, drawn on top of the scene at the end of render()
+    DebugDraw& getDebugDraw() { return debugDraw; }
+
+    // Counters of the last render() call, summed over all views
+    const RenderStats& getStats() const { return stats; }
+
+    // Shared meshes that renderer components draw from
+    GeometryRegistry& getGeometry() { return geometry; }
+
+    // Program binary cache used by every shader built from source while this renderer is alive
+    ProgramCache& getProgramCache() { return programCache; }
 
     // Set shader directory path
     void setShaderPath(const std::string& path) { shaderPath = path; }
 
 private:
+    // One renderable entity, prepared once per frame and shared by all views
+    struct DrawItem {
+        RendererComponent* renderer;
+        Shader* variant;
+        const Texture2D* texture;
+        float model[16];
+        float boundsMin[3];
+        float boundsMax[3];
+        bool bounded;
+        bool isStatic;
+    };
+
     Camera* camera = nullptr;
-    std::unique_ptr<Shader> shader;
+    std::vector<Viewport> viewports;
+    std::vector<DrawItem> drawList;
+    int framebufferWidth = 0;
+    int framebufferHeight = 0;
+    int overlayWidth = 0;
+    int overlayHeight = 0;
+    bool hasDebug = false;          // debug geometry uploaded by renderScene, drawn by renderOverlay
+    std::unique_ptr<ShaderVariants> shaders;
+    Shader* boundShader = nullptr;  // variant currently in use during render()
     std::string shaderPath;
+    ProgramCache programCache;
+    GeometryRegistry geometry;
+    StaticBatcher staticBatcher;
+    DebugDraw debugDraw;
+    RenderStats stats;
     bool initialized = false;
 
     // Helper to build model matrix from transform
     void buildModelMatrix(const class TransformComponent& transform, float* outMatrix);
     
-    // Render a single entity
-    void renderEntity(Entity* entity);
+    // Make a variant current, uploading the view's camera matrix on switch
+    void bindVariant(Shader* variant, Camera* viewCamera);
+
+    // Build the frame's draw list, sorted by shader variant and texture (only static entities if staticOnly)
+    void prepare(SceneTree* root, bool staticOnly = false);
+
+    // Set up one view's rect and clears, then submit the draw list to it
+    void renderView(const Viewport& viewport);
+
+    // Cull the draw list against a camera and submit what is left (static batches first)
+    void submit(Camera* viewCamera, bool staticOnly);
 };
 
 #endif //ENGINE_SCENERENDERER_H
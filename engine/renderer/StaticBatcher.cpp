@@ -0,0 +1,242 @@
+#include "StaticBatcher.h"
+#include "components/QuadRenderer.h"
+#include "components/Texture2DComponent.h"
+#include "entity/Entity.h"
+#include "geometry/GeometryRegistry.h"
+#include "scene/SceneTree.h"
+#include "texture/TextureAtlas.h"
+#include "transform/TransformComponent.h"
+#include <algorithm>
+
+StaticBatcher::~StaticBatcher() {
+    clear();
+}
+
+void StaticBatcher::clear() {
+    for (auto& batch : batches) {
+        release(batch);
+    }
+    batches.clear();
+    members.clear();
+    updateStats();
+}
+
+void StaticBatcher::release(Batch& batch) {
+    if (batch.VAO != 0) {
+        glDeleteVertexArrays(1, &batch.VAO);
+        batch.VAO = 0;
+    }
+    if (batch.VBO != 0) {
+        glDeleteBuffers(1, &batch.VBO);
+        batch.VBO = 0;
+    }
+    if (batch.EBO != 0) {
+        glDeleteBuffers(1, &batch.EBO);
+        batch.EBO = 0;
+    }
+    batch.indexCount = 0;
+}
+
+bool StaticBatcher::keyFor(Entity* entity, BatchKey& key) {
+    // Only quads can be merged; other renderers keep drawing themselves
+    auto* quad = entity->getComponent<QuadRenderer>("renderer");
+    if (!quad || !entity->getComponent<TransformComponent>("transform")) return false;
+
+    key.texture = nullptr;
+    key.atlas = nullptr;
+    key.features = ShaderFeature::VertexColour;
+    if (quad->getAlphaTest()) {
+        key.features |= ShaderFeature::AlphaTest;
+    }
+
+    // Atlas UVs are baked into the vertices, so atlas regions batch with anything else on the same page
+    auto* texture = entity->getComponent<Texture2DComponent>("texture");
+    if (texture && texture->isValid()) {
+        if (texture->isAtlasRegion()) {
+            key.atlas = texture->getAtlas();
+        } else {
+            key.texture = texture->getTexture();
+        }
+        key.features |= ShaderFeature::Textured;
+    }
+    return true;
+}
+
+void StaticBatcher::insert(Entity* entity) {
+    BatchKey key;
+    if (!entity->isStatic() || !keyFor(entity, key)) return;
+
+    auto it = std::find_if(batches.begin(), batches.end(), [&key](const Batch& batch) { return batch.key == key; });
+    if (it == batches.end()) {
+        batches.push_back({});
+        batches.back().key = key;
+        it = batches.end() - 1;
+    }
+
+    it->entities.push_back(entity);
+    it->dirty = true;
+    members[entity] = static_cast<size_t>(it - batches.begin());
+}
+
+void StaticBatcher::build(SceneTree* root, GeometryRegistry& geometry) {
+    clear();
+
+    Tree::Traverse<SceneTree>(root, [this](SceneTree* node) {
+        if (auto* entity = dynamic_cast<Entity*>(node)) {
+            insert(entity);
+        }
+    });
+
+    for (auto& batch : batches) {
+        rebuild(batch, geometry);
+    }
+    stats.rebuilds = 0;
+    updateStats();
+}
+
+void StaticBatcher::remove(Entity* entity) {
+    auto it = members.find(entity);
+    if (it == members.end()) return;
+
+    Batch& batch = batches[it->second];
+    std::erase(batch.entities, entity);
+    batch.dirty = true;
+    members.erase(it);
+    updateStats();
+}
+
+void StaticBatcher::invalidate(Entity* entity) {
+    remove(entity);
+    insert(entity);
+    updateStats();
+}
+
+void StaticBatcher::rebuild(Batch& batch, GeometryRegistry& geometry) {
+    std::vector<BatchVertex> vertices;
+    std::vector<uint32_t> indices;
+
+    for (Entity* entity : batch.entities) {
+        auto* quad = entity->getComponent<QuadRenderer>("renderer");
+        MeshHandle mesh = geometry.find(quad->getMeshName());
+        if (!mesh.isValid()) continue;
+
+        float model[16];
+        entity->getComponent<TransformComponent>("transform")->getModelMatrix(model);
+
+        UVRect uv;
+        auto* texture = entity->getComponent<Texture2DComponent>("texture");
+        if (texture && texture->isValid()) {
+            uv = texture->getUVRect();
+        }
+
+        const MeshRange& range = geometry.getRange(mesh);
+        const GeometryVertex* source = geometry.getVertexData(mesh);
+        const uint32_t* sourceIndices = geometry.getIndexData(mesh);
+        const auto base = static_cast<uint32_t>(vertices.size());
+
+        for (GLsizei i = 0; i < range.vertexCount; ++i) {
+            const GeometryVertex& v = source[i];
+            vertices.push_back({
+                model[0] * v.x + model[4] * v.y + model[8] * v.z + model[12],
+                model[1] * v.x + model[5] * v.y + model[9] * v.z + model[13],
+                model[2] * v.x + model[6] * v.y + model[10] * v.z + model[14],
+                uv.u + v.u * uv.width,
+                uv.v + v.v * uv.height,
+                quad->getR(), quad->getG(), quad->getB(), quad->getA()
+            });
+        }
+        for (GLsizei i = 0; i < range.indexCount; ++i) {
+            indices.push_back(base + sourceIndices[i]);
+        }
+    }
+
+    if (batch.VAO == 0) {
+        glGenVertexArrays(1, &batch.VAO);
+        glGenBuffers(1, &batch.VBO);
+        glGenBuffers(1, &batch.EBO);
+
+        glBindVertexArray(batch.VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, batch.VBO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batch.EBO);
+
+        // Position attribute (location = 0)
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (void*)0);
+        glEnableVertexAttribArray(0);
+
+        // Texture coord attribute (location = 1)
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (void*)(3 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+
+        // Colour attribute (location = 6, matching the VERTEX_COLOUR variant)
+        glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (void*)(5 * sizeof(float)));
+        glEnableVertexAttribArray(6);
+    } else {
+        glBindVertexArray(batch.VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, batch.VBO);
+    }
+
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(BatchVertex)), vertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(uint32_t)), indices.data(), GL_STATIC_DRAW);
+    glBindVertexArray(0);
+
+    batch.indexCount = static_cast<GLsizei>(indices.size());
+    batch.atlasVersion = batch.key.atlas ? batch.key.atlas->getVersion() : 0;
+    batch.dirty = false;
+    stats.rebuilds++;
+}
+
+int StaticBatcher::draw(ShaderVariants& shaders, const float* viewProjection, GeometryRegistry& geometry) {
+    static constexpr float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+    // Same blending as QuadRenderer
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    int drawCalls = 0;
+    for (auto& batch : batches) {
+        // A repacked atlas moved every region, so the baked UVs are stale
+        if (batch.dirty || (batch.key.atlas && batch.atlasVersion != batch.key.atlas->getVersion())) {
+            rebuild(batch, geometry);
+        }
+        if (batch.indexCount == 0) continue;
+
+        Shader* shader = shaders.get(batch.key.features);
+        if (!shader) continue;
+
+        // Vertices are already in world space
+        shader->use();
+        shader->setMat4("viewProjection", viewProjection);
+        shader->setMat4("model", identity);
+        Texture2D* page = batch.key.atlas ? batch.key.atlas->getTexture() : batch.key.texture;
+        if (page) {
+            shader->setInt("textureSampler", 0);
+            page->bind(0);
+        }
+
+        glBindVertexArray(batch.VAO);
+        glDrawElements(GL_TRIANGLES, batch.indexCount, GL_UNSIGNED_INT, 0);
+        drawCalls++;
+    }
+    glBindVertexArray(0);
+    return drawCalls;
+}
+
+void StaticBatcher::updateStats() {
+    stats.entities = static_cast<int>(members.size());
+    stats.batches = 0;
+    for (const auto& batch : batches) {
+        if (!batch.entities.empty()) {
+            stats.batches++;
+        }
+    }
+    stats.drawsEliminated = stats.entities - stats.batches;
+}
+
+void StaticBatcher::reportStats(std::ostream& out) const {
+    out << "Static batching: " << stats.entities << " static entities in " << stats.batches << " batches, "
+        << stats.drawsEliminated << " draws eliminated per frame";
+    if (stats.rebuilds > 0) {
+        out << " (" << stats.rebuilds << " batches rebuilt)";
+    }
+    out << std::endl;
+}
@@ -0,0 +1,94 @@
+#ifndef ENGINE_STATICBATCHER_H
+#define ENGINE_STATICBATCHER_H
+
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+#include <glad/glad.h>
+
+#include "shader/ShaderVariants.h"
+
+class Entity;
+class GeometryRegistry;
+class SceneTree;
+class Texture2D;
+class TextureAtlas;
+
+struct StaticBatchStats {
+    int entities = 0;          // static entities baked into batches
+    int batches = 0;           // draws issued for them instead
+    int drawsEliminated = 0;   // entities - batches
+    int rebuilds = 0;          // batch rebuilds after invalidation
+};
+
+// Merges static entities that share a material (texture + shader features) into
+// pre-transformed vertex buffers, drawn with one call per batch
+// Per-entity colours and atlas UVs are baked into the vertices, so the batch is drawn with the
+// VERTEX_COLOUR variant and needs no per-entity uniforms
+class StaticBatcher {
+public:
+    StaticBatcher() = default;
+    ~StaticBatcher();
+
+    StaticBatcher(const StaticBatcher&) = delete;
+    StaticBatcher& operator=(const StaticBatcher&) = delete;
+
+    // Bake every static entity under root that uses a QuadRenderer; replaces any previous bake
+    void build(SceneTree* root, GeometryRegistry& geometry);
+
+    // Drop an entity from its batch (e.g. a destroyed wall); only that batch is rebuilt, on the next draw
+    void remove(Entity* entity);
+
+    // Re-bake an entity whose colour, texture or transform was changed
+    void invalidate(Entity* entity);
+
+    bool contains(Entity* entity) const { return members.contains(entity); }
+
+    // Draw all batches, returning the number of draw calls; leaves the shader of the last batch bound and no VAO bound
+    int draw(ShaderVariants& shaders, const float* viewProjection, GeometryRegistry& geometry);
+
+    void clear();
+
+    const StaticBatchStats& getStats() const { return stats; }
+    void reportStats(std::ostream& out) const;
+
+private:
+    struct BatchVertex {
+        float x, y, z;
+        float u, v;
+        float r, g, b, a;
+    };
+
+    // Atlas regions are keyed by their atlas, not its page: a repack replaces the page texture
+    struct BatchKey {
+        Texture2D* texture = nullptr;       // standalone textures
+        TextureAtlas* atlas = nullptr;
+        ShaderFeature features = ShaderFeature::None;
+
+        bool operator==(const BatchKey& other) const = default;
+    };
+
+    struct Batch {
+        BatchKey key;
+        std::vector<Entity*> entities;
+        GLuint VAO = 0;
+        GLuint VBO = 0;
+        GLuint EBO = 0;
+        GLsizei indexCount = 0;
+        unsigned int atlasVersion = 0;  // atlas version the UVs were baked against
+        bool dirty = true;
+    };
+
+    std::vector<Batch> batches;
+    std::unordered_map<Entity*, size_t> members;  // entity -> batch
+    StaticBatchStats stats;
+
+    static bool keyFor(Entity* entity, BatchKey& key);
+    void insert(Entity* entity);
+    void rebuild(Batch& batch, GeometryRegistry& geometry);
+    void release(Batch& batch);
+    void updateStats();
+};
+
+#endif //ENGINE_STATICBATCHER_H
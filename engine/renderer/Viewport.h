@@ -0,0 +1,23 @@
+#ifndef ENGINE_VIEWPORT_H
+#define ENGINE_VIEWPORT_H
+
+class Camera;
+
+// One view of the scene: a camera and the part of the framebuffer it draws to
+// The rect is normalized (0..1) with the origin at the bottom-left, so views follow window resizes
+struct Viewport {
+    Camera* camera = nullptr;
+    float x = 0.0f;
+    float y = 0.0f;
+    float width = 1.0f;
+    float height = 1.0f;
+
+    // Clear the view's rect before drawing it (needed when views overlap, e.g. a minimap)
+    bool clearColour = false;
+    bool clearDepth = true;
+    float colour[4] = {0.1f, 0.1f, 0.15f, 1.0f};
+
+    bool enabled = true;
+};
+
+#endif //ENGINE_VIEWPORT_H
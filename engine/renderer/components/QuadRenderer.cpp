@@ -1,6 +1,7 @@
 #include "QuadRenderer.h"
 #include "Texture2DComponent.h"
 #include "entity/Entity.h"
+#include <cmath>
 
 QuadRenderer::QuadRenderer(float r, float g, float b, float a) {
     colour[0] = r;
@@ -16,64 +17,66 @@ QuadRenderer::~QuadRenderer() {
 void QuadRenderer::initialize() {
     if (initialized) return;
 
-    // Define a unit quad with texture coordinates
-    // Position (3) + TexCoord (2) = 5 floats per vertex
-    float vertices[] = {
-        // positions          // texture coords
-        -0.5f, -0.5f, 0.0f,   0.0f, 0.0f,  // bottom-left
-         0.5f, -0.5f, 0.0f,   1.0f, 0.0f,  // bottom-right
-         0.5f,  0.5f, 0.0f,   1.0f, 1.0f,  // top-right
-        -0.5f,  0.5f, 0.0f,   0.0f, 1.0f   // top-left
-    };
-
-    // Two triangles to form a quad (counter-clockwise winding)
-    unsigned int indices[] = {
-        0, 1, 2,  // first triangle
-        0, 2, 3   // second triangle
-    };
-
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
-
-    glBindVertexArray(VAO);
-
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
+    // Nothing to create; the mesh handle is resolved against the renderer's registry on first draw
+    mesh = MeshHandle{};
+    initialized = true;
+}
 
-    // Position attribute (location = 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+ShaderFeature QuadRenderer::getShaderFeatures() {
+    ShaderFeature features = alphaTest ? ShaderFeature::AlphaTest : ShaderFeature::None;
 
-    // Texture coord attribute (location = 1)
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    // Check if entity has a Texture2DComponent
+    Texture2DComponent* texComponent = getComponent<Texture2DComponent>("texture");
+    if (texComponent && texComponent->isValid()) {
+        features |= ShaderFeature::Textured;
+        if (texComponent->isAtlasRegion()) {
+            features |= ShaderFeature::Atlas;
+        }
+    }
+    return features;
+}
 
-    glBindVertexArray(0);
+const Texture2D* QuadRenderer::getMaterialTexture() {
+    Texture2DComponent* texComponent = getComponent<Texture2DComponent>("texture");
+    return texComponent && texComponent->isValid() ? texComponent->getTexture() : nullptr;
+}
 
-    initialized = true;
+bool QuadRenderer::getBounds(const float* modelMatrix, float* outMin, float* outMax) {
+    // Every built-in mesh fits in the unit square centred on the origin
+    for (int axis = 0; axis < 3; ++axis) {
+        const float centre = modelMatrix[12 + axis];
+        const float extent = 0.5f * (std::abs(modelMatrix[axis]) + std::abs(modelMatrix[4 + axis]));
+        outMin[axis] = centre - extent;
+        outMax[axis] = centre + extent;
+    }
+    return true;
 }
 
-void QuadRenderer::render(Shader* shader, const float* modelMatrix) {
+void QuadRenderer::render(const RenderContext& context, const float* modelMatrix) {
     if (!initialized) {
         initialize();
     }
-    
-    // Check if entity has a Texture2DComponent
+
+    if (!mesh.isValid()) {
+        mesh = context.geometry->find(meshName);
+        if (!mesh.isValid()) return;
+    }
+
+    // Already current: the scene renderer binds each variant once for its run of the sorted draw list
+    Shader* shader = context.shader;
+
     Texture2DComponent* texComponent = getComponent<Texture2DComponent>("texture");
     bool hasTexture = texComponent && texComponent->isValid();
 
-    shader->use();
     shader->setMat4("model", modelMatrix);
     shader->setVec4("colour", colour[0], colour[1], colour[2], colour[3]);
 
-    // Set texture uniforms
-    shader->setInt("useTexture", hasTexture ? 1 : 0);
-    
+    // The variant was picked from getShaderFeatures(), so only its own uniforms are set
     if (hasTexture) {
+        if (texComponent->isAtlasRegion()) {
+            const UVRect& uv = texComponent->getUVRect();
+            shader->setVec4("uvRect", uv.u, uv.v, uv.width, uv.height);
+        }
         shader->setInt("textureSampler", 0);
         texComponent->getTexture()->bind(0);
     }
@@ -82,31 +85,21 @@ void QuadRenderer::render(Shader* shader, const float* modelMatrix) {
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-    glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
-
-    if (hasTexture) {
-        texComponent->getTexture()->unbind();
-    }
+    // The texture is left bound for the next textured item to replace
+    context.geometry->draw(mesh);
+    if (context.stats) context.stats->drawCalls++;
 }
 
 void QuadRenderer::cleanup() {
-    if (VAO != 0) {
-        glDeleteVertexArrays(1, &VAO);
-        VAO = 0;
-    }
-    if (VBO != 0) {
-        glDeleteBuffers(1, &VBO);
-        VBO = 0;
-    }
-    if (EBO != 0) {
-        glDeleteBuffers(1, &EBO);
-        EBO = 0;
-    }
+    mesh = MeshHandle{};
     initialized = false;
 }
 
+void QuadRenderer::setMesh(const std::string& name) {
+    meshName = name;
+    mesh = MeshHandle{};
+}
+
 void QuadRenderer::setColour(float r, float g, float b, float a) {
     colour[0] = r;
     colour[1] = g;
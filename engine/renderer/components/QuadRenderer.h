@@ -2,10 +2,12 @@
 #define ENGINE_QUADRENDERER_H
 
 #include "RendererComponent.h"
-#include <glad/glad.h>
+#include "../geometry/GeometryRegistry.h"
+#include <string>
 
 // A 2D renderer that renders a quad with optional texture
 // Looks for a Texture2DComponent on the same entity to use texture data
+// The geometry is a shared mesh from the GeometryRegistry (the unit quad unless changed with setMesh)
 class QuadRenderer : public RendererComponent {
 public:
     // Colour constructor - RGBA (0.0 - 1.0)
@@ -14,9 +16,16 @@ public:
     ~QuadRenderer() override;
 
     void initialize() override;
-    void render(Shader* shader, const float* modelMatrix) override;
+    ShaderFeature getShaderFeatures() override;
+    const Texture2D* getMaterialTexture() override;
+    bool getBounds(const float* modelMatrix, float* outMin, float* outMax) override;
+    void render(const RenderContext& context, const float* modelMatrix) override;
     void cleanup() override;
 
+    // Draw a different registered mesh (e.g. GeometryRegistry::circle)
+    void setMesh(const std::string& name);
+    const std::string& getMeshName() const { return meshName; }
+
     // Set colour/tint (for solid colour or tinting textured quads)
     void setColour(float r, float g, float b, float a = 1.0f);
     
@@ -26,12 +35,16 @@ public:
     float getB() const { return colour[2]; }
     float getA() const { return colour[3]; }
 
+    // Discard mostly transparent fragments instead of blending them (cut-out sprites)
+    void setAlphaTest(bool enabled) { alphaTest = enabled; }
+    bool getAlphaTest() const { return alphaTest; }
+
 private:
-    GLuint VAO = 0;
-    GLuint VBO = 0;
-    GLuint EBO = 0;
-    
+    std::string meshName = GeometryRegistry::quad;
+    MeshHandle mesh;  // resolved against the registry on first render
+
     float colour[4];  // RGBA (solid colour or tint for texture)
+    bool alphaTest = false;
 };
 
 #endif //ENGINE_QUADRENDERER_H
@@ -3,6 +3,10 @@
 
 #include "component/Component.h"
 #include "../shader/Shader.h"
+#include "../shader/ShaderVariants.h"
+#include "../RenderContext.h"
+
+class Texture2D;
 
 // Base class for all renderer components
 // Derived classes implement specific rendering (quad, mesh, cube, etc.)
@@ -11,13 +15,27 @@ public:
     RendererComponent() = default;
     virtual ~RendererComponent() = default;
 
-    // Initialize OpenGL resources (VAO, VBO, etc.)
+    // Initialize per-component resources (shared geometry lives in the GeometryRegistry)
     virtual void initialize() = 0;
     
-    // Render the component using the provided shader and camera matrices
-    virtual void render(Shader* shader, const float* modelMatrix) = 0;
+    // Shader variant this component needs; the renderer binds it before calling render()
+    virtual ShaderFeature getShaderFeatures() { return ShaderFeature::None; }
+
+    // Texture the component binds, used to sort draws by material (null when untextured)
+    virtual const Texture2D* getMaterialTexture() { return nullptr; }
+
+    // World-space bounds for per-view culling, given the entity's model matrix
+    // Returns false when the component cannot be bounded (it is then drawn in every view)
+    virtual bool getBounds(const float* modelMatrix, float* outMin, float* outMax) { return false; }
+
+    // Called once per frame before any view is drawn; per-frame CPU work (instance data) goes here,
+    // so render() only binds and draws, however many views there are
+    virtual void prepareFrame() {}
+
+    // Render the component with the context's shader and geometry
+    virtual void render(const RenderContext& context, const float* modelMatrix) = 0;
     
-    // Cleanup OpenGL resources
+    // Cleanup resources
     virtual void cleanup() = 0;
 
     // Check if the component has been initialized
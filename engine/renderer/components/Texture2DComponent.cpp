@@ -1,24 +1,56 @@
 #include "Texture2DComponent.h"
 
-Texture2DComponent::Texture2DComponent(const std::string& texturePath) 
-    : texturePath(texturePath) {
+Texture2DComponent::Texture2DComponent(AssetManager& assets, const std::string& texturePath)
+    : assets(&assets), texturePath(texturePath) {
     if (!texturePath.empty()) {
-        texture = std::make_unique<Texture2D>(texturePath);
+        texture = assets.acquireTexture(texturePath);
     }
 }
 
+Texture2DComponent::Texture2DComponent(TextureAtlas* atlas, const std::string& regionName)
+    : atlas(atlas), regionName(regionName) {
+}
+
+const UVRect& Texture2DComponent::getUVRect() {
+    // Re-resolve only after the atlas has been rebuilt
+    if (atlas && atlasVersion != atlas->getVersion()) {
+        uvRect = atlas->getRegion(regionName);
+        atlasVersion = atlas->getVersion();
+    }
+    return uvRect;
+}
+
+int Texture2DComponent::getWidth() const {
+    if (atlas) {
+        const Texture2D* page = atlas->getTexture();
+        return page ? static_cast<int>(atlas->getRegion(regionName).width * static_cast<float>(page->getWidth()) + 0.5f) : 0;
+    }
+    return texture ? texture->getWidth() : 0;
+}
+
+int Texture2DComponent::getHeight() const {
+    if (atlas) {
+        const Texture2D* page = atlas->getTexture();
+        return page ? static_cast<int>(atlas->getRegion(regionName).height * static_cast<float>(page->getHeight()) + 0.5f) : 0;
+    }
+    return texture ? texture->getHeight() : 0;
+}
+
 float Texture2DComponent::getAspectRatio() const {
-    if (!texture || texture->getHeight() == 0) {
+    if (getHeight() == 0) {
         return 1.0f;
     }
-    return static_cast<float>(texture->getWidth()) / static_cast<float>(texture->getHeight());
+    return static_cast<float>(getWidth()) / static_cast<float>(getHeight());
 }
 
 void Texture2DComponent::setTexturePath(const std::string& path) {
     texturePath = path;
-    if (path.empty()) {
+    atlas = nullptr;
+    regionName.clear();
+    uvRect = UVRect{};
+    if (path.empty() || !assets) {
         texture.reset();
     } else {
-        texture = std::make_unique<Texture2D>(path);
+        texture = assets->acquireTexture(path);
     }
 }
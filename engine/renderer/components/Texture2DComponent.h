@@ -1,37 +1,56 @@
 #ifndef ENGINE_TEXTURE2DCOMPONENT_H
 #define ENGINE_TEXTURE2DCOMPONENT_H
 
+#include "assets/AssetManager.h"
 #include "component/Component.h"
 #include "../texture/Texture2D.h"
+#include "../texture/TextureAtlas.h"
 #include <string>
 #include <memory>
 
 // Component that holds a Texture2D
 // Attach this to an entity to provide texture data for renderers
+// Either shares a texture acquired through the AssetManager or refers to a named region of a TextureAtlas
 class Texture2DComponent : public Component {
 public:
-    explicit Texture2DComponent(const std::string& texturePath);
+    // Components using the same file share one decoded, uploaded texture
+    Texture2DComponent(AssetManager& assets, const std::string& texturePath);
+
+    // Use a region of an atlas; the atlas must outlive the component
+    Texture2DComponent(TextureAtlas* atlas, const std::string& regionName);
     ~Texture2DComponent() override = default;
 
-    // Get the underlying texture
-    Texture2D* getTexture() { return texture.get(); }
-    const Texture2D* getTexture() const { return texture.get(); }
+    // Get the underlying texture (the atlas page for atlas regions)
+    Texture2D* getTexture() { return atlas ? atlas->getTexture() : texture.get(); }
+    const Texture2D* getTexture() const { return atlas ? atlas->getTexture() : texture.get(); }
+
+    // Region of the texture to sample, (0, 0, 1, 1) for standalone textures
+    const UVRect& getUVRect();
+
+    bool isAtlasRegion() const { return atlas != nullptr; }
+    TextureAtlas* getAtlas() const { return atlas; }
 
     // Check if texture is valid
-    bool isValid() const { return texture && texture->isValid(); }
+    bool isValid() const { return getTexture() && getTexture()->isValid(); }
 
     // Get texture properties
-    int getWidth() const { return texture ? texture->getWidth() : 0; }
-    int getHeight() const { return texture ? texture->getHeight() : 0; }
+    int getWidth() const;
+    int getHeight() const;
     float getAspectRatio() const;
 
-    // Reload texture from a new path
+    // Switch to the texture at a new path (detaches from any atlas)
     void setTexturePath(const std::string& path);
     const std::string& getTexturePath() const { return texturePath; }
 
 private:
+    AssetManager* assets = nullptr;
     std::string texturePath;
-    std::unique_ptr<Texture2D> texture;
+    std::shared_ptr<Texture2D> texture;
+
+    TextureAtlas* atlas = nullptr;
+    std::string regionName;
+    UVRect uvRect;
+    unsigned int atlasVersion = 0;  // atlas version uvRect was resolved against
 };
 
 #endif //ENGINE_TEXTURE2DCOMPONENT_H
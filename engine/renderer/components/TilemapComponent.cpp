@@ -0,0 +1,232 @@
+#include "TilemapComponent.h"
+#include "../Camera.h"
+#include "../Frustum.h"
+#include "../geometry/GeometryRegistry.h"
+#include <algorithm>
+#include <iostream>
+
+TilemapComponent::TilemapComponent(int width, int height, TextureAtlas* atlas, float tileSize, int chunkSize)
+    : width(std::max(width, 1)), height(std::max(height, 1)), tileSize(tileSize),
+      chunkSize(std::clamp(chunkSize, 1, maxChunkSize)), atlas(atlas) {
+    chunksX = (this->width + this->chunkSize - 1) / this->chunkSize;
+    chunksY = (this->height + this->chunkSize - 1) / this->chunkSize;
+    tiles.assign(static_cast<size_t>(this->width) * this->height, emptyTile);
+    chunks.resize(static_cast<size_t>(chunksX) * chunksY);
+    stats.chunks = static_cast<int>(chunks.size());
+}
+
+TilemapComponent::~TilemapComponent() {
+    cleanup();
+}
+
+void TilemapComponent::setTileType(uint16_t type, const std::string& regionName) {
+    if (type == emptyTile) return;
+
+    if (typeRegions.size() <= type) {
+        typeRegions.resize(static_cast<size_t>(type) + 1);
+    }
+    typeRegions[type] = regionName;
+
+    // Force UVs to be re-resolved and every chunk re-baked
+    atlasVersion = 0;
+}
+
+void TilemapComponent::setTile(int x, int y, uint16_t type) {
+    if (x < 0 || y < 0 || x >= width || y >= height) return;
+
+    uint16_t& tile = tiles[static_cast<size_t>(y) * width + x];
+    if (tile == type) return;
+
+    tile = type;
+    chunkAt(x, y).dirty = true;
+    version++;
+}
+
+uint16_t TilemapComponent::getTile(int x, int y) const {
+    if (x < 0 || y < 0 || x >= width || y >= height) return emptyTile;
+    return tiles[static_cast<size_t>(y) * width + x];
+}
+
+void TilemapComponent::fill(int x, int y, int fillWidth, int fillHeight, uint16_t type) {
+    const int x0 = std::max(x, 0);
+    const int y0 = std::max(y, 0);
+    const int x1 = std::min(x + fillWidth, width);
+    const int y1 = std::min(y + fillHeight, height);
+    if (x0 >= x1 || y0 >= y1) return;
+
+    for (int row = y0; row < y1; ++row) {
+        std::fill_n(tiles.begin() + static_cast<ptrdiff_t>(row) * width + x0, x1 - x0, type);
+    }
+    for (int cy = y0 / chunkSize; cy <= (y1 - 1) / chunkSize; ++cy) {
+        for (int cx = x0 / chunkSize; cx <= (x1 - 1) / chunkSize; ++cx) {
+            chunks[cy * chunksX + cx].dirty = true;
+        }
+    }
+    version++;
+}
+
+void TilemapComponent::initialize() {
+    if (initialized) return;
+
+    // One index pattern covers every chunk; chunks with fewer quads just draw a prefix of it
+    // A map smaller than one chunk only needs the pattern for its own tiles
+    const size_t quads = static_cast<size_t>(std::min(chunkSize, width)) * std::min(chunkSize, height);
+    std::vector<uint32_t> indices;
+    indices.reserve(quads * 6);
+    for (size_t q = 0; q < quads; ++q) {
+        const auto base = static_cast<uint32_t>(q * 4);
+        indices.insert(indices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+
+    // The element buffer binding belongs to the bound VAO, so upload with none bound
+    glBindVertexArray(0);
+    glGenBuffers(1, &EBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(uint32_t)), indices.data(), GL_STATIC_DRAW);
+
+    initialized = true;
+}
+
+void TilemapComponent::resolveTypes() {
+    typeUVs.assign(typeRegions.size(), UVRect{});
+    for (size_t type = 1; type < typeRegions.size(); ++type) {
+        if (typeRegions[type].empty()) continue;
+        if (!atlas->contains(typeRegions[type])) {
+            std::cerr << "ERROR::TILEMAP::Unknown atlas region: " << typeRegions[type] << std::endl;
+            continue;
+        }
+        typeUVs[type] = atlas->getRegion(typeRegions[type]);
+    }
+
+    atlasVersion = atlas->getVersion();
+    for (auto& chunk : chunks) {
+        chunk.dirty = true;
+    }
+}
+
+void TilemapComponent::rebuild(int chunkX, int chunkY) {
+    Chunk& chunk = chunks[chunkY * chunksX + chunkX];
+
+    const int x0 = chunkX * chunkSize;
+    const int y0 = chunkY * chunkSize;
+    const int x1 = std::min(x0 + chunkSize, width);
+    const int y1 = std::min(y0 + chunkSize, height);
+
+    std::vector<TileVertex> vertices;
+    vertices.reserve(static_cast<size_t>(x1 - x0) * (y1 - y0) * 4);
+    for (int y = y0; y < y1; ++y) {
+        for (int x = x0; x < x1; ++x) {
+            const uint16_t type = tiles[static_cast<size_t>(y) * width + x];
+            if (type == emptyTile || type >= typeUVs.size()) continue;
+
+            const UVRect& uv = typeUVs[type];
+            const float left = static_cast<float>(x) * tileSize;
+            const float bottom = static_cast<float>(y) * tileSize;
+            const float right = left + tileSize;
+            const float top = bottom + tileSize;
+            vertices.push_back({left, bottom, 0.0f, uv.u, uv.v});
+            vertices.push_back({right, bottom, 0.0f, uv.u + uv.width, uv.v});
+            vertices.push_back({right, top, 0.0f, uv.u + uv.width, uv.v + uv.height});
+            vertices.push_back({left, top, 0.0f, uv.u, uv.v + uv.height});
+        }
+    }
+
+    if (chunk.VAO == 0) {
+        glGenVertexArrays(1, &chunk.VAO);
+        glGenBuffers(1, &chunk.VBO);
+
+        glBindVertexArray(chunk.VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, chunk.VBO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+
+        // Position attribute (location = 0)
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(TileVertex), (void*)0);
+        glEnableVertexAttribArray(0);
+
+        // Texture coord attribute (location = 1)
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(TileVertex), (void*)(3 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+    } else {
+        glBindBuffer(GL_ARRAY_BUFFER, chunk.VBO);
+    }
+
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(TileVertex)), vertices.data(), GL_STATIC_DRAW);
+    chunk.indexCount = static_cast<GLsizei>(vertices.size() / 4 * 6);
+    chunk.dirty = false;
+
+    stats.rebuiltChunks++;
+    stats.totalRebuilds++;
+}
+
+void TilemapComponent::render(const RenderContext& context, const float* modelMatrix) {
+    if (!initialized) {
+        initialize();
+    }
+    if (!atlas || !atlas->getTexture() || !context.camera) return;
+
+    if (atlasVersion != atlas->getVersion()) {
+        resolveTypes();
+    }
+
+    stats.visibleChunks = 0;
+    stats.drawCalls = 0;
+    stats.rebuiltChunks = 0;
+
+    Shader* shader = context.shader;
+    shader->use();
+    shader->setMat4("model", modelMatrix);
+    shader->setVec4("colour", 1.0f, 1.0f, 1.0f, 1.0f);
+    shader->setInt("textureSampler", 0);
+    atlas->getTexture()->bind(0);
+
+    // Chunk bounds are in the entity's local space, so cull against viewProjection * model
+    const Frustum frustum = Frustum::fromMatrices(context.camera->getViewProjectionMatrix(), modelMatrix);
+    const float chunkExtent = static_cast<float>(chunkSize) * tileSize;
+
+    for (int cy = 0; cy < chunksY; ++cy) {
+        for (int cx = 0; cx < chunksX; ++cx) {
+            const float minX = static_cast<float>(cx) * chunkExtent;
+            const float minY = static_cast<float>(cy) * chunkExtent;
+            if (!frustum.intersectsBox(minX, minY, 0.0f, minX + chunkExtent, minY + chunkExtent, 0.0f)) continue;
+
+            stats.visibleChunks++;
+
+            // Chunks are only baked once they come into view
+            Chunk& chunk = chunks[cy * chunksX + cx];
+            if (chunk.dirty) {
+                rebuild(cx, cy);
+            }
+            if (chunk.indexCount == 0) continue;
+
+            glBindVertexArray(chunk.VAO);
+            glDrawElements(GL_TRIANGLES, chunk.indexCount, GL_UNSIGNED_INT, 0);
+            stats.drawCalls++;
+        }
+    }
+
+    atlas->getTexture()->unbind();
+    if (context.stats) context.stats->drawCalls += stats.drawCalls;
+
+    // Restore the shared geometry VAO for the entities drawn after us
+    context.geometry->bind();
+}
+
+void TilemapComponent::cleanup() {
+    for (auto& chunk : chunks) {
+        if (chunk.VAO != 0) {
+            glDeleteVertexArrays(1, &chunk.VAO);
+            chunk.VAO = 0;
+        }
+        if (chunk.VBO != 0) {
+            glDeleteBuffers(1, &chunk.VBO);
+            chunk.VBO = 0;
+        }
+        chunk.indexCount = 0;
+        chunk.dirty = true;
+    }
+    if (EBO != 0) {
+        glDeleteBuffers(1, &EBO);
+        EBO = 0;
+    }
+    initialized = false;
+}
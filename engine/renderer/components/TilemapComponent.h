@@ -0,0 +1,97 @@
+#ifndef ENGINE_TILEMAPCOMPONENT_H
+#define ENGINE_TILEMAPCOMPONENT_H
+
+#include "RendererComponent.h"
+#include "../texture/TextureAtlas.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <glad/glad.h>
+
+struct TilemapStats {
+    int chunks = 0;
+    int visibleChunks = 0;   // last frame, after frustum culling
+    int drawCalls = 0;       // last frame
+    int rebuiltChunks = 0;   // last frame
+    long long totalRebuilds = 0;
+};
+
+// Renders a grid of tiles from a TextureAtlas as a handful of static chunk meshes
+// Tiles are stored as 16-bit type ids (0 = empty); each type maps to a named atlas region.
+// The map is split into square chunks, each baked into its own vertex buffer the first time
+// it is visible and rebuilt only when one of its tiles changes. All chunks share one 32-bit index
+// buffer, so a chunk can cover 256x256 tiles and a fully visible 1024x1024 map is 16 draws; smaller
+// chunks cull tighter and re-bake less after an edit.
+// Tile (x, y) covers [x, x + 1] * tileSize by [y, y + 1] * tileSize in the entity's local space
+class TilemapComponent : public RendererComponent {
+public:
+    static constexpr uint16_t emptyTile = 0;
+    static constexpr int maxChunkSize = 512;
+
+    // chunkSize is in tiles, clamped to [1, maxChunkSize]
+    TilemapComponent(int width, int height, TextureAtlas* atlas, float tileSize = 1.0f, int chunkSize = 256);
+    ~TilemapComponent() override;
+
+    // Map a tile type id (1..65535) to an atlas region
+    void setTileType(uint16_t type, const std::string& regionName);
+
+    void setTile(int x, int y, uint16_t type);
+    uint16_t getTile(int x, int y) const;
+
+    // Fill a rectangle of tiles, dirtying each touched chunk once
+    void fill(int x, int y, int fillWidth, int fillHeight, uint16_t type);
+
+    // Row-major, width * height; version is bumped by every edit so readers can tell when to re-read
+    const uint16_t* getTiles() const { return tiles.data(); }
+    unsigned int getVersion() const { return version; }
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    float getTileSize() const { return tileSize; }
+
+    const TilemapStats& getStats() const { return stats; }
+
+    // RendererComponent interface
+    void initialize() override;
+    ShaderFeature getShaderFeatures() override { return ShaderFeature::Textured; }
+    void render(const RenderContext& context, const float* modelMatrix) override;
+    void cleanup() override;
+
+private:
+    struct TileVertex {
+        float x, y, z;
+        float u, v;
+    };
+
+    struct Chunk {
+        GLuint VAO = 0;
+        GLuint VBO = 0;
+        GLsizei indexCount = 0;
+        bool dirty = true;
+    };
+
+    int width;
+    int height;
+    float tileSize;
+    int chunkSize;
+    int chunksX;
+    int chunksY;
+
+    TextureAtlas* atlas;
+    unsigned int atlasVersion = 0;  // atlas version the chunk UVs were baked against
+    unsigned int version = 0;       // tile edits
+
+    std::vector<uint16_t> tiles;             // row-major, width * height
+    std::vector<std::string> typeRegions;    // type id -> atlas region name
+    std::vector<UVRect> typeUVs;             // resolved from typeRegions
+    std::vector<Chunk> chunks;
+    GLuint EBO = 0;                          // shared quad index pattern for a full chunk, 32-bit
+
+    TilemapStats stats;
+
+    Chunk& chunkAt(int x, int y) { return chunks[(y / chunkSize) * chunksX + x / chunkSize]; }
+    void resolveTypes();
+    void rebuild(int chunkX, int chunkY);
+};
+
+#endif //ENGINE_TILEMAPCOMPONENT_H
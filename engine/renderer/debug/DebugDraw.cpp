@@ -0,0 +1,347 @@
+#include "DebugDraw.h"
+#include "renderer/shader/Shader.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // World shapes use the view's matrix; screen shapes are already in clip space and use identity
+    const char* debugVertexSource = R"(#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aColour;
+uniform mat4 viewProjection;
+out vec4 VertexColour;
+void main() {
+    gl_Position = viewProjection * vec4(aPos, 1.0);
+    VertexColour = aColour;
+}
+)";
+
+    constexpr float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+
+    const char* debugFragmentSource = R"(#version 330 core
+in vec4 VertexColour;
+out vec4 FragColor;
+void main() {
+    FragColor = VertexColour;
+}
+)";
+
+    // 5x7 glyphs for ASCII 32 (space) to 95 (underscore); bit 4 is the leftmost column
+    // Lower case is drawn as upper case, anything else as '?'
+    constexpr uint8_t font[64][7] = {
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // space
+        {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04},  // !
+        {0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00},  // "
+        {0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A},  // #
+        {0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04},  // $
+        {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03},  // %
+        {0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D},  // &
+        {0x04, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00},  // '
+        {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02},  // (
+        {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08},  // )
+        {0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00},  // *
+        {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00},  // +
+        {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08},  // ,
+        {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00},  // -
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C},  // .
+        {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00},  // /
+        {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E},  // 0
+        {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E},  // 1
+        {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F},  // 2
+        {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E},  // 3
+        {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02},  // 4
+        {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E},  // 5
+        {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E},  // 6
+        {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08},  // 7
+        {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E},  // 8
+        {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C},  // 9
+        {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00},  // :
+        {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08},  // ;
+        {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02},  // <
+        {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00},  // =
+        {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08},  // >
+        {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04},  // ?
+        {0x0E, 0x11, 0x17, 0x15, 0x17, 0x10, 0x0F},  // @
+        {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},  // A
+        {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E},  // B
+        {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E},  // C
+        {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C},  // D
+        {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F},  // E
+        {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10},  // F
+        {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F},  // G
+        {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11},  // H
+        {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E},  // I
+        {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C},  // J
+        {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11},  // K
+        {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F},  // L
+        {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11},  // M
+        {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11},  // N
+        {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // O
+        {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10},  // P
+        {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D},  // Q
+        {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11},  // R
+        {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E},  // S
+        {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04},  // T
+        {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E},  // U
+        {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04},  // V
+        {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A},  // W
+        {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11},  // X
+        {0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04},  // Y
+        {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F},  // Z
+        {0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E},  // [
+        {0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00},  // backslash
+        {0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E},  // ]
+        {0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00},  // ^
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F},  // _
+    };
+
+    const uint8_t* glyphFor(char c) {
+        if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+        if (c < 32 || c > 95) c = '?';
+        return font[c - 32];
+    }
+}
+
+DebugDraw::DebugDraw() = default;
+
+DebugDraw::~DebugDraw() {
+    if (VAO != 0) {
+        glDeleteVertexArrays(1, &VAO);
+    }
+    if (VBO != 0) {
+        glDeleteBuffers(1, &VBO);
+    }
+}
+
+void DebugDraw::setEnabled(bool value) {
+    enabled = value;
+    if (!enabled) {
+        clear();
+    }
+}
+
+void DebugDraw::clear() {
+    worldLines.clear();
+    screenTriangles.clear();
+    uploaded = false;
+}
+
+void DebugDraw::line(float x0, float y0, float z0, float x1, float y1, float z1, DebugColour colour) {
+    if (!enabled) return;
+    worldLines.push_back({x0, y0, z0, colour});
+    worldLines.push_back({x1, y1, z1, colour});
+}
+
+void DebugDraw::box(float minX, float minY, float maxX, float maxY, float z, DebugColour colour) {
+    if (!enabled) return;
+    line(minX, minY, z, maxX, minY, z, colour);
+    line(maxX, minY, z, maxX, maxY, z, colour);
+    line(maxX, maxY, z, minX, maxY, z, colour);
+    line(minX, maxY, z, minX, minY, z, colour);
+}
+
+void DebugDraw::circle(float x, float y, float z, float radius, DebugColour colour, int segments) {
+    if (!enabled || segments < 3) return;
+
+    float prevX = x + radius;
+    float prevY = y;
+    for (int i = 1; i <= segments; ++i) {
+        const float angle = 6.28318530718f * static_cast<float>(i) / static_cast<float>(segments);
+        const float nextX = x + radius * std::cos(angle);
+        const float nextY = y + radius * std::sin(angle);
+        line(prevX, prevY, z, nextX, nextY, z, colour);
+        prevX = nextX;
+        prevY = nextY;
+    }
+}
+
+void DebugDraw::path(const float* points, size_t pointCount, float z, DebugColour colour) {
+    if (!enabled) return;
+    for (size_t i = 1; i < pointCount; ++i) {
+        line(points[(i - 1) * 2], points[(i - 1) * 2 + 1], z, points[i * 2], points[i * 2 + 1], z, colour);
+    }
+}
+
+// Screen lines become one-pixel-wide quads, so all screen shapes stay in submission order in one draw
+void DebugDraw::screenLine(float x0, float y0, float x1, float y1, DebugColour colour) {
+    if (!enabled) return;
+
+    const float dx = x1 - x0;
+    const float dy = y1 - y0;
+    const float length = std::sqrt(dx * dx + dy * dy);
+    if (length <= 0.0f) return;
+
+    const float nx = -dy / length * 0.5f;
+    const float ny = dx / length * 0.5f;
+    screenTriangles.push_back({x0 + nx, y0 + ny, 0.0f, colour});
+    screenTriangles.push_back({x0 - nx, y0 - ny, 0.0f, colour});
+    screenTriangles.push_back({x1 - nx, y1 - ny, 0.0f, colour});
+    screenTriangles.push_back({x0 + nx, y0 + ny, 0.0f, colour});
+    screenTriangles.push_back({x1 - nx, y1 - ny, 0.0f, colour});
+    screenTriangles.push_back({x1 + nx, y1 + ny, 0.0f, colour});
+}
+
+void DebugDraw::screenQuad(float x, float y, float width, float height, DebugColour colour) {
+    screenTriangles.push_back({x, y, 0.0f, colour});
+    screenTriangles.push_back({x, y + height, 0.0f, colour});
+    screenTriangles.push_back({x + width, y + height, 0.0f, colour});
+    screenTriangles.push_back({x, y, 0.0f, colour});
+    screenTriangles.push_back({x + width, y + height, 0.0f, colour});
+    screenTriangles.push_back({x + width, y, 0.0f, colour});
+}
+
+void DebugDraw::screenRect(float x, float y, float width, float height, DebugColour colour, bool filled) {
+    if (!enabled) return;
+
+    if (filled) {
+        screenQuad(x, y, width, height, colour);
+    } else {
+        screenLine(x, y, x + width, y, colour);
+        screenLine(x + width, y, x + width, y + height, colour);
+        screenLine(x + width, y + height, x, y + height, colour);
+        screenLine(x, y + height, x, y, colour);
+    }
+}
+
+void DebugDraw::text(float x, float y, std::string_view message, DebugColour colour, float scale) {
+    if (!enabled) return;
+
+    float penX = x;
+    float penY = y;
+    for (char c : message) {
+        if (c == '\n') {
+            penX = x;
+            penY += lineHeight * scale;
+            continue;
+        }
+
+        // One quad per horizontal run of lit pixels
+        const uint8_t* glyph = glyphFor(c);
+        for (int row = 0; row < glyphHeight; ++row) {
+            int column = 0;
+            while (column < glyphWidth) {
+                if (!(glyph[row] & (0x10 >> column))) {
+                    column++;
+                    continue;
+                }
+                const int runStart = column;
+                while (column < glyphWidth && (glyph[row] & (0x10 >> column))) {
+                    column++;
+                }
+                screenQuad(penX + runStart * scale, penY + row * scale, (column - runStart) * scale, scale, colour);
+            }
+        }
+        penX += glyphAdvance * scale;
+    }
+}
+
+bool DebugDraw::setup() {
+    shader = std::make_unique<Shader>(debugVertexSource, debugFragmentSource);
+    if (!shader->isValid()) return false;
+
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+    // Position attribute (location = 0)
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // Colour attribute (location = 1)
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    glBindVertexArray(0);
+    return true;
+}
+
+bool DebugDraw::upload(int viewportWidth, int viewportHeight) {
+    lastVertexCount = 0;
+    lastDrawCalls = 0;
+    uploaded = false;
+    if (!enabled) return false;
+
+    lineCount = worldLines.size();
+    if (lineCount + screenTriangles.size() == 0) return false;
+
+    if (!shader && !setup()) {
+        clear();
+        return false;
+    }
+
+    // World lines stay in world space; screen shapes go to clip space here
+    stream.clear();
+    stream.reserve(lineCount + screenTriangles.size());
+    stream.insert(stream.end(), worldLines.begin(), worldLines.end());
+
+    const float toClipX = 2.0f / static_cast<float>(std::max(viewportWidth, 1));
+    const float toClipY = -2.0f / static_cast<float>(std::max(viewportHeight, 1));
+    for (const Vertex& v : screenTriangles) {
+        stream.push_back({v.x * toClipX - 1.0f, v.y * toClipY + 1.0f, 0.0f, v.colour});
+    }
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    if (stream.size() > capacity) {
+        capacity = std::max(stream.size(), capacity * 2);
+    }
+    // Orphan last frame's storage rather than waiting for the GPU to finish with it
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(capacity * sizeof(Vertex)), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(stream.size() * sizeof(Vertex)), stream.data());
+    glBindVertexArray(0);
+
+    lastVertexCount = stream.size();
+    uploaded = true;
+    return true;
+}
+
+void DebugDraw::draw(const float* viewProjection, GLenum mode, size_t first, size_t count) {
+    shader->use();
+    shader->setMat4("viewProjection", viewProjection);
+
+    // Alpha blended and drawn on top of everything; hand the caller's blend and depth state back unchanged
+    const GLboolean blend = glIsEnabled(GL_BLEND);
+    const GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    GLint blendFunc[4];
+    glGetIntegerv(GL_BLEND_SRC_RGB, &blendFunc[0]);
+    glGetIntegerv(GL_BLEND_DST_RGB, &blendFunc[1]);
+    glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendFunc[2]);
+    glGetIntegerv(GL_BLEND_DST_ALPHA, &blendFunc[3]);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDisable(GL_DEPTH_TEST);
+
+    glBindVertexArray(VAO);
+    glDrawArrays(mode, static_cast<GLint>(first), static_cast<GLsizei>(count));
+    glBindVertexArray(0);
+
+    glBlendFuncSeparate(static_cast<GLenum>(blendFunc[0]), static_cast<GLenum>(blendFunc[1]),
+                        static_cast<GLenum>(blendFunc[2]), static_cast<GLenum>(blendFunc[3]));
+    if (!blend) {
+        glDisable(GL_BLEND);
+    }
+    if (depthTest) {
+        glEnable(GL_DEPTH_TEST);
+    }
+    lastDrawCalls++;
+}
+
+void DebugDraw::drawWorld(const float* viewProjection) {
+    if (!uploaded || lineCount == 0) return;
+    draw(viewProjection, GL_LINES, 0, lineCount);
+}
+
+void DebugDraw::drawScreen() {
+    if (!uploaded || stream.size() == lineCount) return;
+    draw(identity, GL_TRIANGLES, lineCount, stream.size() - lineCount);
+}
+
+void DebugDraw::flush(const float* viewProjection, int viewportWidth, int viewportHeight) {
+    if (upload(viewportWidth, viewportHeight)) {
+        drawWorld(viewProjection);
+        drawScreen();
+    }
+    clear();
+}
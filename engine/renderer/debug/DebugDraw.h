@@ -0,0 +1,108 @@
+#ifndef ENGINE_DEBUGDRAW_H
+#define ENGINE_DEBUGDRAW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include <glad/glad.h>
+
+class Shader;
+
+struct DebugColour {
+    uint8_t r = 255, g = 255, b = 255, a = 255;
+
+    static constexpr DebugColour rgba(uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255) { return {r, g, b, a}; }
+};
+
+namespace DebugColours {
+    inline constexpr DebugColour white{255, 255, 255, 255};
+    inline constexpr DebugColour red{255, 64, 64, 255};
+    inline constexpr DebugColour green{64, 255, 64, 255};
+    inline constexpr DebugColour blue{64, 128, 255, 255};
+    inline constexpr DebugColour yellow{255, 230, 64, 255};
+    inline constexpr DebugColour panel{0, 0, 0, 160};
+}
+
+// Immediate-mode debug drawing: lines, boxes, circles and text, submitted any time during a frame
+// Shapes are collected on the CPU and uploaded once per frame into a single streaming buffer;
+// the SceneRenderer then draws the world lines once per view and the screen overlay once, on top
+// World shapes use scene coordinates; screen shapes use pixels with the origin at the top-left.
+// While disabled every call returns immediately and nothing is stored or drawn
+class DebugDraw {
+public:
+    // Text glyphs are 5x7 pixels on a 6x9 cell at scale 1
+    static constexpr int glyphWidth = 5;
+    static constexpr int glyphHeight = 7;
+    static constexpr int glyphAdvance = 6;
+    static constexpr int lineHeight = 9;
+
+    DebugDraw();
+    ~DebugDraw();
+
+    DebugDraw(const DebugDraw&) = delete;
+    DebugDraw& operator=(const DebugDraw&) = delete;
+
+    void setEnabled(bool value);
+    bool isEnabled() const { return enabled; }
+
+    // World space
+    void line(float x0, float y0, float z0, float x1, float y1, float z1, DebugColour colour = DebugColours::white);
+    void box(float minX, float minY, float maxX, float maxY, float z, DebugColour colour = DebugColours::white);
+    void circle(float x, float y, float z, float radius, DebugColour colour = DebugColours::white, int segments = 24);
+
+    // Path through consecutive points (x, y pairs) at height z, e.g. an AI route
+    void path(const float* points, size_t pointCount, float z, DebugColour colour = DebugColours::yellow);
+
+    // Screen space, in pixels
+    void screenLine(float x0, float y0, float x1, float y1, DebugColour colour = DebugColours::white);
+    void screenRect(float x, float y, float width, float height, DebugColour colour, bool filled = true);
+    void text(float x, float y, std::string_view message, DebugColour colour = DebugColours::white, float scale = 1.0f);
+
+    // Upload this frame's shapes; screen coordinates are relative to a framebuffer of the given size
+    // Returns false when there is nothing to draw
+    bool upload(int framebufferWidth, int framebufferHeight);
+
+    // After upload(): world shapes for one view (one line draw), and the screen overlay (one triangle draw)
+    void drawWorld(const float* viewProjection);
+    void drawScreen();
+
+    // upload + drawWorld + drawScreen + clear, for a single view
+    void flush(const float* viewProjection, int viewportWidth, int viewportHeight);
+
+    // Discard this frame's submissions
+    void clear();
+
+    // Size of the last upload and the draws issued since
+    size_t getLastVertexCount() const { return lastVertexCount; }
+    int getLastDrawCalls() const { return lastDrawCalls; }
+
+private:
+    struct Vertex {
+        float x, y, z;
+        DebugColour colour;
+    };
+
+    bool enabled = true;
+
+    std::vector<Vertex> worldLines;
+    std::vector<Vertex> screenTriangles;
+    std::vector<Vertex> stream;
+    size_t lineCount = 0;   // world line vertices at the start of the stream
+    bool uploaded = false;
+
+    GLuint VAO = 0;
+    GLuint VBO = 0;
+    size_t capacity = 0;  // vertices allocated on the GPU
+    std::unique_ptr<Shader> shader;
+
+    size_t lastVertexCount = 0;
+    int lastDrawCalls = 0;
+
+    void screenQuad(float x, float y, float width, float height, DebugColour colour);
+    bool setup();
+    void draw(const float* viewProjection, GLenum mode, size_t first, size_t count);
+};
+
+#endif //ENGINE_DEBUGDRAW_H
@@ -0,0 +1,77 @@
+#include "PerfHud.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+    constexpr float panelX = 8.0f;
+    constexpr float panelY = 8.0f;
+    constexpr float panelWidth = 252.0f;
+    constexpr float padding = 6.0f;
+    constexpr float graphHeight = 48.0f;
+    constexpr float graphMaxMillis = 50.0f;   // top of the graph
+    constexpr float frameBudgetMillis = 1000.0f / 60.0f;
+}
+
+PerfHud::PerfHud(size_t historySize) : history(std::max<size_t>(historySize, 2)) {}
+
+void PerfHud::recordFrame(float frameMillis, float updateMillis, float renderMillis) {
+    history[next] = {frameMillis, updateMillis, renderMillis};
+    next = (next + 1) % history.size();
+    recorded = std::min(recorded + 1, history.size());
+}
+
+float PerfHud::getAverageFrameMillis() const {
+    if (recorded == 0) return 0.0f;
+
+    float total = 0.0f;
+    for (size_t i = 0; i < recorded; ++i) {
+        total += history[i].frameMillis;
+    }
+    return total / static_cast<float>(recorded);
+}
+
+void PerfHud::draw(DebugDraw& debug, const RenderStats& stats, const PerfHudMemory& memory) const {
+    if (!visible || !debug.isEnabled()) return;
+
+    const Sample& last = history[(next + history.size() - 1) % history.size()];
+    const float average = getAverageFrameMillis();
+
+    char lines[5][64];
+    std::snprintf(lines[0], sizeof(lines[0]), "FPS %.0f  FRAME %.2f MS", average > 0.0f ? 1000.0f / average : 0.0f, average);
+    std::snprintf(lines[1], sizeof(lines[1]), "UPDATE %.2f MS  RENDER %.2f MS", last.updateMillis, last.renderMillis);
+    std::snprintf(lines[2], sizeof(lines[2]), "DRAWS %d  DEBUG VERTS %d", stats.drawCalls, stats.debugVertices);
+    std::snprintf(lines[3], sizeof(lines[3]), "ENTITIES %d  (%d DRAWN)", stats.entities, stats.renderedEntities);
+    std::snprintf(lines[4], sizeof(lines[4]), "TEX %zu: %.1f MB  GEOM %.1f KB", memory.residentTextures,
+                  static_cast<double>(memory.textureBytes) / (1024.0 * 1024.0), static_cast<double>(memory.geometryBytes) / 1024.0);
+
+    const float textHeight = 5 * DebugDraw::lineHeight;
+    const float panelHeight = padding * 3 + textHeight + graphHeight;
+    debug.screenRect(panelX, panelY, panelWidth, panelHeight, DebugColours::panel);
+
+    float y = panelY + padding;
+    for (const char* line : lines) {
+        debug.text(panelX + padding, y, line);
+        y += DebugDraw::lineHeight;
+    }
+
+    // Frame time graph, oldest sample on the left
+    const float graphX = panelX + padding;
+    const float graphY = panelY + padding * 2 + textHeight;
+    const float graphWidth = panelWidth - padding * 2;
+    const float barWidth = graphWidth / static_cast<float>(history.size());
+    const float graphBottom = graphY + graphHeight;
+
+    for (size_t i = 0; i < recorded; ++i) {
+        const Sample& sample = history[(next + history.size() - recorded + i) % history.size()];
+        const float height = std::min(sample.frameMillis / graphMaxMillis, 1.0f) * graphHeight;
+        const DebugColour colour = sample.frameMillis <= frameBudgetMillis ? DebugColours::green
+                                 : sample.frameMillis <= 2.0f * frameBudgetMillis ? DebugColours::yellow
+                                 : DebugColours::red;
+        const float x = graphX + static_cast<float>(history.size() - recorded + i) * barWidth;
+        debug.screenRect(x, graphBottom - height, std::max(barWidth - 1.0f, 1.0f), height, colour);
+    }
+
+    // 60 Hz budget marker
+    const float budgetY = graphBottom - frameBudgetMillis / graphMaxMillis * graphHeight;
+    debug.screenLine(graphX, budgetY, graphX + graphWidth, budgetY, DebugColours::white);
+}
@@ -0,0 +1,47 @@
+#ifndef ENGINE_PERFHUD_H
+#define ENGINE_PERFHUD_H
+
+#include <cstddef>
+#include <vector>
+
+#include "DebugDraw.h"
+#include "renderer/RenderContext.h"
+
+// Memory figures shown by the HUD, gathered by whoever owns the services
+struct PerfHudMemory {
+    size_t textureBytes = 0;
+    size_t geometryBytes = 0;
+    size_t residentTextures = 0;
+};
+
+// On-screen performance overlay: frame time graph, draw calls, entity counts and memory
+// Frame times are always recorded (one ring buffer write); drawing happens only while visible
+class PerfHud {
+public:
+    explicit PerfHud(size_t historySize = 120);
+
+    void setVisible(bool value) { visible = value; }
+    bool isVisible() const { return visible; }
+    void toggle() { visible = !visible; }
+
+    void recordFrame(float frameMillis, float updateMillis, float renderMillis);
+
+    // Submit the overlay to the debug drawer (screen space, top-left corner)
+    void draw(DebugDraw& debug, const RenderStats& stats, const PerfHudMemory& memory) const;
+
+    float getAverageFrameMillis() const;
+
+private:
+    struct Sample {
+        float frameMillis = 0.0f;
+        float updateMillis = 0.0f;
+        float renderMillis = 0.0f;
+    };
+
+    std::vector<Sample> history;
+    size_t next = 0;     // ring buffer write position
+    size_t recorded = 0;
+    bool visible = false;
+};
+
+#endif //ENGINE_PERFHUD_H
@@ -0,0 +1,148 @@
+#include "GeometryRegistry.h"
+#include <algorithm>
+#include <cmath>
+
+GeometryRegistry::~GeometryRegistry() {
+    if (VAO != 0) {
+        glDeleteVertexArrays(1, &VAO);
+    }
+    if (VBO != 0) {
+        glDeleteBuffers(1, &VBO);
+    }
+    if (EBO != 0) {
+        glDeleteBuffers(1, &EBO);
+    }
+}
+
+void GeometryRegistry::registerBuiltins() {
+    // Two triangles to form a quad (counter-clockwise winding)
+    add(quad, {
+        {-0.5f, -0.5f, 0.0f, 0.0f, 0.0f},  // bottom-left
+        { 0.5f, -0.5f, 0.0f, 1.0f, 0.0f},  // bottom-right
+        { 0.5f,  0.5f, 0.0f, 1.0f, 1.0f},  // top-right
+        {-0.5f,  0.5f, 0.0f, 0.0f, 1.0f}   // top-left
+    }, {0, 1, 2, 0, 2, 3});
+
+    add(circle, circleVertices(32), circleIndices(32));
+
+    // A strip of quads along Y; V counts links so a repeating link texture tiles along the track
+    constexpr int links = 4;
+    std::vector<GeometryVertex> trackVertices;
+    std::vector<uint32_t> trackIndices;
+    for (int i = 0; i <= links; ++i) {
+        const float y = -0.5f + static_cast<float>(i) / links;
+        trackVertices.push_back({-0.5f, y, 0.0f, 0.0f, static_cast<float>(i)});
+        trackVertices.push_back({ 0.5f, y, 0.0f, 1.0f, static_cast<float>(i)});
+    }
+    for (uint32_t i = 0; i < links; ++i) {
+        const uint32_t base = i * 2;
+        trackIndices.insert(trackIndices.end(), {base, base + 1, base + 3, base, base + 3, base + 2});
+    }
+    add(track, trackVertices, trackIndices);
+}
+
+std::vector<GeometryVertex> GeometryRegistry::circleVertices(int segments) {
+    std::vector<GeometryVertex> result;
+    result.reserve(static_cast<size_t>(segments) + 1);
+    result.push_back({0.0f, 0.0f, 0.0f, 0.5f, 0.5f});  // centre
+    for (int i = 0; i < segments; ++i) {
+        const float angle = 6.28318530718f * static_cast<float>(i) / static_cast<float>(segments);
+        const float x = 0.5f * std::cos(angle);
+        const float y = 0.5f * std::sin(angle);
+        result.push_back({x, y, 0.0f, x + 0.5f, y + 0.5f});
+    }
+    return result;
+}
+
+std::vector<uint32_t> GeometryRegistry::circleIndices(int segments) {
+    std::vector<uint32_t> result;
+    result.reserve(static_cast<size_t>(segments) * 3);
+    for (int i = 0; i < segments; ++i) {
+        result.push_back(0);
+        result.push_back(1 + i);
+        result.push_back(1 + (i + 1) % segments);
+    }
+    return result;
+}
+
+MeshHandle GeometryRegistry::add(const std::string& name, const std::vector<GeometryVertex>& meshVertices, const std::vector<uint32_t>& meshIndices) {
+    if (auto it = names.find(name); it != names.end()) {
+        return it->second;
+    }
+
+    MeshRange range;
+    range.baseVertex = static_cast<GLint>(vertices.size());
+    range.vertexCount = static_cast<GLsizei>(meshVertices.size());
+    range.firstIndex = indices.size();
+    range.indexCount = static_cast<GLsizei>(meshIndices.size());
+
+    vertices.insert(vertices.end(), meshVertices.begin(), meshVertices.end());
+    indices.insert(indices.end(), meshIndices.begin(), meshIndices.end());
+
+    MeshHandle handle{static_cast<uint32_t>(meshes.size())};
+    meshes.push_back(range);
+    names[name] = handle;
+    return handle;
+}
+
+MeshHandle GeometryRegistry::find(const std::string& name) const {
+    auto it = names.find(name);
+    return it != names.end() ? it->second : MeshHandle{};
+}
+
+void GeometryRegistry::bind() {
+    if (VAO == 0) {
+        glGenVertexArrays(1, &VAO);
+        glGenBuffers(1, &VBO);
+        glGenBuffers(1, &EBO);
+
+        glBindVertexArray(VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, VBO);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+
+        // Position attribute (location = 0)
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(GeometryVertex), (void*)0);
+        glEnableVertexAttribArray(0);
+
+        // Texture coord attribute (location = 1)
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(GeometryVertex), (void*)(3 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+    } else {
+        glBindVertexArray(VAO);
+    }
+
+    if (uploadedVertices != vertices.size() || uploadedIndices != indices.size()) {
+        upload();
+    }
+}
+
+// Appends new meshes with sub-data uploads, regrowing a buffer (and re-uploading it whole) only when it is full
+void GeometryRegistry::upload() {
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    if (vertices.size() > vertexCapacity) {
+        vertexCapacity = std::max(vertices.size(), vertexCapacity * 2);
+        glBufferData(GL_ARRAY_BUFFER, vertexCapacity * sizeof(GeometryVertex), nullptr, GL_STATIC_DRAW);
+        uploadedVertices = 0;
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, uploadedVertices * sizeof(GeometryVertex),
+                    (vertices.size() - uploadedVertices) * sizeof(GeometryVertex), vertices.data() + uploadedVertices);
+    uploadedVertices = vertices.size();
+
+    // The element buffer binding is VAO state, and the VAO is bound here
+    if (indices.size() > indexCapacity) {
+        indexCapacity = std::max(indices.size(), indexCapacity * 2);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexCapacity * sizeof(uint32_t), nullptr, GL_STATIC_DRAW);
+        uploadedIndices = 0;
+    }
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, uploadedIndices * sizeof(uint32_t),
+                    (indices.size() - uploadedIndices) * sizeof(uint32_t), indices.data() + uploadedIndices);
+    uploadedIndices = indices.size();
+}
+
+void GeometryRegistry::draw(MeshHandle handle) const {
+    if (!handle.isValid() || handle.id >= meshes.size()) return;
+
+    const MeshRange& range = meshes[handle.id];
+    glDrawElementsBaseVertex(GL_TRIANGLES, range.indexCount, GL_UNSIGNED_INT,
+                             (void*)(range.firstIndex * sizeof(uint32_t)), range.baseVertex);
+}
@@ -0,0 +1,100 @@
+#ifndef ENGINE_GEOMETRYREGISTRY_H
+#define ENGINE_GEOMETRYREGISTRY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glad/glad.h>
+
+// Vertex layout shared by all registered meshes: position (location 0) + texture coords (location 1)
+struct GeometryVertex {
+    float x, y, z;
+    float u, v;
+};
+
+// Index of a mesh in a GeometryRegistry
+struct MeshHandle {
+    static constexpr uint32_t invalidId = UINT32_MAX;
+    uint32_t id = invalidId;
+
+    bool isValid() const { return id != invalidId; }
+    bool operator==(const MeshHandle& other) const = default;
+};
+
+// Where a mesh lives inside the shared buffers
+struct MeshRange {
+    GLint baseVertex = 0;     // added to every index of the mesh
+    GLsizei vertexCount = 0;
+    size_t firstIndex = 0;
+    GLsizei indexCount = 0;
+};
+
+// Stores named meshes once, suballocated from one vertex buffer and one index buffer behind a
+// single VAO. Meshes keep mesh-local indices and are drawn with glDrawElementsBaseVertex, so
+// switching meshes never rebinds buffers and neighbouring draws can be batched
+class GeometryRegistry {
+public:
+    // Built-in meshes, registered by registerBuiltins()
+    static constexpr const char* quad = "quad";     // unit quad centred on the origin
+    static constexpr const char* circle = "circle"; // unit-diameter disc, 32 segments
+    static constexpr const char* track = "track";   // unit track segment, V runs along its length in 4 links
+
+    GeometryRegistry() = default;
+    ~GeometryRegistry();
+
+    GeometryRegistry(const GeometryRegistry&) = delete;
+    GeometryRegistry& operator=(const GeometryRegistry&) = delete;
+
+    void registerBuiltins();
+
+    // Register a mesh; indices are relative to its own vertices. Re-adding a name returns the existing handle
+    MeshHandle add(const std::string& name, const std::vector<GeometryVertex>& vertices, const std::vector<uint32_t>& indices);
+
+    // Handle for a registered name, invalid if unknown
+    MeshHandle find(const std::string& name) const;
+    const MeshRange& getRange(MeshHandle handle) const { return meshes[handle.id]; }
+
+    // CPU copies of a mesh (mesh-local indices), for baking it into other buffers
+    const GeometryVertex* getVertexData(MeshHandle handle) const { return vertices.data() + meshes[handle.id].baseVertex; }
+    const uint32_t* getIndexData(MeshHandle handle) const { return indices.data() + meshes[handle.id].firstIndex; }
+
+    // Bind the shared VAO, uploading meshes added since the last bind
+    void bind();
+
+    // Draw a mesh; bind() must have been called since the last foreign VAO bind
+    void draw(MeshHandle handle) const;
+
+    // Shared buffers, for VAOs that add their own attributes (e.g. instance data); valid after bind()
+    GLuint getVertexBuffer() const { return VBO; }
+    GLuint getIndexBuffer() const { return EBO; }
+
+    size_t getMeshCount() const { return meshes.size(); }
+    size_t getVertexCount() const { return vertices.size(); }
+    size_t getIndexCount() const { return indices.size(); }
+    size_t getGpuBytes() const { return vertexCapacity * sizeof(GeometryVertex) + indexCapacity * sizeof(uint32_t); }
+
+    static std::vector<GeometryVertex> circleVertices(int segments);
+    static std::vector<uint32_t> circleIndices(int segments);
+
+private:
+    GLuint VAO = 0;
+    GLuint VBO = 0;
+    GLuint EBO = 0;
+
+    // CPU copies, so the GPU buffers can be regrown without reading them back
+    std::vector<GeometryVertex> vertices;
+    std::vector<uint32_t> indices;
+    size_t vertexCapacity = 0;  // elements allocated on the GPU
+    size_t indexCapacity = 0;
+    size_t uploadedVertices = 0;
+    size_t uploadedIndices = 0;
+
+    std::vector<MeshRange> meshes;
+    std::unordered_map<std::string, MeshHandle> names;
+
+    void upload();
+};
+
+#endif //ENGINE_GEOMETRYREGISTRY_H
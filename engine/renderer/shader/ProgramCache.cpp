@@ -0,0 +1,145 @@
+#include "ProgramCache.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "assets/ContentHash.h"
+
+namespace {
+    struct ProgramBinaryHeader {
+        char magic[4];          // "TKPB"
+        uint32_t version;
+        uint64_t sourceHash;
+        uint64_t driverHash;
+        uint32_t binaryFormat;  // GLenum reported by glGetProgramBinary
+        uint32_t size;
+        uint64_t compileMicros; // cost of building the program from source
+    };
+
+    constexpr char programBinaryMagic[4] = {'T', 'K', 'P', 'B'};
+    constexpr uint32_t programBinaryVersion = 1;
+
+    const char* glString(GLenum name) {
+        const GLubyte* value = glGetString(name);
+        return value ? reinterpret_cast<const char*>(value) : "";
+    }
+}
+
+ProgramCache::ProgramCache(const std::string& directory) : directory(directory) {}
+
+bool ProgramCache::isSupported() {
+    if (supported < 0) {
+        GLint formats = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        supported = formats > 0 ? 1 : 0;
+
+        driverHash = hashString(glString(GL_VENDOR));
+        driverHash = hashString(glString(GL_RENDERER), driverHash);
+        driverHash = hashString(glString(GL_VERSION), driverHash);
+    }
+    return supported == 1;
+}
+
+std::string ProgramCache::pathFor(uint64_t sourceHash) const {
+    char name[40];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(hashBytes(&driverHash, sizeof(driverHash), sourceHash)));
+    return directory + name;
+}
+
+GLuint ProgramCache::load(uint64_t sourceHash) {
+    if (!isSupported()) return 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    const std::string path = pathFor(sourceHash);
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return 0;
+
+    ProgramBinaryHeader header {};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || std::memcmp(header.magic, programBinaryMagic, sizeof(header.magic)) != 0
+        || header.version != programBinaryVersion
+        || header.sourceHash != sourceHash
+        || header.driverHash != driverHash) {
+        stats.rejected++;
+        return 0;
+    }
+
+    std::vector<char> binary(header.size);
+    if (!file.read(binary.data(), static_cast<std::streamsize>(binary.size()))) {
+        stats.rejected++;
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+
+    GLint success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        // The driver may refuse binaries from an older build of itself; rebuild from source
+        glDeleteProgram(program);
+        stats.rejected++;
+        return 0;
+    }
+
+    const double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    stats.hits++;
+    stats.loadMillis += millis;
+    stats.savedMillis += static_cast<double>(header.compileMicros) / 1000.0 - millis;
+    return program;
+}
+
+void ProgramCache::recordMiss(double compileMillis) {
+    stats.misses++;
+    stats.compileMillis += compileMillis;
+}
+
+void ProgramCache::store(uint64_t sourceHash, GLuint program, double compileMillis) {
+    if (!isSupported()) return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(static_cast<size_t>(length));
+    GLenum binaryFormat = 0;
+    glGetProgramBinary(program, length, &length, &binaryFormat, binary.data());
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+
+    const std::string path = pathFor(sourceHash);
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "ERROR::PROGRAM_CACHE::Failed to write: " << path << std::endl;
+        return;
+    }
+
+    ProgramBinaryHeader header {};
+    std::memcpy(header.magic, programBinaryMagic, sizeof(header.magic));
+    header.version = programBinaryVersion;
+    header.sourceHash = sourceHash;
+    header.driverHash = driverHash;
+    header.binaryFormat = binaryFormat;
+    header.size = static_cast<uint32_t>(length);
+    header.compileMicros = static_cast<uint64_t>(compileMillis * 1000.0);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(binary.data(), length);
+}
+
+void ProgramCache::reportStats(std::ostream& out) const {
+    const int requests = stats.hits + stats.misses;
+    const float hitRate = requests > 0 ? 100.0f * static_cast<float>(stats.hits) / static_cast<float>(requests) : 0.0f;
+    out << "Program cache: " << requests << " programs, " << stats.hits << " from binary (" << hitRate << "% hit rate), "
+        << stats.misses << " compiled in " << stats.compileMillis << " ms";
+    if (stats.rejected > 0) {
+        out << ", " << stats.rejected << " stale binaries rejected";
+    }
+    out << ", " << stats.savedMillis << " ms saved" << std::endl;
+}
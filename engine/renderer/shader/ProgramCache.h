@@ -0,0 +1,51 @@
+#ifndef ENGINE_PROGRAMCACHE_H
+#define ENGINE_PROGRAMCACHE_H
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <glad/glad.h>
+
+struct ProgramCacheStats {
+    int hits = 0;            // programs restored from a cached binary
+    int misses = 0;          // no usable binary, compiled from source
+    int rejected = 0;        // binary found but refused by the driver (or stale), recompiled
+    double compileMillis = 0.0;  // time spent compiling and linking on misses
+    double loadMillis = 0.0;     // time spent restoring binaries on hits
+    double savedMillis = 0.0;    // compile time the hits would have cost, minus their load time
+};
+
+// On-disk cache of linked program binaries (glGetProgramBinary / glProgramBinary)
+// Entries are keyed by a hash of the shader sources plus the GL vendor, renderer and version
+// strings, so a driver update or an edited shader simply misses and recompiles
+//
+// File layout: ProgramBinaryHeader followed by the binary blob
+class ProgramCache {
+public:
+    explicit ProgramCache(const std::string& directory = "shadercache/");
+
+    // False when the driver exposes no binary formats; load() then always misses and store() does nothing
+    bool isSupported();
+
+    // Create a program from the binary cached for these sources, 0 on a miss or mismatch
+    GLuint load(uint64_t sourceHash);
+
+    // Persist a freshly linked program; compileMillis is what building it from source cost
+    void store(uint64_t sourceHash, GLuint program, double compileMillis);
+
+    // Count a program that had to be built from source
+    void recordMiss(double compileMillis);
+
+    const ProgramCacheStats& getStats() const { return stats; }
+    void reportStats(std::ostream& out) const;
+
+private:
+    std::string directory;
+    uint64_t driverHash = 0;
+    int supported = -1;  // unknown until the first query (needs a current context)
+    ProgramCacheStats stats;
+
+    std::string pathFor(uint64_t sourceHash) const;
+};
+
+#endif //ENGINE_PROGRAMCACHE_H
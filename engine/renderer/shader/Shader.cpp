@@ -1,15 +1,16 @@
 #include "Shader.h"
+#include "ProgramCache.h"
+#include "assets/ContentHash.h"
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string>
 
-Shader::Shader(const char* vertexSource, const char* fragmentSource) {
-    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource);
-    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource);
-
-    linkProgram(vertexShader, fragmentShader);
+ProgramCache* Shader::programCache = nullptr;
 
-    glDeleteShader(vertexShader);
-    glDeleteShader(fragmentShader);
+Shader::Shader(const char* vertexSource, const char* fragmentSource) {
+    build(vertexSource, fragmentSource);
 }
 
 Shader::Shader(const VertexShader& vertexShader, const FragmentShader& fragmentShader) {
@@ -27,27 +28,82 @@ Shader::Shader(const std::string& basePath) {
     const std::string vertexPath = basePath + ".vert";
     const std::string fragmentPath = basePath + ".frag";
 
-    VertexShader vertexShader(vertexPath);
-    FragmentShader fragmentShader(fragmentPath);
+    const std::string vertexSource = readSource(vertexPath);
+    const std::string fragmentSource = readSource(fragmentPath);
 
-    if (!vertexShader.isValid() || !fragmentShader.isValid()) {
+    if (vertexSource.empty() || fragmentSource.empty()) {
         std::cerr << "ERROR::SHADER::INVALID_SHADER_FILES for base path: " << basePath << std::endl;
         valid = false;
         return;
     }
 
-    linkProgram(vertexShader.getHandle(), fragmentShader.getHandle());
+    build(vertexSource, fragmentSource);
 }
 
 std::unique_ptr<Shader> Shader::fromFiles(const std::string& vertexPath, const std::string& fragmentPath) {
-    VertexShader vertexShader(vertexPath);
-    FragmentShader fragmentShader(fragmentPath);
+    const std::string vertexSource = readSource(vertexPath);
+    const std::string fragmentSource = readSource(fragmentPath);
 
-    if (!vertexShader.isValid() || !fragmentShader.isValid()) {
+    if (vertexSource.empty() || fragmentSource.empty()) {
         return nullptr;
     }
 
-    return std::make_unique<Shader>(vertexShader, fragmentShader);
+    return std::make_unique<Shader>(vertexSource.c_str(), fragmentSource.c_str());
+}
+
+std::string Shader::readSource(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "ERROR::SHADER::FILE_NOT_FOUND: " << path << std::endl;
+        return "";
+    }
+
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+// Restores the linked program from the binary cache when possible, otherwise compiles and stores it
+void Shader::build(const std::string& vertexSource, const std::string& fragmentSource) {
+    uint64_t sourceHash = 0;
+    if (programCache) {
+        // Length-prefix the stages so moving text between them changes the key
+        const uint64_t vertexSize = vertexSource.size();
+        sourceHash = hashBytes(&vertexSize, sizeof(vertexSize));
+        sourceHash = hashString(vertexSource, sourceHash);
+        sourceHash = hashString(fragmentSource, sourceHash);
+
+        program = programCache->load(sourceHash);
+        if (program != 0) {
+            valid = true;
+            return;
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource.c_str());
+    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource.c_str());
+
+    program = glCreateProgram();
+    if (programCache && programCache->isSupported()) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glAttachShader(program, vertexShader);
+    glAttachShader(program, fragmentShader);
+    glLinkProgram(program);
+    checkLinkErrors(program);
+
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+
+    if (programCache) {
+        const double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        programCache->recordMiss(millis);
+        if (valid) {
+            programCache->store(sourceHash, program, millis);
+        }
+    }
 }
 
 Shader::~Shader() {
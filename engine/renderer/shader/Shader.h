@@ -7,12 +7,14 @@
 #include "VertexShader.h"
 #include "FragmentShader.h"
 
+class ProgramCache;
+
 class Shader {
 public:
-    // Construct from raw source strings
+    // Construct from raw source strings; reuses a cached program binary when one matches
     Shader(const char* vertexSource, const char* fragmentSource);
 
-    // Construct from VertexShader and FragmentShader objects
+    // Construct from VertexShader and FragmentShader objects (already compiled, never cached)
     Shader(const VertexShader& vertexShader, const FragmentShader& fragmentShader);
 
     // Construct from a base path: expects files basePath + ".vert" and basePath + ".frag"
@@ -23,6 +25,13 @@ public:
 
     ~Shader();
 
+    Shader(const Shader&) = delete;
+    Shader& operator=(const Shader&) = delete;
+
+    // Cache that source-built shaders restore from and persist to; null disables caching
+    static void setProgramCache(ProgramCache* cache) { programCache = cache; }
+    static ProgramCache* getProgramCache() { return programCache; }
+
     void use() const;
     GLuint getProgram() const { return program; }
     bool isValid() const { return valid; }
@@ -38,6 +47,10 @@ private:
     GLuint program = 0;
     bool valid = false;
 
+    static ProgramCache* programCache;
+
+    void build(const std::string& vertexSource, const std::string& fragmentSource);
+    static std::string readSource(const std::string& path);
     void linkProgram(GLuint vertexShader, GLuint fragmentShader);
     GLuint compileShader(GLenum type, const char* source);
     void checkCompileErrors(GLuint shader, const std::string& type);
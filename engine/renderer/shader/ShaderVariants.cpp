@@ -0,0 +1,89 @@
+#include "ShaderVariants.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    std::string readFile(const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) {
+            std::cerr << "ERROR::SHADER_VARIANTS::FILE_NOT_FOUND: " << path << std::endl;
+            return "";
+        }
+
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+}
+
+ShaderVariants::ShaderVariants(const std::string& vertexPath, const std::string& fragmentPath)
+    : vertexPath(vertexPath), fragmentPath(fragmentPath) {}
+
+bool ShaderVariants::load() {
+    vertexSource = readFile(vertexPath);
+    fragmentSource = readFile(fragmentPath);
+    variants.clear();
+    return !vertexSource.empty() && !fragmentSource.empty();
+}
+
+void ShaderVariants::precompile(const std::vector<ShaderFeature>& set) {
+    for (ShaderFeature features : set) {
+        get(features);
+    }
+}
+
+Shader* ShaderVariants::get(ShaderFeature features) {
+    const uint32_t key = static_cast<uint32_t>(features);
+    if (auto it = variants.find(key); it != variants.end()) {
+        return it->second.get();
+    }
+
+    if (vertexSource.empty() || fragmentSource.empty()) return nullptr;
+
+    const std::string defines = definesFor(features);
+    const std::string vertex = inject(vertexSource, defines);
+    const std::string fragment = inject(fragmentSource, defines);
+
+    auto shader = std::make_unique<Shader>(vertex.c_str(), fragment.c_str());
+    if (!shader->isValid()) {
+        std::cerr << "ERROR::SHADER_VARIANTS::Failed to build variant of " << vertexPath << " with:\n" << defines << std::endl;
+        shader.reset();
+    }
+
+    // Failed variants are remembered as null so they are not rebuilt every frame
+    Shader* result = shader.get();
+    variants[key] = std::move(shader);
+    return result;
+}
+
+std::string ShaderVariants::definesFor(ShaderFeature features) {
+    std::string defines;
+    if (hasFeature(features, ShaderFeature::Textured)) defines += "#define TEXTURED\n";
+    if (hasFeature(features, ShaderFeature::Atlas)) defines += "#define ATLAS\n";
+    if (hasFeature(features, ShaderFeature::Instanced)) defines += "#define INSTANCED\n";
+    if (hasFeature(features, ShaderFeature::AlphaTest)) defines += "#define ALPHA_TEST\n";
+    if (hasFeature(features, ShaderFeature::VertexColour)) defines += "#define VERTEX_COLOUR\n";
+    return defines;
+}
+
+// #version must stay the first statement, so defines go right after it
+std::string ShaderVariants::inject(const std::string& source, const std::string& defines) {
+    if (defines.empty()) return source;
+
+    size_t insertAt = 0;
+    if (source.compare(0, 8, "#version") == 0) {
+        const size_t lineEnd = source.find('\n');
+        insertAt = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+    }
+
+    std::string result;
+    result.reserve(source.size() + defines.size() + 1);
+    result.append(source, 0, insertAt);
+    if (insertAt == source.size() && !source.empty() && source.back() != '\n') {
+        result += '\n';
+    }
+    result += defines;
+    result.append(source, insertAt, std::string::npos);
+    return result;
+}
@@ -0,0 +1,69 @@
+#ifndef ENGINE_SHADERVARIANTS_H
+#define ENGINE_SHADERVARIANTS_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Shader.h"
+
+// Compile-time features of a shader variant, injected as #defines after the #version line
+enum class ShaderFeature : uint32_t {
+    None = 0,
+    Textured = 1u << 0,   // TEXTURED: sample textureSampler, colour becomes a tint
+    Atlas = 1u << 1,      // ATLAS: remap UVs into the uvRect region
+    Instanced = 1u << 2,  // INSTANCED: position, size and colour come from per-instance attributes (QuadInstance)
+    AlphaTest = 1u << 3,  // ALPHA_TEST: discard fragments below ALPHA_CUTOFF
+    VertexColour = 1u << 4  // VERTEX_COLOUR: colour comes from a per-vertex attribute (pre-baked batches)
+};
+
+inline constexpr ShaderFeature operator|(ShaderFeature a, ShaderFeature b) {
+    return static_cast<ShaderFeature>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b));
+}
+
+inline constexpr ShaderFeature operator&(ShaderFeature a, ShaderFeature b) {
+    return static_cast<ShaderFeature>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b));
+}
+
+inline ShaderFeature& operator|=(ShaderFeature& a, ShaderFeature b) {
+    a = a | b;
+    return a;
+}
+
+inline constexpr bool hasFeature(ShaderFeature features, ShaderFeature feature) {
+    return (features & feature) != ShaderFeature::None;
+}
+
+// Permutations of one vertex/fragment source pair, one linked program per feature set
+// Variants are compiled on first use, or up front through precompile() for a declared set
+class ShaderVariants {
+public:
+    ShaderVariants(const std::string& vertexPath, const std::string& fragmentPath);
+
+    // Read the sources; variants can be requested afterwards
+    bool load();
+
+    // Compile every variant of a declared set now, so no compile stalls happen mid-frame
+    void precompile(const std::vector<ShaderFeature>& set);
+
+    // Program for a feature set, compiled on first request; null if it fails to build
+    Shader* get(ShaderFeature features);
+
+    size_t getVariantCount() const { return variants.size(); }
+
+    // #define lines for a feature set
+    static std::string definesFor(ShaderFeature features);
+
+private:
+    std::string vertexPath;
+    std::string fragmentPath;
+    std::string vertexSource;
+    std::string fragmentSource;
+    std::unordered_map<uint32_t, std::unique_ptr<Shader>> variants;
+
+    static std::string inject(const std::string& source, const std::string& defines);
+};
+
+#endif //ENGINE_SHADERVARIANTS_H
@@ -0,0 +1,67 @@
+#ifndef ENGINE_BAKEDTEXTURE_H
+#define ENGINE_BAKEDTEXTURE_H
+
+#include <cstdint>
+#include <string>
+
+// On-disk layout of a baked texture (.tex), produced offline by tools/texture_baker
+// Pixels are already flipped for OpenGL (origin bottom-left) and every mip level is stored,
+// so loading is a straight upload from a memory-mapped file with no decoding
+//
+// File layout: BakedTextureHeader, mipCount * BakedMipLevel, then the level data
+
+enum class BakedFormat : uint32_t {
+    R8 = 1,
+    RGB8 = 3,
+    RGBA8 = 4,
+    BC1 = 0x10,  // DXT1, opaque RGB
+    BC3 = 0x11   // DXT5, RGBA
+};
+
+struct BakedTextureHeader {
+    char magic[4];              // "TKTX"
+    uint32_t version;
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;          // channel count of the source image
+    BakedFormat format;
+    uint32_t mipCount;
+    uint32_t reserved;
+    uint64_t sourceLoadMicros;  // PNG decode + flip time measured by the baker
+};
+
+struct BakedMipLevel {
+    uint32_t width;
+    uint32_t height;
+    uint64_t offset;  // from the start of the file
+    uint64_t size;
+};
+
+inline constexpr char bakedTextureMagic[4] = {'T', 'K', 'T', 'X'};
+inline constexpr uint32_t bakedTextureVersion = 1;
+inline constexpr uint32_t bakedTextureMaxMips = 16;
+
+inline bool isCompressedFormat(BakedFormat format) {
+    return format == BakedFormat::BC1 || format == BakedFormat::BC3;
+}
+
+// Byte size of one mip level in the given format
+inline uint64_t bakedLevelSize(BakedFormat format, uint32_t width, uint32_t height) {
+    if (isCompressedFormat(format)) {
+        uint64_t blocks = static_cast<uint64_t>((width + 3) / 4) * ((height + 3) / 4);
+        return blocks * (format == BakedFormat::BC1 ? 8 : 16);
+    }
+    return static_cast<uint64_t>(width) * height * static_cast<uint32_t>(format);
+}
+
+// "textures/tank.png" -> "textures/tank.tex"
+inline std::string bakedPathFor(const std::string& sourcePath) {
+    const size_t dot = sourcePath.find_last_of('.');
+    const size_t slash = sourcePath.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return sourcePath + ".tex";
+    }
+    return sourcePath.substr(0, dot) + ".tex";
+}
+
+#endif //ENGINE_BAKEDTEXTURE_H
@@ -0,0 +1,88 @@
+#include "RenderTarget.h"
+#include <iostream>
+
+RenderTarget::RenderTarget(int width, int height) : width(width), height(height) {}
+
+std::unique_ptr<RenderTarget> RenderTarget::create(int width, int height, bool depth) {
+    std::unique_ptr<RenderTarget> target(new RenderTarget(width, height));
+
+    // Single level; nothing samples a render target minified far enough to need mips
+    target->colour = std::make_unique<Texture2D>(width, height, 4, nullptr, false);
+    if (!target->colour->isValid()) {
+        std::cerr << "ERROR::RENDER_TARGET::Failed to allocate colour texture" << std::endl;
+        return nullptr;
+    }
+
+    glGenFramebuffers(1, &target->FBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, target->FBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target->colour->getHandle(), 0);
+
+    if (depth) {
+        glGenRenderbuffers(1, &target->depthBuffer);
+        glBindRenderbuffer(GL_RENDERBUFFER, target->depthBuffer);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, target->depthBuffer);
+    }
+
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "ERROR::RENDER_TARGET::Framebuffer incomplete (0x" << std::hex << status << std::dec << ")" << std::endl;
+        return nullptr;
+    }
+    return target;
+}
+
+RenderTarget::~RenderTarget() {
+    if (FBO != 0) {
+        glDeleteFramebuffers(1, &FBO);
+    }
+    if (depthBuffer != 0) {
+        glDeleteRenderbuffers(1, &depthBuffer);
+    }
+}
+
+void RenderTarget::bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+    glViewport(0, 0, width, height);
+}
+
+void RenderTarget::unbind(int framebufferWidth, int framebufferHeight) {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, framebufferWidth, framebufferHeight);
+}
+
+void RenderTarget::clear(float r, float g, float b, float a) const {
+    glClearColor(r, g, b, a);
+    glClear(depthBuffer != 0 ? GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT : GL_COLOR_BUFFER_BIT);
+}
+
+void RenderTarget::copyFrom(const RenderTarget& source) const {
+    GLbitfield mask = GL_COLOR_BUFFER_BIT;
+    if (hasDepth() && source.hasDepth()) {
+        mask |= GL_DEPTH_BUFFER_BIT;
+    }
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, source.FBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, FBO);
+    // Depth blits must use NEAREST; sizes match so no filtering happens anyway
+    glBlitFramebuffer(0, 0, source.width, source.height, 0, 0, width, height, mask, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void RenderTarget::blitToScreen(int x, int y, int screenWidth, int screenHeight) const {
+    blitRegionToScreen(width, height, x, y, screenWidth, screenHeight);
+}
+
+void RenderTarget::blitRegionToScreen(int sourceWidth, int sourceHeight, int x, int y, int screenWidth, int screenHeight) const {
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, FBO);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, sourceWidth, sourceHeight, x, y, x + screenWidth, y + screenHeight, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+size_t RenderTarget::getGpuBytes() const {
+    const size_t depthBytes = depthBuffer != 0 ? static_cast<size_t>(width) * height * 4 : 0;
+    return colour->getGpuBytes() + depthBytes;
+}
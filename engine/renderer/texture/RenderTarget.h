@@ -0,0 +1,55 @@
+#ifndef ENGINE_RENDERTARGET_H
+#define ENGINE_RENDERTARGET_H
+
+#include <memory>
+#include <glad/glad.h>
+
+#include "Texture2D.h"
+
+// Offscreen framebuffer: an RGBA colour Texture2D plus an optional depth renderbuffer
+// The colour texture can be sampled like any other texture once rendering into it is done
+class RenderTarget {
+public:
+    // Returns nullptr when the framebuffer is incomplete
+    static std::unique_ptr<RenderTarget> create(int width, int height, bool depth = true);
+    ~RenderTarget();
+
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+
+    // Render into this target; also sets the viewport to cover it
+    void bind() const;
+
+    // Back to the window's framebuffer
+    static void unbind(int framebufferWidth, int framebufferHeight);
+
+    void clear(float r, float g, float b, float a) const;
+
+    // Copy the colour (and depth, when both have one) of a same-sized target into this one
+    void copyFrom(const RenderTarget& source) const;
+
+    // Copy the colour into a rect of the window's framebuffer (pixels, bottom-left origin)
+    void blitToScreen(int x, int y, int screenWidth, int screenHeight) const;
+
+    // Same, from only the bottom-left sourceWidth x sourceHeight pixels (a target rendered at reduced size)
+    void blitRegionToScreen(int sourceWidth, int sourceHeight, int x, int y, int screenWidth, int screenHeight) const;
+
+    Texture2D& getColour() { return *colour; }
+    const Texture2D& getColour() const { return *colour; }
+    GLuint getHandle() const { return FBO; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    bool hasDepth() const { return depthBuffer != 0; }
+    size_t getGpuBytes() const;
+
+private:
+    RenderTarget(int width, int height);
+
+    GLuint FBO = 0;
+    GLuint depthBuffer = 0;
+    std::unique_ptr<Texture2D> colour;
+    int width;
+    int height;
+};
+
+#endif //ENGINE_RENDERTARGET_H
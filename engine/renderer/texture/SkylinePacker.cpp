@@ -0,0 +1,88 @@
+#include "SkylinePacker.h"
+#include <algorithm>
+#include <climits>
+
+SkylinePacker::SkylinePacker(int width, int height) {
+    reset(width, height);
+}
+
+void SkylinePacker::reset(int newWidth, int newHeight) {
+    width = newWidth;
+    height = newHeight;
+    usedArea = 0;
+    skyline.clear();
+    skyline.push_back({0, 0, width});
+}
+
+bool SkylinePacker::insert(int rectWidth, int rectHeight, int& outX, int& outY) {
+    int bestTop = INT_MAX;
+    int bestWidth = INT_MAX;
+    size_t bestIndex = skyline.size();
+
+    for (size_t i = 0; i < skyline.size(); ++i) {
+        int y = fit(i, rectWidth, rectHeight);
+        if (y < 0) continue;
+
+        // Lowest top edge wins, narrower segment breaks ties (less wasted space)
+        int top = y + rectHeight;
+        if (top < bestTop || (top == bestTop && skyline[i].width < bestWidth)) {
+            bestTop = top;
+            bestWidth = skyline[i].width;
+            bestIndex = i;
+            outX = skyline[i].x;
+            outY = y;
+        }
+    }
+
+    if (bestIndex == skyline.size()) {
+        return false;
+    }
+
+    addSegment(bestIndex, outX, outY, rectWidth, rectHeight);
+    usedArea += static_cast<long long>(rectWidth) * rectHeight;
+    return true;
+}
+
+int SkylinePacker::fit(size_t index, int rectWidth, int rectHeight) const {
+    int x = skyline[index].x;
+    if (x + rectWidth > width) return -1;
+
+    // The rect rests on the highest segment it spans
+    int y = 0;
+    int remaining = rectWidth;
+    for (size_t i = index; remaining > 0; ++i) {
+        if (i >= skyline.size()) return -1;
+        y = std::max(y, skyline[i].y);
+        if (y + rectHeight > height) return -1;
+        remaining -= skyline[i].width;
+    }
+    return y;
+}
+
+void SkylinePacker::addSegment(size_t index, int x, int y, int rectWidth, int rectHeight) {
+    skyline.insert(skyline.begin() + static_cast<long>(index), {x, y + rectHeight, rectWidth});
+
+    // Trim or remove the segments now covered by the new one
+    for (size_t i = index + 1; i < skyline.size();) {
+        const Segment& previous = skyline[i - 1];
+        Segment& current = skyline[i];
+        int previousEnd = previous.x + previous.width;
+        if (current.x >= previousEnd) break;
+
+        int shrink = previousEnd - current.x;
+        current.x += shrink;
+        current.width -= shrink;
+        if (current.width > 0) break;
+        skyline.erase(skyline.begin() + static_cast<long>(i));
+    }
+
+    // Merge neighbours at the same height
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + static_cast<long>(i) + 1);
+        } else {
+            ++i;
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef ENGINE_SKYLINEPACKER_H
+#define ENGINE_SKYLINEPACKER_H
+
+#include <cstddef>
+#include <vector>
+
+// Rectangle packer using the skyline bottom-left heuristic
+// Keeps the top edge of the packed area as a list of horizontal segments
+// and places each rectangle where its top ends up lowest
+class SkylinePacker {
+public:
+    SkylinePacker(int width, int height);
+
+    void reset(int width, int height);
+
+    // Returns false when the rectangle does not fit
+    bool insert(int rectWidth, int rectHeight, int& outX, int& outY);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    long long getUsedArea() const { return usedArea; }
+
+private:
+    struct Segment {
+        int x;
+        int y;
+        int width;
+    };
+
+    int width;
+    int height;
+    long long usedArea = 0;
+    std::vector<Segment> skyline;
+
+    // Lowest y at which a rect of the given size can sit starting at segment index, or -1
+    int fit(size_t index, int rectWidth, int rectHeight) const;
+    void addSegment(size_t index, int x, int y, int rectWidth, int rectHeight);
+};
+
+#endif //ENGINE_SKYLINEPACKER_H
@@ -1,12 +1,96 @@
 #include "Texture2D.h"
+#include "BakedTexture.h"
+#include "assets/MappedFile.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <vector>
 
 // stb_image implementation - only define once in the entire project
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
+// S3TC enums are an extension, not part of the core profile headers
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+TextureLoadStats Texture2D::loadStats;
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    double millisSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    bool hasExtension(const std::string& path, const char* extension) {
+        return std::filesystem::path(path).extension() == extension;
+    }
+
+    // A baked file is only used while it is at least as new as its source image
+    bool isBakeCurrent(const std::string& sourcePath, const std::string& bakedPath) {
+        std::error_code ec;
+        const auto bakedTime = std::filesystem::last_write_time(bakedPath, ec);
+        if (ec) return false;
+        const auto sourceTime = std::filesystem::last_write_time(sourcePath, ec);
+        return ec || bakedTime >= sourceTime;
+    }
+
+    // Uncompressed size of a mip chain; drivers store 3-channel textures padded to 4 bytes per texel
+    size_t mipChainBytes(int width, int height, int channels, int levels) {
+        const size_t bytesPerTexel = channels == 3 ? 4 : static_cast<size_t>(channels);
+        size_t total = 0;
+        for (int level = 0; level < levels; ++level) {
+            total += static_cast<size_t>(width) * static_cast<size_t>(height) * bytesPerTexel;
+            width = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+        }
+        return total;
+    }
+}
+
 Texture2D::Texture2D(const std::string& filePath) : filePath(filePath) {
-    loadFromFile(filePath);
+    std::unique_ptr<TextureData> data = decode(filePath);
+    upload(*data);
+}
+
+Texture2D::Texture2D(const std::string& filePath, TextureData& data) : filePath(filePath) {
+    upload(data);
+}
+
+Texture2D::Texture2D(int width, int height, int channels, const unsigned char* pixels, bool mipmaps)
+    : width(width), height(height), channels(channels) {
+    const GLenum format = formatForChannels(channels);
+
+    glGenTextures(1, &handle);
+    glBindTexture(GL_TEXTURE_2D, handle);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(format), width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    mipLevels = 1;
+    if (mipmaps) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+        for (int size = std::max(width, height); size > 1; size /= 2) {
+            mipLevels++;
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    gpuBytes = mipChainBytes(width, height, channels, mipLevels);
+    valid = true;
 }
 
 Texture2D::~Texture2D() {
@@ -15,18 +99,191 @@ Texture2D::~Texture2D() {
     }
 }
 
-void Texture2D::loadFromFile(const std::string& path) {
-    // Flip image vertically (OpenGL expects origin at bottom-left)
-    stbi_set_flip_vertically_on_load(true);
+void ImageDeleter::operator()(unsigned char* pixels) const {
+    stbi_image_free(pixels);
+}
+
+std::unique_ptr<TextureData> Texture2D::decode(const std::string& path) {
+    auto data = std::make_unique<TextureData>();
+    const auto start = Clock::now();
 
-    unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
-    if (!data) {
+    if (hasExtension(path, ".tex")) {
+        if (!parseBaked(path, *data)) {
+            std::cerr << "ERROR::TEXTURE2D::Failed to load baked texture: " << path << std::endl;
+        }
+    } else {
+        // Prefer a baked sibling when the baker has produced one and the PNG has not been edited since
+        const std::string bakedPath = bakedPathFor(path);
+        if (!isBakeCurrent(path, bakedPath) || !parseBaked(bakedPath, *data)) {
+            decodeImage(path, *data);
+        }
+    }
+
+    data->decodeMillis = millisSince(start);
+    return data;
+}
+
+bool Texture2D::parseBaked(const std::string& path, TextureData& data) {
+    auto file = std::make_unique<MappedFile>(path);
+    if (!file->isValid() || file->getSize() < sizeof(BakedTextureHeader)) {
+        return false;
+    }
+
+    BakedTextureHeader header;
+    std::memcpy(&header, file->getData(), sizeof(header));
+    if (std::memcmp(header.magic, bakedTextureMagic, sizeof(header.magic)) != 0 ||
+        header.version != bakedTextureVersion ||
+        header.mipCount == 0 || header.mipCount > bakedTextureMaxMips) {
+        std::cerr << "ERROR::TEXTURE2D::Invalid baked texture header: " << path << std::endl;
+        return false;
+    }
+
+    const size_t tableEnd = sizeof(header) + header.mipCount * sizeof(BakedMipLevel);
+    if (file->getSize() < tableEnd) {
+        return false;
+    }
+
+    std::memcpy(data.levels, file->getData() + sizeof(header), header.mipCount * sizeof(BakedMipLevel));
+    for (uint32_t i = 0; i < header.mipCount; ++i) {
+        const BakedMipLevel& level = data.levels[i];
+        if (level.offset + level.size > file->getSize() ||
+            level.size < bakedLevelSize(header.format, level.width, level.height)) {
+            std::cerr << "ERROR::TEXTURE2D::Truncated baked texture: " << path << std::endl;
+            return false;
+        }
+    }
+
+    data.path = path;
+    data.header = header;
+    data.file = std::move(file);
+    data.width = static_cast<int>(header.width);
+    data.height = static_cast<int>(header.height);
+    data.channels = static_cast<int>(header.channels);
+    data.baked = true;
+    data.valid = true;
+    return true;
+}
+
+bool Texture2D::decodeImage(const std::string& path, TextureData& data) {
+    unsigned char* pixels = stbi_load(path.c_str(), &data.width, &data.height, &data.channels, 0);
+    if (!pixels) {
         std::cerr << "ERROR::TEXTURE2D::Failed to load texture: " << path << std::endl;
         std::cerr << "  Reason: " << stbi_failure_reason() << std::endl;
+        data.valid = false;
+        return false;
+    }
+
+    // Flip image vertically (OpenGL expects origin at bottom-left)
+    // Done here rather than through stb's process-wide flag so decoding is safe on worker threads
+    const size_t rowBytes = static_cast<size_t>(data.width) * data.channels;
+    for (int top = 0, bottom = data.height - 1; top < bottom; ++top, --bottom) {
+        std::swap_ranges(pixels + top * rowBytes, pixels + (top + 1) * rowBytes, pixels + bottom * rowBytes);
+    }
+
+    data.path = path;
+    data.pixels.reset(pixels);
+    data.baked = false;
+    data.valid = true;
+    return true;
+}
+
+void Texture2D::upload(TextureData& data) {
+    if (!data.valid) {
         valid = false;
         return;
     }
 
+    if (data.baked && !uploadBaked(data)) {
+        // Block compressed file the context cannot sample; fall back to the source image
+        if (hasExtension(filePath, ".tex") || !decodeImage(filePath, data)) {
+            valid = false;
+            return;
+        }
+    }
+
+    if (!data.baked) {
+        uploadImage(data);
+    }
+}
+
+bool Texture2D::uploadBaked(const TextureData& data) {
+    const auto start = Clock::now();
+    const BakedTextureHeader& header = data.header;
+
+    GLenum internalFormat = GL_RGBA;
+    GLenum dataFormat = GL_RGBA;
+    switch (header.format) {
+        case BakedFormat::R8:    internalFormat = GL_RED;  dataFormat = GL_RED;  break;
+        case BakedFormat::RGB8:  internalFormat = GL_RGB;  dataFormat = GL_RGB;  break;
+        case BakedFormat::RGBA8: internalFormat = GL_RGBA; dataFormat = GL_RGBA; break;
+        case BakedFormat::BC1:   internalFormat = GL_COMPRESSED_RGB_S3TC_DXT1_EXT;  break;
+        case BakedFormat::BC3:   internalFormat = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT; break;
+        default:
+            return false;
+    }
+
+    if (isCompressedFormat(header.format) && !supportsCompressedFormat(internalFormat)) {
+        return false;
+    }
+
+    compressed = isCompressedFormat(header.format);
+
+    glGenTextures(1, &handle);
+    glBindTexture(GL_TEXTURE_2D, handle);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, header.mipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(header.mipCount - 1));
+
+    // Tightly packed rows (RGB and R8 levels are not 4-byte aligned)
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    gpuBytes = 0;
+    for (uint32_t i = 0; i < header.mipCount; ++i) {
+        const BakedMipLevel& level = data.levels[i];
+        gpuBytes += compressed ? level.size : mipChainBytes(static_cast<int>(level.width), static_cast<int>(level.height),
+                                                            static_cast<int>(header.format), 1);
+        const unsigned char* pixels = data.file->getData() + level.offset;
+        if (compressed) {
+            glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), internalFormat,
+                                   static_cast<GLsizei>(level.width), static_cast<GLsizei>(level.height), 0,
+                                   static_cast<GLsizei>(level.size), pixels);
+        } else {
+            glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i), static_cast<GLint>(internalFormat),
+                         static_cast<GLsizei>(level.width), static_cast<GLsizei>(level.height), 0,
+                         dataFormat, GL_UNSIGNED_BYTE, pixels);
+        }
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    width = data.width;
+    height = data.height;
+    channels = data.channels;
+    mipLevels = static_cast<int>(header.mipCount);
+    baked = true;
+    valid = true;
+    loadMillis = data.decodeMillis + millisSince(start);
+
+    const double sourceMillis = static_cast<double>(header.sourceLoadMicros) / 1000.0;
+    loadStats.bakedLoads++;
+    loadStats.bakedMillis += loadMillis;
+    loadStats.bakedSourceMillis += sourceMillis;
+
+    std::cout << "Loaded baked texture: " << data.path << " (" << width << "x" << height << ", "
+              << mipLevels << " mips, " << loadMillis << " ms vs " << sourceMillis << " ms from PNG)" << std::endl;
+    return true;
+}
+
+void Texture2D::uploadImage(const TextureData& data) {
+    const auto start = Clock::now();
+
+    width = data.width;
+    height = data.height;
+    channels = data.channels;
+
     // Determine format based on channels
     GLenum internalFormat = GL_RGB;
     GLenum dataFormat = GL_RGB;
@@ -51,16 +308,24 @@ void Texture2D::loadFromFile(const std::string& path) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     // Upload texture data
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, dataFormat, GL_UNSIGNED_BYTE, data);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, dataFormat, GL_UNSIGNED_BYTE, data.pixels.get());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     glGenerateMipmap(GL_TEXTURE_2D);
 
     glBindTexture(GL_TEXTURE_2D, 0);
 
-    // Free image data
-    stbi_image_free(data);
-
     valid = true;
-    std::cout << "Loaded texture: " << path << " (" << width << "x" << height << ", " << channels << " channels)" << std::endl;
+    mipLevels = 1;
+    for (int size = std::max(width, height); size > 1; size /= 2) {
+        mipLevels++;
+    }
+    gpuBytes = mipChainBytes(width, height, channels, mipLevels);
+    loadMillis = data.decodeMillis + millisSince(start);
+    loadStats.imageLoads++;
+    loadStats.imageMillis += loadMillis;
+
+    std::cout << "Loaded texture: " << data.path << " (" << width << "x" << height << ", " << channels << " channels)" << std::endl;
 }
 
 void Texture2D::bind(unsigned int unit) const {
@@ -91,3 +356,50 @@ void Texture2D::generateMipmaps() {
     glGenerateMipmap(GL_TEXTURE_2D);
     glBindTexture(GL_TEXTURE_2D, 0);
 }
+
+void Texture2D::setMaxMipLevel(int level) {
+    glBindTexture(GL_TEXTURE_2D, handle);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void Texture2D::updateRegion(int x, int y, int regionWidth, int regionHeight, const unsigned char* pixels) {
+    if (!valid || compressed) return;
+
+    glBindTexture(GL_TEXTURE_2D, handle);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, regionWidth, regionHeight, formatForChannels(channels), GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    if (mipLevels > 1) {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+GLenum Texture2D::formatForChannels(int channels) {
+    switch (channels) {
+        case 1: return GL_RED;
+        case 3: return GL_RGB;
+        default: return GL_RGBA;
+    }
+}
+
+bool Texture2D::supportsCompressedFormat(GLenum format) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+    if (count <= 0) return false;
+
+    std::vector<GLint> formats(static_cast<size_t>(count));
+    glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+    return std::find(formats.begin(), formats.end(), static_cast<GLint>(format)) != formats.end();
+}
+
+void Texture2D::reportLoadStats(std::ostream& out) {
+    out << "Texture load stats:" << std::endl;
+    out << "  PNG path:   " << loadStats.imageLoads << " textures, " << loadStats.imageMillis << " ms" << std::endl;
+    out << "  Baked path: " << loadStats.bakedLoads << " textures, " << loadStats.bakedMillis << " ms" << std::endl;
+    if (loadStats.bakedLoads > 0) {
+        out << "  Saved by baking: " << (loadStats.bakedSourceMillis - loadStats.bakedMillis)
+            << " ms (" << loadStats.bakedSourceMillis << " ms through the PNG path)" << std::endl;
+    }
+}
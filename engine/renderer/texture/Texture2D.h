@@ -1,9 +1,16 @@
 #ifndef ENGINE_TEXTURE2D_H
 #define ENGINE_TEXTURE2D_H
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
 #include <string>
 #include <glad/glad.h>
 
+#include "BakedTexture.h"
+#include "assets/MappedFile.h"
+
 // Texture wrapping modes
 enum class TextureWrap {
     Repeat = GL_REPEAT,
@@ -22,13 +29,60 @@ enum class TextureFilter {
     LinearMipmapLinear = GL_LINEAR_MIPMAP_LINEAR
 };
 
+// Aggregate load timings, split by the path a texture was loaded through
+struct TextureLoadStats {
+    int imageLoads = 0;           // decoded through stb_image
+    double imageMillis = 0.0;
+    int bakedLoads = 0;           // uploaded from a baked .tex file
+    double bakedMillis = 0.0;
+    double bakedSourceMillis = 0.0;  // what the baked textures cost through the PNG path (measured by the baker)
+};
+
+// Frees pixels returned by stb_image
+struct ImageDeleter {
+    void operator()(unsigned char* pixels) const;
+};
+
+// CPU half of a file load: either decoded pixels or a mapped baked file
+// Produced by Texture2D::decode, which touches no GL state and may run on any thread
+struct TextureData {
+    std::string path;   // file actually read (the baked sibling when one was used)
+    bool valid = false;
+    bool baked = false;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    double decodeMillis = 0.0;
+
+    // Baked files
+    std::unique_ptr<MappedFile> file;
+    BakedTextureHeader header {};
+    BakedMipLevel levels[bakedTextureMaxMips] {};
+
+    // Decoded images, rows already flipped for GL
+    std::unique_ptr<unsigned char, ImageDeleter> pixels;
+};
+
 // Texture2D class - loads and manages a 2D texture from file
+// A baked .tex file next to the source image (or passed directly) is preferred over decoding the image
 class Texture2D {
 public:
     // Load texture from file path
     explicit Texture2D(const std::string& filePath);
+
+    // Upload data produced by decode(); must run on the GL thread
+    Texture2D(const std::string& filePath, TextureData& data);
+
+    // Read and decode a texture file without touching GL (thread-safe)
+    static std::unique_ptr<TextureData> decode(const std::string& filePath);
+
+    // Create from raw, already flipped pixels (1, 3 or 4 channels); pixels may be null to allocate only
+    Texture2D(int width, int height, int channels, const unsigned char* pixels, bool mipmaps = true);
     ~Texture2D();
 
+    Texture2D(const Texture2D&) = delete;
+    Texture2D& operator=(const Texture2D&) = delete;
+
     // Bind texture to a texture unit (default: 0)
     void bind(unsigned int unit = 0) const;
     
@@ -41,6 +95,10 @@ public:
     int getWidth() const { return width; }
     int getHeight() const { return height; }
     int getChannels() const { return channels; }
+    int getMipLevels() const { return mipLevels; }
+    bool isBaked() const { return baked; }
+    double getLoadMillis() const { return loadMillis; }
+    size_t getGpuBytes() const { return gpuBytes; }  // all mip levels as stored by the driver
     const std::string& getFilePath() const { return filePath; }
 
     // Set texture parameters
@@ -50,15 +108,40 @@ public:
     // Generate mipmaps (call after loading if using mipmap filters)
     void generateMipmaps();
 
+    // Limit sampling to the first levels (e.g. to stop atlas regions bleeding at small mips)
+    void setMaxMipLevel(int level);
+
+    // Replace a rectangle of level 0 with tightly packed pixels in the texture's own format
+    void updateRegion(int x, int y, int regionWidth, int regionHeight, const unsigned char* pixels);
+
+    // Load timings of every texture loaded so far
+    static const TextureLoadStats& getLoadStats() { return loadStats; }
+    static void reportLoadStats(std::ostream& out);
+
 private:
     GLuint handle = 0;
     bool valid = false;
+    bool baked = false;
+    bool compressed = false;
     int width = 0;
     int height = 0;
     int channels = 0;
+    int mipLevels = 0;
+    double loadMillis = 0.0;
+    size_t gpuBytes = 0;
     std::string filePath;
 
-    void loadFromFile(const std::string& path);
+    static TextureLoadStats loadStats;
+
+    void upload(TextureData& data);
+    bool uploadBaked(const TextureData& data);
+    void uploadImage(const TextureData& data);
+
+    static bool parseBaked(const std::string& path, TextureData& data);
+    static bool decodeImage(const std::string& path, TextureData& data);
+
+    static bool supportsCompressedFormat(GLenum format);
+    static GLenum formatForChannels(int channels);
 };
 
 #endif //ENGINE_TEXTURE2D_H
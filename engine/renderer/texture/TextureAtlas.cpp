@@ -0,0 +1,222 @@
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+
+#include "stb_image.h"
+
+TextureAtlas::TextureAtlas(int maxPageSize, int padding) : maxPageSize(maxPageSize), padding(padding) {}
+
+void TextureAtlas::add(const std::string& name, const std::string& path) {
+    for (auto& source : sources) {
+        if (source.name == name) {
+            source.path = path;
+            return;
+        }
+    }
+    sources.push_back({name, path});
+}
+
+UVRect TextureAtlas::getRegion(const std::string& name) const {
+    auto it = regions.find(name);
+    return it != regions.end() ? it->second.uv : UVRect{};
+}
+
+bool TextureAtlas::decode(Source& source) {
+    int channels = 0;
+    unsigned char* data = stbi_load(source.path.c_str(), &source.width, &source.height, &channels, 4);
+    if (!data) {
+        std::cerr << "ERROR::TEXTURE_ATLAS::Failed to load image: " << source.path << std::endl;
+        std::cerr << "  Reason: " << stbi_failure_reason() << std::endl;
+        return false;
+    }
+
+    // Flip rows while copying (OpenGL expects origin at bottom-left); stb's process-wide flip flag
+    // would also flip images decoded concurrently by Texture2D on other threads
+    const size_t rowBytes = static_cast<size_t>(source.width) * 4;
+    source.pixels.resize(rowBytes * source.height);
+    for (int row = 0; row < source.height; ++row) {
+        std::memcpy(&source.pixels[row * rowBytes], data + static_cast<size_t>(source.height - 1 - row) * rowBytes, rowBytes);
+    }
+    stbi_image_free(data);
+
+    std::error_code ec;
+    source.modified = std::filesystem::last_write_time(source.path, ec);
+    return true;
+}
+
+bool TextureAtlas::build() {
+    for (auto& source : sources) {
+        if (!decode(source)) return false;
+    }
+    return layout();
+}
+
+bool TextureAtlas::layout() {
+    // Start from the smallest power of two that could hold everything and grow until it fits
+    long long totalArea = 0;
+    for (const auto& source : sources) {
+        totalArea += static_cast<long long>(source.width + 2 * padding) * (source.height + 2 * padding);
+    }
+    int size = 64;
+    while (size < maxPageSize && static_cast<long long>(size) * size < totalArea) {
+        size *= 2;
+    }
+
+    while (!pack(size)) {
+        if (size >= maxPageSize) {
+            std::cerr << "ERROR::TEXTURE_ATLAS::Images do not fit in a " << maxPageSize << "x" << maxPageSize << " page" << std::endl;
+            return false;
+        }
+        size *= 2;
+    }
+
+    pageSize = size;
+    page.assign(static_cast<size_t>(pageSize) * pageSize * 4, 0);
+    for (const auto& [name, region] : regions) {
+        blit(region);
+    }
+
+    texture = std::make_unique<Texture2D>(pageSize, pageSize, 4, page.data());
+    // Each mip halves the padding; stop before neighbouring regions start to bleed in
+    int maxLevel = 0;
+    for (int p = padding; p > 1; p /= 2) {
+        maxLevel++;
+    }
+    texture->setMaxMipLevel(maxLevel);
+
+    version++;
+    stats.fullBuilds++;
+    updateStats();
+    return true;
+}
+
+bool TextureAtlas::pack(int size) {
+    regions.clear();
+    SkylinePacker packer(size, size);
+
+    // Tallest first keeps the skyline flat
+    std::vector<size_t> order(sources.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return sources[a].height > sources[b].height;
+    });
+
+    for (size_t index : order) {
+        const Source& source = sources[index];
+        int x = 0, y = 0;
+        if (!packer.insert(source.width + 2 * padding, source.height + 2 * padding, x, y)) {
+            return false;
+        }
+
+        Region region;
+        region.source = index;
+        region.x = x + padding;
+        region.y = y + padding;
+        region.slotWidth = source.width;
+        region.slotHeight = source.height;
+        region.uv = {
+            static_cast<float>(region.x) / size,
+            static_cast<float>(region.y) / size,
+            static_cast<float>(source.width) / size,
+            static_cast<float>(source.height) / size
+        };
+        regions[source.name] = region;
+    }
+    return true;
+}
+
+// Copies a source into the CPU page, extruding its edge pixels into the padding
+void TextureAtlas::blit(const Region& region) {
+    const Source& source = sources[region.source];
+
+    for (int y = -padding; y < region.slotHeight + padding; ++y) {
+        const int srcY = std::clamp(y, 0, source.height - 1);
+        for (int x = -padding; x < region.slotWidth + padding; ++x) {
+            const int srcX = std::clamp(x, 0, source.width - 1);
+            const bool inside = x < source.width + padding && y < source.height + padding;
+            unsigned char* dst = &page[(static_cast<size_t>(region.y + y) * pageSize + region.x + x) * 4];
+            if (inside) {
+                std::memcpy(dst, &source.pixels[(static_cast<size_t>(srcY) * source.width + srcX) * 4], 4);
+            } else {
+                std::memset(dst, 0, 4);
+            }
+        }
+    }
+}
+
+void TextureAtlas::uploadRegion(const Region& region) {
+    const int x0 = region.x - padding;
+    const int y0 = region.y - padding;
+    const int w = region.slotWidth + 2 * padding;
+    const int h = region.slotHeight + 2 * padding;
+
+    std::vector<unsigned char> pixels(static_cast<size_t>(w) * h * 4);
+    for (int row = 0; row < h; ++row) {
+        std::memcpy(&pixels[static_cast<size_t>(row) * w * 4],
+                    &page[(static_cast<size_t>(y0 + row) * pageSize + x0) * 4],
+                    static_cast<size_t>(w) * 4);
+    }
+    texture->updateRegion(x0, y0, w, h, pixels.data());
+}
+
+bool TextureAtlas::refresh() {
+    if (!texture) return build();
+
+    std::vector<size_t> changed;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        std::error_code ec;
+        auto modified = std::filesystem::last_write_time(sources[i].path, ec);
+        if (!ec && modified != sources[i].modified) {
+            changed.push_back(i);
+        }
+    }
+    if (changed.empty()) return true;
+
+    bool needsRepack = false;
+    for (size_t index : changed) {
+        Source& source = sources[index];
+        if (!decode(source)) return false;
+
+        auto it = regions.find(source.name);
+        if (it == regions.end() || source.width > it->second.slotWidth || source.height > it->second.slotHeight) {
+            needsRepack = true;
+        }
+    }
+
+    if (needsRepack) {
+        return layout();
+    }
+
+    for (size_t index : changed) {
+        Region& region = regions[sources[index].name];
+        region.uv.width = static_cast<float>(sources[index].width) / pageSize;
+        region.uv.height = static_cast<float>(sources[index].height) / pageSize;
+        blit(region);
+        uploadRegion(region);
+        stats.inPlaceUpdates++;
+    }
+
+    version++;
+    updateStats();
+    return true;
+}
+
+void TextureAtlas::updateStats() {
+    stats.images = static_cast<int>(sources.size());
+    stats.pageWidth = texture ? texture->getWidth() : 0;
+    stats.pageHeight = texture ? texture->getHeight() : 0;
+    stats.usedPixels = 0;
+    for (const auto& source : sources) {
+        stats.usedPixels += static_cast<long long>(source.width) * source.height;
+    }
+    const long long pageArea = static_cast<long long>(stats.pageWidth) * stats.pageHeight;
+    stats.efficiency = pageArea > 0 ? static_cast<float>(stats.usedPixels) / static_cast<float>(pageArea) : 0.0f;
+}
+
+void TextureAtlas::reportStats(std::ostream& out) const {
+    out << "Texture atlas: " << stats.images << " images in " << stats.pageWidth << "x" << stats.pageHeight
+        << ", " << stats.efficiency * 100.0f << "% packed (" << stats.fullBuilds << " builds, "
+        << stats.inPlaceUpdates << " in-place updates)" << std::endl;
+}
@@ -0,0 +1,96 @@
+#ifndef ENGINE_TEXTUREATLAS_H
+#define ENGINE_TEXTUREATLAS_H
+
+#include <filesystem>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SkylinePacker.h"
+#include "Texture2D.h"
+
+// Sub-rectangle of a texture in UV space: offset (u, v) and size (width, height)
+struct UVRect {
+    float u = 0.0f;
+    float v = 0.0f;
+    float width = 1.0f;
+    float height = 1.0f;
+};
+
+struct TextureAtlasStats {
+    int images = 0;
+    int pageWidth = 0;
+    int pageHeight = 0;
+    long long usedPixels = 0;     // image pixels, excluding padding
+    float efficiency = 0.0f;      // usedPixels / page area
+    int fullBuilds = 0;
+    int inPlaceUpdates = 0;       // changed images re-uploaded without repacking
+};
+
+// Packs many small images into one RGBA texture at load time
+// Regions are looked up by name and resolve to a UV rect inside the atlas texture
+class TextureAtlas {
+public:
+    explicit TextureAtlas(int maxPageSize = 4096, int padding = 2);
+
+    // Register a source image; call build() afterwards
+    void add(const std::string& name, const std::string& path);
+
+    // Decode all sources, pack them and upload the page
+    bool build();
+
+    // Re-decode sources whose files changed on disk since the last build/refresh
+    // Images that still fit their slot are re-uploaded in place, otherwise the atlas is repacked
+    bool refresh();
+
+    bool contains(const std::string& name) const { return regions.contains(name); }
+    UVRect getRegion(const std::string& name) const;
+
+    Texture2D* getTexture() { return texture.get(); }
+    const Texture2D* getTexture() const { return texture.get(); }
+
+    // Bumped whenever region UVs may have moved (full rebuilds)
+    unsigned int getVersion() const { return version; }
+
+    const TextureAtlasStats& getStats() const { return stats; }
+    void reportStats(std::ostream& out) const;
+
+private:
+    struct Source {
+        std::string name;
+        std::string path;
+        std::filesystem::file_time_type modified;
+        int width = 0;
+        int height = 0;
+        std::vector<unsigned char> pixels;  // RGBA, flipped for GL
+    };
+
+    struct Region {
+        size_t source;
+        int x, y;                 // top-left of the image inside its padded slot
+        int slotWidth, slotHeight;  // image area reserved in the slot
+        UVRect uv;
+    };
+
+    int maxPageSize;
+    int padding;
+    int pageSize = 0;
+    unsigned int version = 0;
+
+    std::vector<Source> sources;
+    std::unordered_map<std::string, Region> regions;
+    std::vector<unsigned char> page;   // CPU copy of the page, RGBA
+    std::unique_ptr<Texture2D> texture;
+    TextureAtlasStats stats;
+
+    bool decode(Source& source);
+    bool layout();
+    bool pack(int size);
+    void blit(const Region& region);
+    void uploadRegion(const Region& region);
+    void updateStats();
+};
+
+#endif //ENGINE_TEXTUREATLAS_H
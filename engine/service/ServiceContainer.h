@@ -7,10 +7,17 @@
 
 #include "input/InputManager.h"
 #include "assets/AssetManager.h"
+#include "collision/CollisionWorld.h"
+#include "physics/PhysicsWorld.h"
+#include "projectiles/ProjectileSystem.h"
+#include "pathfinding/PathfindingService.h"
+#include "raycast/RaycastService.h"
+#include "jobs/JobSystem.h"
 
 // Resource container for non-service dependencies (e.g., window, renderer)
 struct IEngineResources {
     GLFWwindow* window;
+    JobSystem* jobs = nullptr;
 };
 
 // Service traits - specialize for services that need constructor parameters
@@ -21,7 +28,7 @@ struct ServiceTraits {
     }
 };
 
-// Specialization for InputManager - requires GLFWwindow*
+// Specialization for InputManager - takes the GLFWwindow* (null for headless runs: no live input)
 template<>
 struct ServiceTraits<InputManager> {
     static std::unique_ptr<InputManager> create(const IEngineResources& resources) {
@@ -29,6 +36,54 @@ struct ServiceTraits<InputManager> {
     }
 };
 
+// Specialization for AssetManager - decodes preloads on the shared job system
+template<>
+struct ServiceTraits<AssetManager> {
+    static std::unique_ptr<AssetManager> create(const IEngineResources& resources) {
+        return std::make_unique<AssetManager>(resources.jobs);
+    }
+};
+
+// Specialization for CollisionWorld - sweeps large worlds on the shared job system
+template<>
+struct ServiceTraits<CollisionWorld> {
+    static std::unique_ptr<CollisionWorld> create(const IEngineResources& resources) {
+        return std::make_unique<CollisionWorld>(resources.jobs);
+    }
+};
+
+// Specialization for PhysicsWorld - solves islands on the shared job system
+template<>
+struct ServiceTraits<PhysicsWorld> {
+    static std::unique_ptr<PhysicsWorld> create(const IEngineResources& resources) {
+        return std::make_unique<PhysicsWorld>(resources.jobs);
+    }
+};
+
+// Specialization for ProjectileSystem - sweeps large volleys on the shared job system
+template<>
+struct ServiceTraits<ProjectileSystem> {
+    static std::unique_ptr<ProjectileSystem> create(const IEngineResources& resources) {
+        return std::make_unique<ProjectileSystem>(resources.jobs);
+    }
+};
+
+// Specialization for RaycastService - runs query batches on the shared job system
+template<>
+struct ServiceTraits<RaycastService> {
+    static std::unique_ptr<RaycastService> create(const IEngineResources& resources) {
+        return std::make_unique<RaycastService>(resources.jobs);
+    }
+};
+
+// Specialization for PathfindingService - searches in the background on the shared job system
+template<>
+struct ServiceTraits<PathfindingService> {
+    static std::unique_ptr<PathfindingService> create(const IEngineResources& resources) {
+        return std::make_unique<PathfindingService>(resources.jobs);
+    }
+};
+
 // Service builder that constructs services with their required dependencies
 class ServiceBuilder {
 public:
@@ -46,6 +101,11 @@ private:
 struct IEngineInjections {
     std::unique_ptr<InputManager> inputManager;
     std::unique_ptr<AssetManager> assetManager;
+    std::unique_ptr<CollisionWorld> collisionWorld;
+    std::unique_ptr<PhysicsWorld> physicsWorld;
+    std::unique_ptr<ProjectileSystem> projectileSystem;
+    std::unique_ptr<RaycastService> raycastService;
+    std::unique_ptr<PathfindingService> pathfindingService;
 };
 
 // Concept: must expose iteration
@@ -64,6 +124,14 @@ struct ServiceContainer : IEngineInjections{
         ServiceContainer container;
         container.inputManager = builder.build<InputManager>();
         container.assetManager = builder.build<AssetManager>();
+        container.collisionWorld = builder.build<CollisionWorld>();
+        container.physicsWorld = builder.build<PhysicsWorld>();
+        container.projectileSystem = builder.build<ProjectileSystem>();
+        container.raycastService = builder.build<RaycastService>();
+        container.pathfindingService = builder.build<PathfindingService>();
+
+        // Rays are blocked by the same colliders the physics sees
+        container.raycastService->setCollisionWorld(container.collisionWorld.get());
 
         return container;
     }
@@ -72,6 +140,11 @@ struct ServiceContainer : IEngineInjections{
         return {
             inputManager.get(),
             assetManager.get(),
+            collisionWorld.get(),
+            physicsWorld.get(),
+            projectileSystem.get(),
+            raycastService.get(),
+            pathfindingService.get(),
         };
     }
 };
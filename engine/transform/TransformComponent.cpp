@@ -1 +1,25 @@
-#include "TransformComponent.h"
\ No newline at end of file
+#include "TransformComponent.h"
+#include <cmath>
+#include <cstring>
+
+void TransformComponent::getModelMatrix(float* outMatrix) const {
+    // 2D model matrix: scale, rotation about Z, translation
+    // For 2D, we ignore z translation but can use it for depth sorting later
+
+    std::memset(outMatrix, 0, 16 * sizeof(float));
+
+    // Scale and rotation
+    const float c = std::cos(rotation);
+    const float s = std::sin(rotation);
+    outMatrix[0] = c * scale.x;
+    outMatrix[1] = s * scale.x;
+    outMatrix[4] = -s * scale.y;
+    outMatrix[5] = c * scale.y;
+    outMatrix[10] = scale.z;
+    outMatrix[15] = 1.0f;
+
+    // Translation
+    outMatrix[12] = position.x;
+    outMatrix[13] = position.y;
+    outMatrix[14] = position.z;
+}
@@ -12,9 +12,14 @@ struct Vector3 {
 class TransformComponent : public Component {
 public:
     TransformComponent() : position{0.0f, 0.0f, 0.0f}, scale{1.0f, 1.0f, 1.0f} {}
-    
+
+    // Column-major model matrix: scale, then rotation about Z, then translation
+    void getModelMatrix(float* outMatrix) const;
+
+
     Vector3 position;
     Vector3 scale;
+    float rotation = 0.0f;  // radians about Z, counter-clockwise (hull facing, colliders)
 };
 
 
@@ -0,0 +1,60 @@
+#include "FrameTimingLog.h"
+#include <algorithm>
+#include <iostream>
+
+bool FrameTimingLog::open(const std::string& path) {
+    file.open(path, std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "ERROR::FRAME_TIMING_LOG::Cannot write: " << path << std::endl;
+        return false;
+    }
+    file << "frame,ticks,update_ms,render_ms,frame_ms,checksum\n";
+    frameMillis.clear();
+    updateTotal = 0.0;
+    renderTotal = 0.0;
+    mismatches = 0;
+    return true;
+}
+
+void FrameTimingLog::record(int ticks, float updateMillis, float renderMillis, float frame, uint64_t checksum) {
+    if (file.is_open()) {
+        file << frameMillis.size() << ',' << ticks << ',' << updateMillis << ',' << renderMillis << ','
+             << frame << ',' << std::hex << checksum << std::dec << '\n';
+    }
+    frameMillis.push_back(frame);
+    updateTotal += updateMillis;
+    renderTotal += renderMillis;
+}
+
+void FrameTimingLog::recordMismatch(uint64_t tick) {
+    if (mismatches == 0) {
+        firstMismatchTick = tick;
+    }
+    mismatches++;
+}
+
+void FrameTimingLog::reportSummary(std::ostream& out) const {
+    if (frameMillis.empty()) {
+        out << "Frame timings: no frames" << std::endl;
+        return;
+    }
+
+    std::vector<float> sorted = frameMillis;
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&sorted](double p) { return sorted[static_cast<size_t>(p * static_cast<double>(sorted.size() - 1))]; };
+
+    const double count = static_cast<double>(frameMillis.size());
+    double total = 0.0;
+    for (float value : frameMillis) {
+        total += value;
+    }
+
+    out << "Frame timings: " << frameMillis.size() << " frames, mean " << total / count << " ms (update "
+        << updateTotal / count << ", render " << renderTotal / count << "), p50 " << percentile(0.5)
+        << " ms, p99 " << percentile(0.99) << " ms, max " << sorted.back() << " ms" << std::endl;
+    if (mismatches > 0) {
+        out << "  Determinism: " << mismatches << " ticks diverged, first at tick " << firstMismatchTick << std::endl;
+    } else {
+        out << "  Determinism: all checked ticks matched" << std::endl;
+    }
+}
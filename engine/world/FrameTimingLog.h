@@ -0,0 +1,38 @@
+#ifndef ENGINE_FRAMETIMINGLOG_H
+#define ENGINE_FRAMETIMINGLOG_H
+
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Per-frame timings written as CSV (frame, ticks, update_ms, render_ms, frame_ms, checksum)
+// plus a summary, so replayed sessions can be compared run against run
+class FrameTimingLog {
+public:
+    FrameTimingLog() = default;
+
+    // Start a new log; false if the file cannot be created
+    bool open(const std::string& path);
+    bool isOpen() const { return file.is_open(); }
+
+    void record(int ticks, float updateMillis, float renderMillis, float frameMillis, uint64_t checksum);
+
+    // A replayed tick ended in another state than when it was recorded (the engine reports it)
+    void recordMismatch(uint64_t tick);
+    int getMismatches() const { return mismatches; }
+
+    // Frame count, mean and percentile frame times, determinism result
+    void reportSummary(std::ostream& out) const;
+
+private:
+    std::ofstream file;
+    std::vector<float> frameMillis;
+    double updateTotal = 0.0;
+    double renderTotal = 0.0;
+    int mismatches = 0;
+    uint64_t firstMismatchTick = 0;
+};
+
+#endif //ENGINE_FRAMETIMINGLOG_H
@@ -0,0 +1,82 @@
+#include "WorldBatch.h"
+#include "WorldEngine.h"
+#include "input/StubInputSource.h"
+#include <algorithm>
+#include <chrono>
+
+WorldBatch::WorldBatch(JobSystem& jobs, std::shared_ptr<const AssetSnapshot> assets)
+    : jobs(jobs), assets(std::move(assets)) {}
+
+WorldResult WorldBatch::runWorld(size_t index, const WorldBatchSettings& settings, const SceneBuilder& builder) const {
+    WorldResult result;
+    result.index = index;
+    result.seed = settings.seed + index;
+
+    // No window and no shared job system: the world is confined to the worker running it
+    IEngineResources resources{ .window = nullptr, .jobs = nullptr };
+    ServiceContainer services = ServiceContainer::create(resources);
+
+    SceneTree scene("world" + std::to_string(index));
+    WorldRandom random(result.seed);
+    builder(scene, random, assets.get());
+
+    StubInputSource input(settings.ticksPerWorld, true);
+    WorldEngine<ServiceContainer> world;
+    world.buildHeadless(std::move(services), &scene);
+    world.setFixedStep(settings.fixedStep);
+    world.setInputSource(&input);
+
+    const auto start = std::chrono::steady_clock::now();
+    result.ticks = world.runTicks(settings.ticksPerWorld);
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.checksum = world.stateChecksum();
+
+    // The scene tree does not own its nodes
+    std::vector<SceneTree*> nodes;
+    Tree::Traverse<SceneTree>(&scene, [&nodes](SceneTree* node) { nodes.push_back(node); });
+    for (SceneTree* node : nodes) {
+        delete node;
+    }
+    return result;
+}
+
+void WorldBatch::run(const WorldBatchSettings& settings, const SceneBuilder& builder) {
+    results.assign(settings.worlds, WorldResult{});
+
+    const auto start = std::chrono::steady_clock::now();
+    JobCounter counter;
+    for (size_t i = 0; i < settings.worlds; ++i) {
+        jobs.submit([this, i, &settings, &builder] {
+            results[i] = runWorld(i, settings, builder);
+        }, &counter);
+    }
+    jobs.wait(counter);
+    wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+uint64_t WorldBatch::getTotalTicks() const {
+    uint64_t total = 0;
+    for (const WorldResult& result : results) {
+        total += result.ticks;
+    }
+    return total;
+}
+
+void WorldBatch::reportStats(std::ostream& out) const {
+    if (results.empty()) {
+        out << "World batch: no worlds run" << std::endl;
+        return;
+    }
+
+    double slowest = 0.0;
+    double fastest = results.front().seconds;
+    for (const WorldResult& result : results) {
+        slowest = std::max(slowest, result.seconds);
+        fastest = std::min(fastest, result.seconds);
+    }
+
+    const uint64_t total = getTotalTicks();
+    out << "World batch: " << results.size() << " worlds, " << total << " ticks in " << wallSeconds << " s, "
+        << (wallSeconds > 0.0 ? static_cast<double>(total) / wallSeconds : 0.0) << " ticks/s aggregate ("
+        << jobs.getWorkerCount() + 1 << " threads, per world " << fastest << "-" << slowest << " s)" << std::endl;
+}
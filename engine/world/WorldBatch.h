@@ -0,0 +1,60 @@
+#ifndef ENGINE_WORLDBATCH_H
+#define ENGINE_WORLDBATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+#include "WorldRandom.h"
+#include "assets/AssetSnapshot.h"
+#include "jobs/JobSystem.h"
+#include "scene/SceneTree.h"
+
+struct WorldBatchSettings {
+    size_t worlds = 64;
+    uint64_t ticksPerWorld = 600;
+    float fixedStep = 1.0f / 60.0f;
+    uint64_t seed = 1;              // world i runs with seed + i
+};
+
+struct WorldResult {
+    size_t index = 0;
+    uint64_t seed = 0;
+    uint64_t ticks = 0;
+    uint64_t checksum = 0;          // WorldEngine::stateChecksum after the last tick
+    double seconds = 0.0;
+};
+
+// Runs many independent headless worlds on a JobSystem, one job per world
+// Every world gets its own scene, services, WorldEngine and random stream; the only thing they share
+// is an immutable AssetSnapshot. Same settings and seed give the same per-world checksums
+class WorldBatch {
+public:
+    // Fills one world's scene; runs on a worker thread, so it may only read shared state
+    // Particle emitters should not be given the job system: the batch already keeps every core busy
+    using SceneBuilder = std::function<void(SceneTree& scene, WorldRandom& random, const AssetSnapshot* assets)>;
+
+    explicit WorldBatch(JobSystem& jobs, std::shared_ptr<const AssetSnapshot> assets = nullptr);
+
+    void run(const WorldBatchSettings& settings, const SceneBuilder& builder);
+
+    const std::vector<WorldResult>& getResults() const { return results; }
+    uint64_t getTotalTicks() const;
+    double getWallSeconds() const { return wallSeconds; }
+
+    // Aggregate ticks per second across all worlds, plus per-world spread
+    void reportStats(std::ostream& out) const;
+
+private:
+    JobSystem& jobs;
+    std::shared_ptr<const AssetSnapshot> assets;
+    std::vector<WorldResult> results;
+    double wallSeconds = 0.0;
+
+    WorldResult runWorld(size_t index, const WorldBatchSettings& settings, const SceneBuilder& builder) const;
+};
+
+#endif //ENGINE_WORLDBATCH_H
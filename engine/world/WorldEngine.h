@@ -1,11 +1,20 @@
 #ifndef ENGINE_WORLDENGINE_H
 #define ENGINE_WORLDENGINE_H
 
+#include "FrameTimingLog.h"
+#include "input/CameraController.h"
+#include "input/IInputSource.h"
 #include "input/InputManager.h"
+#include "input/InputRecording.h"
+#include "renderer/DynamicResolution.h"
+#include "renderer/Minimap.h"
 #include "renderer/SceneRenderer.h"
+#include "renderer/debug/PerfHud.h"
 #include "scene/SceneTree.h"
 #include "window/Window.h"
 #include "service/ServiceContainer.h"
+#include <cstdint>
+#include <ostream>
 
 template<ValidServiceContainer TSystems>
 class WorldEngine final {
@@ -14,7 +23,46 @@ public:
     ~WorldEngine() = default;
 
     void build(TSystems systems, SceneTree* scene, SceneRenderer* renderer, GLFWwindow* window, Camera* camera);
+
+    // Simulation only: no window, GL context, renderer or camera. Ticks follow the clock at the
+    // fixed step, or run back to back when the input source is not realtime (see StubInputSource)
+    void buildHeadless(TSystems systems, SceneTree* scene);
+
+    // Runs until the window closes, stop() is called or the input source runs out
     void start();
+    void stop();
+    bool isRunning() const;
+
+    // Simulate count ticks right away, without the frame loop or clock (batch runs); returns ticks run
+    uint64_t runTicks(uint64_t count);
+
+    // Ticks simulated and ticks per second over the last start()
+    void reportStats(std::ostream& out) const;
+    uint64_t getTickCount() const { return tickCount; }
+
+    // Optional overlay map, refreshed before and blitted after the scene each frame
+    void setMinimap(Minimap* minimap) { this->minimap = minimap; }
+
+    // Optional scaled scene pass, resized from each frame's measured cost
+    void setDynamicResolution(DynamicResolution* resolution) { dynamicResolution = resolution; }
+
+    // Simulation tick length in seconds
+    void setFixedStep(float seconds) { fixedStep = seconds; }
+
+    // Drive ticks from a source (e.g. a replay) instead of live input; nullptr goes back to live
+    void setInputSource(IInputSource* source);
+
+    // Append every tick's input, length and state checksum to a recording (cleared here)
+    void setRecording(InputRecording* recording);
+
+    // Per-frame timings and replay checksum mismatches
+    void setTimingLog(FrameTimingLog* log) { timingLog = log; }
+
+    // Simulate only: no rendering or buffer swaps (the window, if any, still exists)
+    void setHeadless(bool value) { headless = value; }
+
+    // Hash of the simulated state (entity transforms, camera), compared between record and replay
+    uint64_t stateChecksum() const;
 
 private:
     TSystems systems;
@@ -22,15 +70,45 @@ private:
     SceneRenderer* renderer;
     GLFWwindow* window;
     Camera* camera;
+    Minimap* minimap = nullptr;
+    DynamicResolution* dynamicResolution = nullptr;
+    IInputSource* inputSource = nullptr;
+    InputRecording* recording = nullptr;
+    FrameTimingLog* timingLog = nullptr;
+    bool headless = false;
+    bool stopRequested = false;
+    double runSeconds = 0.0;
+
+    double lastFrame = 0.0;
+    float deltaTime = 0.0f;            // render frame time
+
+    // Simulation runs in fixed steps, decoupled from the frame rate
+    double simulationTime = 0.0;       // end of the last tick, on the input event clock
+    float fixedStep = 1.0f / 60.0f;
+    float tickDelta = 1.0f / 60.0f;    // length of the tick being simulated (a replay may vary it)
+    uint64_t tickCount = 0;
+    uint64_t lastChecksum = 0;
+    uint64_t checksumMismatches = 0;   // replayed ticks whose state differed from the recording
+    uint64_t firstMismatchTick = 0;
+    int maxTicksPerFrame = 5;
+
+    CameraController cameraController;
+    ActionId quitAction = invalidAction;
+    ActionId hudAction = invalidAction;
 
-    float lastFrame = 0.0f;
-    float deltaTime = 0.0f;
+    // Performance overlay, toggled with F3
+    PerfHud hud;
+    float updateMillis = 0.0f;
+    float renderMillis = 0.0f;
 
     void update();
     void systemsTick();
+    bool fixedTick();
+    void inputTick();
     void worldTick();
-    // void physicsTick();
+    void physicsTick();
     void renderTick();
+    void hudTick();
 };
 
 #include "WorldEngine.tpp"
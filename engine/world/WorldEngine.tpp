@@ -2,6 +2,12 @@
 #define ENGINE_WORLDENGINE_TPP
 
 #include "WorldEngine.h"
+#include "assets/ContentHash.h"
+#include "transform/TransformComponent.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
 #include <utility>
 
 template<ValidServiceContainer TSystems>
@@ -11,57 +17,238 @@ void WorldEngine<TSystems>::build(TSystems systems, SceneTree* scene, SceneRende
     this->renderer = renderer;
     this->window = window;
     this->camera = camera;
+
+    // Everything reads input through the manager, resolved to action ids once here
+    InputManager* input = this->systems.inputManager.get();
+    cameraController.attach(input, camera);
+    if (input) {
+        quitAction = input->bindAction("quit", Key::Escape);
+        hudAction = input->bindAction("toggle_hud", Key::F3);
+    }
+}
+
+template<ValidServiceContainer TSystems>
+void WorldEngine<TSystems>::buildHeadless(TSystems systems, SceneTree* scene) {
+    build(std::move(systems), scene, nullptr, nullptr, nullptr);
+    headless = true;
 }
 
 template<ValidServiceContainer TSystems>
 void WorldEngine<TSystems>::start() {
+    stopRequested = false;
     update();
 }
 
 template<ValidServiceContainer TSystems>
-void WorldEngine<TSystems>::update() {
-    // Calculate delta time
-    float currentFrame = static_cast<float>(glfwGetTime());
-    deltaTime = currentFrame - lastFrame;
-    lastFrame = currentFrame;
+void WorldEngine<TSystems>::stop() {
+    stopRequested = true;
+    if (window) {
+        glfwSetWindowShouldClose(window, true);
+    }
+}
+
+template<ValidServiceContainer TSystems>
+bool WorldEngine<TSystems>::isRunning() const {
+    if (stopRequested) return false;
+    return !window || !glfwWindowShouldClose(window);
+}
 
-    while (!glfwWindowShouldClose(window)) {
+template<ValidServiceContainer TSystems>
+uint64_t WorldEngine<TSystems>::runTicks(uint64_t count) {
+    const double start = InputManager::now();
+    simulationTime = 0.0;
+    deltaTime = fixedStep;
 
-        // Handle input
-        if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
-            glfwSetWindowShouldClose(window, true);
-        }
+    uint64_t ran = 0;
+    while (ran < count && !stopRequested) {
+        systemsTick();
+        if (!fixedTick()) break;
+        ran++;
+    }
+
+    runSeconds = InputManager::now() - start;
+    return ran;
+}
+
+template<ValidServiceContainer TSystems>
+void WorldEngine<TSystems>::reportStats(std::ostream& out) const {
+    const double ticksPerSecond = runSeconds > 0.0 ? static_cast<double>(tickCount) / runSeconds : 0.0;
+    out << "Simulation: " << tickCount << " ticks in " << runSeconds << " s, " << ticksPerSecond
+        << " ticks/s (" << 1.0 / fixedStep << " Hz step)" << std::endl;
+    if (checksumMismatches > 0) {
+        out << "  Determinism: " << checksumMismatches << " ticks diverged, first at tick " << firstMismatchTick << std::endl;
+    }
+    if (systems.collisionWorld && systems.collisionWorld->size() > 0) {
+        systems.collisionWorld->reportStats(out);
+    }
+    if (systems.physicsWorld && systems.physicsWorld->getStats().bodies > 0) {
+        systems.physicsWorld->reportStats(out);
+    }
+    if (systems.projectileSystem && systems.projectileSystem->getStats().live > 0) {
+        systems.projectileSystem->reportStats(out);
+    }
+    if (systems.raycastService && systems.raycastService->getStats().queries > 0) {
+        systems.raycastService->reportStats(out);
+    }
+    if (systems.pathfindingService && systems.pathfindingService->getStats().abstractNodes > 0) {
+        systems.pathfindingService->reportStats(out);
+    }
+}
 
-        // Camera movement (WASD + Space/Shift)
-        float cameraSpeed = 1.0f * deltaTime;
+template<ValidServiceContainer TSystems>
+void WorldEngine<TSystems>::setInputSource(IInputSource* source) {
+    inputSource = source;
+    // A replay owns the input stream; live events would desync it
+    if (systems.inputManager) {
+        systems.inputManager->setLiveInput(source == nullptr);
+    }
+}
 
-        if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) {
-            camera->moveForward(cameraSpeed);
+template<ValidServiceContainer TSystems>
+void WorldEngine<TSystems>::setRecording(InputRecording* target) {
+    recording = target;
+    if (recording) {
+        recording->clear(fixedStep);
+    }
+}
+
+template<ValidServiceContainer TSystems>
+void WorldEngine<TSystems>::update() {
+    // Same clock the input events are stamped with; no GLFW needed, so it works without a window
+    lastFrame = InputManager::now();
+    simulationTime = lastFrame;
+    const double runStart = lastFrame;
+
+    while (isRunning()) {
+        // Calculate delta time
+        const double currentFrame = InputManager::now();
+        deltaTime = static_cast<float>(currentFrame - lastFrame);
+        lastFrame = currentFrame;
+
+        using Clock = std::chrono::steady_clock;
+        const auto updateStart = Clock::now();
+        systemsTick();
+
+        // Fixed ticks up to now; each one consumes exactly the input stamped inside it
+        // Uncapped sources skip the clock and run one tick per frame, as fast as the machine allows
+        const bool realtime = !inputSource || inputSource->isRealtime();
+        int ticks = 0;
+        while (ticks < maxTicksPerFrame && (realtime ? simulationTime + fixedStep <= currentFrame : ticks == 0)) {
+            if (!fixedTick()) {
+                stop();
+                break;
+            }
+            ticks++;
         }
-        if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) {
-            camera->moveForward(-cameraSpeed);
+        // Too far behind (breakpoint, long load): drop the backlog rather than spiral; queued input carries over
+        if (realtime && ticks == maxTicksPerFrame) {
+            simulationTime = std::max(simulationTime, currentFrame - fixedStep);
         }
-        if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS) {
-            camera->moveRight(-cameraSpeed);
+        const auto renderStart = Clock::now();
+        const bool rendering = !headless && window && renderer;
+        if (rendering) {
+            hudTick();
+            renderTick();
         }
-        if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS) {
-            camera->moveRight(cameraSpeed);
+        const auto renderEnd = Clock::now();
+
+        updateMillis = std::chrono::duration<float, std::milli>(renderStart - updateStart).count();
+        renderMillis = std::chrono::duration<float, std::milli>(renderEnd - renderStart).count();
+        hud.recordFrame(deltaTime * 1000.0f, updateMillis, renderMillis);
+        if (dynamicResolution) {
+            dynamicResolution->endFrame(updateMillis + renderMillis);
         }
-        if (glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS) {
-            camera->moveUp(cameraSpeed);
+
+        // Swap buffers and poll events
+        if (rendering) {
+            glfwSwapBuffers(window);
         }
-        if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS) {
-            camera->moveUp(-cameraSpeed);
+        if (window) {
+            glfwPollEvents();
+        } else if (realtime && ticks == 0) {
+            // Fixed-rate server: nothing to present, so sleep until the next tick is due
+            const double wait = simulationTime + fixedStep - InputManager::now();
+            if (wait > 0.0) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+            }
         }
 
-        systemsTick();
-        worldTick();
-        renderTick();
+        if (timingLog) {
+            const float frameMillis = std::chrono::duration<float, std::milli>(Clock::now() - updateStart).count();
+            timingLog->record(ticks, updateMillis, renderMillis, frameMillis, lastChecksum);
+        }
+    }
 
-        // Swap buffers and poll events
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+    runSeconds = InputManager::now() - runStart;
+}
+
+template<ValidServiceContainer TSystems>
+bool WorldEngine<TSystems>::fixedTick() {
+    InputManager* input = systems.inputManager.get();
+    const double tickStart = simulationTime;
+    tickDelta = fixedStep;
+    if (inputSource && (!input || !inputSource->beginTick(*input, tickStart, tickDelta))) {
+        return false;
+    }
+
+    simulationTime = tickStart + tickDelta;
+    if (input) {
+        input->advanceTo(simulationTime);
+    }
+    inputTick();
+    worldTick();
+    physicsTick();
+    tickCount++;
+
+    // Only hashed when someone compares it
+    uint64_t expected = 0;
+    const bool verify = inputSource && inputSource->getExpectedChecksum(expected);
+    if (recording || timingLog || verify) {
+        lastChecksum = stateChecksum();
+    }
+    if (recording) {
+        static const std::vector<InputEvent> noEvents;
+        recording->addTick(tickDelta, tickStart, input ? input->getTickEvents() : noEvents, lastChecksum);
+    }
+    if (verify && expected != lastChecksum) {
+        // Reported whether or not a timing log is attached; every later tick usually diverges too
+        if (checksumMismatches == 0) {
+            firstMismatchTick = tickCount - 1;
+            std::cerr << "ERROR::WORLD_ENGINE::Replay diverged at tick " << firstMismatchTick << " (expected "
+                      << std::hex << expected << ", got " << lastChecksum << std::dec << ")" << std::endl;
+        }
+        checksumMismatches++;
+        if (timingLog) {
+            timingLog->recordMismatch(tickCount - 1);
+        }
     }
+    return true;
+}
+
+template<ValidServiceContainer TSystems>
+uint64_t WorldEngine<TSystems>::stateChecksum() const {
+    // Everything the simulation moves: entity transforms, shells and the camera
+    uint64_t hash = fnvOffsetBasis;
+    Tree::Traverse<SceneTree>(scene, [&hash](SceneTree* node) {
+        auto* entity = dynamic_cast<Entity*>(node);
+        if (!entity) return;
+        if (auto* transform = entity->getComponent<TransformComponent>("transform")) {
+            hash = hashBytes(&transform->position, sizeof(transform->position), hash);
+            hash = hashBytes(&transform->scale, sizeof(transform->scale), hash);
+            hash = hashBytes(&transform->rotation, sizeof(transform->rotation), hash);
+        }
+    });
+    if (systems.projectileSystem) {
+        hash = systems.projectileSystem->hashState(hash);
+    }
+    if (camera) {
+        float state[5];
+        camera->getPosition(state[0], state[1], state[2]);
+        state[3] = camera->getYaw();
+        state[4] = camera->getPitch();
+        hash = hashBytes(state, sizeof(state), hash);
+    }
+    return hash;
 }
 
 template<ValidServiceContainer TSystems>
@@ -71,20 +258,113 @@ void WorldEngine<TSystems>::systemsTick() {
     }
 }
 
+template<ValidServiceContainer TSystems>
+void WorldEngine<TSystems>::inputTick() {
+    // Runs once per fixed tick, after the manager has applied the events stamped inside it
+    InputManager* input = systems.inputManager.get();
+    if (!input) return;
+
+    if (input->isActionJustPressed(quitAction)) {
+        stop();
+    }
+    // Toggle the performance overlay on F3 press
+    if (input->isActionJustPressed(hudAction)) {
+        hud.toggle();
+    }
+
+    cameraController.update(tickDelta);
+}
+
 template<ValidServiceContainer TSystems>
 void WorldEngine<TSystems>::worldTick() {
+    // Hold the simulation until the scene's assets are resident
+    if (systems.assetManager && !systems.assetManager->isReady()) {
+        return;
+    }
+
     Tree::Traverse<SceneTree>(scene, [this](SceneTree* node) {
         if (auto* sceneNode = dynamic_cast<Entity*>(node)) {
-            sceneNode->update(deltaTime);
+            sceneNode->update(tickDelta);
         }
     });
 }
 
+template<ValidServiceContainer TSystems>
+void WorldEngine<TSystems>::physicsTick() {
+    // Colliders copied their transforms during the world tick; contacts are read by the next one
+    CollisionWorld* collision = systems.collisionWorld.get();
+    if (collision) {
+        collision->detect();
+
+        // Bodies respond to those contacts and write their poses back to the transforms
+        if (systems.physicsWorld) {
+            systems.physicsWorld->step(tickDelta, *collision);
+        }
+    }
+
+    // Shells sweep against the colliders where the bodies ended up
+    if (systems.projectileSystem) {
+        systems.projectileSystem->step(tickDelta, collision);
+    }
+
+    // Queries during the next world tick see where everything ended up
+    if (systems.raycastService) {
+        systems.raycastService->prepare();
+    }
+
+    // Searches started last tick land now; this tick's run in the background until the next one
+    if (systems.pathfindingService) {
+        systems.pathfindingService->step();
+    }
+}
+
 template<ValidServiceContainer TSystems>
 void WorldEngine<TSystems>::renderTick() {
+    int width = 0, height = 0;
+    glfwGetFramebufferSize(window, &width, &height);
+
+    // Offscreen first, so the window framebuffer is bound again for the scene
+    if (minimap) {
+        minimap->update(deltaTime, *renderer, scene, width, height);
+    }
+
+    // Viewports are normalized, so they follow the (possibly scaled) scene size
+    int sceneWidth = width, sceneHeight = height;
+    if (dynamicResolution) {
+        dynamicResolution->begin(width, height, sceneWidth, sceneHeight);
+    }
+    renderer->setFramebufferSize(sceneWidth, sceneHeight);
+    renderer->setOverlaySize(width, height);
+
     // Clear and render
     renderer->clear(0.1f, 0.1f, 0.15f, 1.0f);
-    renderer->render(scene);
+    renderer->renderScene(scene);
+
+    // Upscale before the overlay, so HUD text stays at native resolution
+    if (dynamicResolution) {
+        dynamicResolution->end();
+    }
+    renderer->renderOverlay();
+
+    if (minimap) {
+        minimap->draw(width, height);
+    }
+}
+
+template<ValidServiceContainer TSystems>
+void WorldEngine<TSystems>::hudTick() {
+    if (!hud.isVisible()) return;
+
+    PerfHudMemory memory;
+    memory.geometryBytes = renderer->getGeometry().getGpuBytes();
+    if (systems.assetManager) {
+        const AssetResidencyStats textures = systems.assetManager->getTextureResidency();
+        memory.textureBytes = textures.gpuBytes;
+        memory.residentTextures = textures.resident;
+    }
+
+    // Counters are from the previous frame's render
+    hud.draw(renderer->getDebugDraw(), renderer->getStats(), memory);
 }
 
 #endif //ENGINE_WORLDENGINE_TPP
\ No newline at end of file
@@ -0,0 +1,37 @@
+#ifndef ENGINE_WORLDRANDOM_H
+#define ENGINE_WORLDRANDOM_H
+
+#include <cstdint>
+
+// Per-world random stream (xorshift64*); worlds never share one, so runs with the same seed repeat exactly
+class WorldRandom {
+public:
+    explicit WorldRandom(uint64_t seed = 1) { reseed(seed); }
+
+    void reseed(uint64_t seed) {
+        // splitmix64 spreads nearby seeds (world indices) across the state space; state must be non-zero
+        uint64_t z = seed + 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        state = (z ^ (z >> 31)) | 1;
+    }
+
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545f4914f6cdd1dull;
+    }
+
+    uint32_t nextU32() { return static_cast<uint32_t>(next() >> 32); }
+
+    // Uniform in [min, max)
+    float range(float min, float max) {
+        return min + (max - min) * static_cast<float>(next() >> 40) * (1.0f / 16777216.0f);
+    }
+
+private:
+    uint64_t state = 1;
+};
+
+#endif //ENGINE_WORLDRANDOM_H
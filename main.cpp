@@ -1,60 +1,135 @@
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <ostream>
+#include <string>
 
 // glad must be included before GLFW
 #include <glad/glad.h>
 #include <glfw3.h>
 
 #include "assets/AssetManager.h"
+#include "assets/AssetSnapshot.h"
+#include "assets/SceneManifest.h"
+#include "collision/ColliderComponent.h"
 #include "entity/Entity.h"
 #include "input/InputManager.h"
+#include "input/ReplayInputSource.h"
+#include "input/StubInputSource.h"
+#include "jobs/JobSystem.h"
+#include "particles/ParticleEmitterComponent.h"
+#include "physics/RigidBodyComponent.h"
+#include "projectiles/ProjectileRendererComponent.h"
 #include "scene/SceneTree.h"
 #include "transform/TransformComponent.h"
 #include "renderer/Camera.h"
+#include "renderer/DynamicResolution.h"
+#include "renderer/Minimap.h"
 #include "renderer/SceneRenderer.h"
 #include "renderer/components/QuadRenderer.h"
 #include "renderer/components/Texture2DComponent.h"
+#include "renderer/components/TilemapComponent.h"
+#include "world/WorldBatch.h"
 #include "world/WorldEngine.h"
 
-// Global variables for mouse handling
-double lastMouseX = 400.0;
-double lastMouseY = 300.0;
-bool firstMouse = true;
-bool mouseCaptured = false;
-Camera* activeCamera = nullptr;  // Pointer to currently active camera
+// GL-free scene for simulation-only runs: a row of particle emitters seeded from the world's stream
+// Renderer components would never be drawn without a context, so none are added here
+// With an asset snapshot the emitters cover the textured centre quad (5 units tall, as wide as the
+// shared texture's aspect ratio); without one they are scattered over the arena
+void buildSimulationScene(SceneTree& scene, WorldRandom& random, JobSystem* jobs, const AssetSnapshot* assets) {
+    ParticleEmitterSettings sparks;
+    sparks.rate = 2000.0f;
+    sparks.speedMin = 2.0f;
+    sparks.speedMax = 6.0f;
+    sparks.spread = 60.0f;
+    sparks.forces.gravityY = -9.81f;
+    sparks.forces.drag = 0.5f;
 
-// Mouse callback for FPS-style camera rotation
-void mouseCallback(GLFWwindow* window, double xpos, double ypos) {
-    if (!activeCamera || !mouseCaptured) return;
+    float halfWidth = 50.0f;
+    float halfHeight = 50.0f;
+    if (const TextureData* quadTexture = assets ? assets->findTexture("test") : nullptr; quadTexture && quadTexture->height > 0) {
+        halfHeight = 2.5f;
+        halfWidth = halfHeight * static_cast<float>(quadTexture->width) / static_cast<float>(quadTexture->height);
+    }
 
-    if (firstMouse) {
-        lastMouseX = xpos;
-        lastMouseY = ypos;
-        firstMouse = false;
+    for (int i = 0; i < 8; ++i) {
+        Entity* emitterEntity = new Entity("sparks" + std::to_string(i));
+        auto* emitter = new ParticleEmitterComponent(20000, sparks);
+        emitter->setJobSystem(jobs);
+        emitter->setSeed(random.nextU32());
+        emitterEntity->addComponent("emitter", emitter);
+        emitterEntity->getComponent<TransformComponent>("transform")->position = {random.range(-halfWidth, halfWidth), random.range(-halfHeight, halfHeight), 0.0f};
+        scene.addChild(emitterEntity);
     }
+}
+
+// Simulation without a window or GL context (dedicated server, AI training, CI throughput)
+int runHeadless(uint64_t ticks, bool uncapped) {
+    JobSystem jobs;
+    IEngineResources resources{ .window = nullptr, .jobs = &jobs };
+    ServiceContainer services = ServiceContainer::create(resources);
 
-    float deltaX = static_cast<float>(xpos - lastMouseX);
-    float deltaY = static_cast<float>(ypos - lastMouseY);
-    lastMouseX = xpos;
-    lastMouseY = ypos;
+    SceneTree scene("headless");
+    WorldRandom random(1);
+    buildSimulationScene(scene, random, &jobs, nullptr);
 
-    activeCamera->processMouseMovement(deltaX, deltaY, 0.1f);
+    StubInputSource input(ticks, uncapped);
+
+    WorldEngine<ServiceContainer> we = WorldEngine<ServiceContainer>{};
+    we.buildHeadless(std::move(services), &scene);
+    we.setInputSource(&input);
+    we.start();
+    we.reportStats(std::cout);
+    return 0;
 }
 
-// Mouse button callback to toggle mouse capture
-void mouseButtonCallback(GLFWwindow* window, int button, int action, int mods) {
-    if (button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_PRESS) {
-        mouseCaptured = !mouseCaptured;
-        if (mouseCaptured) {
-            glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-            firstMouse = true;  // Reset to prevent jump
-        } else {
-            glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
-        }
+// Many independent headless worlds across all cores, sharing one read-only asset snapshot
+int runBatch(size_t worlds, uint64_t ticks) {
+    JobSystem jobs;
+
+    std::shared_ptr<const AssetSnapshot> assets;
+    if (std::unique_ptr<SceneManifest> manifest = SceneManifest::fromFile("scenes/main.manifest")) {
+        assets = AssetSnapshot::load(*manifest, &jobs);
+        assets->reportStats(std::cout);
     }
+
+    WorldBatch batch(jobs, assets);
+    batch.run({ .worlds = worlds, .ticksPerWorld = ticks }, [](SceneTree& scene, WorldRandom& random, const AssetSnapshot* assets) {
+        buildSimulationScene(scene, random, nullptr, assets);
+    });
+    batch.reportStats(std::cout);
+    return 0;
 }
 
-int main() {
+int main(int argc, char** argv) {
+    // Session options: --record <file>, --replay <file> [--uncapped] [--no-render], --timings <file.csv>
+    // Headless simulation: --headless [--ticks <n>] [--uncapped], or --batch <worlds> [--ticks <n>]
+    std::string recordPath, replayPath, timingsPath;
+    bool uncapped = false;
+    bool noRender = false;
+    bool headless = false;
+    uint64_t headlessTicks = 600;
+    size_t batchWorlds = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) recordPath = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc) replayPath = argv[++i];
+        else if (arg == "--timings" && i + 1 < argc) timingsPath = argv[++i];
+        else if (arg == "--ticks" && i + 1 < argc) headlessTicks = std::stoull(argv[++i]);
+        else if (arg == "--batch" && i + 1 < argc) batchWorlds = std::stoull(argv[++i]);
+        else if (arg == "--uncapped") uncapped = true;
+        else if (arg == "--no-render") noRender = true;
+        else if (arg == "--headless") headless = true;
+        else std::cerr << "Unknown option: " << arg << std::endl;
+    }
+
+    if (batchWorlds > 0) {
+        return runBatch(batchWorlds, headlessTicks);
+    }
+    if (headless) {
+        return runHeadless(headlessTicks, uncapped);
+    }
+
     // Initialize GLFW and create OpenGL context BEFORE loading GLAD
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
@@ -79,32 +154,54 @@ int main() {
         return -1;
     }
 
-    glViewport(0, 0, 800, 600);
     glEnable(GL_DEPTH_TEST);  // Enable depth testing for 3D
 
     // ==================== CAMERA SETUP ====================
     
-    // Create perspective camera (FOV 45 degrees, aspect ratio 800/600)
-    PerspectiveCamera perspectiveCamera(90.0f, 800.0f / 600.0f, 0.1f, 1000.0f);
+    // Split screen: each camera gets half the window (aspect ratio 400/600)
+    const float viewAspect = 400.0f / 600.0f;
+
+    // Create perspective camera for the left view
+    PerspectiveCamera perspectiveCamera(90.0f, viewAspect, 0.1f, 1000.0f);
     perspectiveCamera.setPosition(0.0f, 5.0f, 15.0f);
     perspectiveCamera.setRotation(-90.0f, -15.0f);  // Look slightly down
     
-    // Create orthographic camera for
+    // Create orthographic camera for the right view
     // Larger bounds to see more of the scene
-    // OrthographicCamera orthoCamera(-15.0f * (800.0f/600.0f), 15.0f * (800.0f/600.0f), -15.0f, 15.0f, -100.0f, 100.0f);
-    // orthoCamera.setPosition(0.0f, 0.0f, 20.0f);  // Centered, looking at origin
-    // orthoCamera.setRotation(-90.0f, 0.0f);  // Look straight ahead (no pitch)
-
-    activeCamera = &perspectiveCamera;
-
-    // Set up mouse callbacks
-    glfwSetCursorPosCallback(window, mouseCallback);
-    glfwSetMouseButtonCallback(window, mouseButtonCallback);
+    OrthographicCamera orthoCamera(-15.0f * viewAspect, 15.0f * viewAspect, -15.0f, 15.0f, -100.0f, 100.0f);
+    orthoCamera.setPosition(0.0f, 0.0f, 20.0f);  // Centered, looking at origin
+    orthoCamera.setRotation(-90.0f, 0.0f);  // Look straight ahead (no pitch)
 
     // Create scene renderer
     SceneRenderer sceneRenderer;
     sceneRenderer.initialize();
-    sceneRenderer.setCamera(activeCamera);
+    sceneRenderer.setCamera(&perspectiveCamera);
+
+    Viewport leftView;
+    leftView.camera = &perspectiveCamera;
+    leftView.width = 0.5f;
+    sceneRenderer.addViewport(leftView);
+
+    Viewport rightView;
+    rightView.camera = &orthoCamera;
+    rightView.x = 0.5f;
+    rightView.width = 0.5f;
+    sceneRenderer.addViewport(rightView);
+
+    // Worker threads shared by the engine (asset decoding)
+    JobSystem jobs;
+
+    // Create services using dependency injection
+    IEngineResources resources{ .window = window, .jobs = &jobs };
+    ServiceContainer services = ServiceContainer::create(resources);
+    services.assetManager->setTextureBudget({ .gpuBytes = 256 * 1024 * 1024 });
+
+    // Decode the scene's assets in parallel before building it
+    std::unique_ptr<SceneManifest> manifest = SceneManifest::fromFile("scenes/main.manifest");
+    if (manifest) {
+        services.assetManager->preload(*manifest);
+        services.assetManager->finishPreload();
+    }
 
     // ==================== TEST SCENE SETUP ====================
     SceneTree scene("main");
@@ -118,7 +215,7 @@ int main() {
     scene.addChild(redQuad);
 
     Entity* greenQuad = new Entity("greenQuad");
-    greenQuad->addComponent("texture", new Texture2DComponent("textures/test.png"));
+    greenQuad->addComponent("texture", new Texture2DComponent(*services.assetManager, "textures/test.png"));
     greenQuad->addComponent("renderer", new QuadRenderer());  // White color for no tint
     greenQuad->getComponent<TransformComponent>("transform")->position = {0.0f, 0.0f, 0.0f};
     greenQuad->getComponent<TransformComponent>("transform")->scale = {5.0f, 5.0f, 1.0f};
@@ -130,23 +227,45 @@ int main() {
     blueQuad->getComponent<TransformComponent>("transform")->scale = {2.0f, 2.0f, 1.0f};
     scene.addChild(blueQuad);
 
+    // The front row collides; hulls match the quads' scaled size
+    CollisionWorld& collision = *services.collisionWorld;
+    redQuad->addComponent("collider", new ColliderComponent(collision, CollisionShape::box(1.0f, 1.0f)));
+    greenQuad->addComponent("collider", new ColliderComponent(collision, CollisionShape::box(2.5f, 2.5f)));
+    blueQuad->addComponent("collider", new ColliderComponent(collision, CollisionShape::circle(1.0f)));
+
+    // The outer quads slide into the centre one, which has no body and stays put
+    PhysicsWorld& physics = *services.physicsWorld;
+    BodyDesc crate;
+    crate.mass = 4.0f;
+    crate.linearDamping = 0.5f;
+    crate.angularDamping = 1.0f;
+    auto* redBody = new RigidBodyComponent(physics, crate);
+    auto* blueBody = new RigidBodyComponent(physics, crate);
+    redQuad->addComponent("body", redBody);
+    blueQuad->addComponent("body", blueBody);
+    redBody->setVelocity(3.0f, 0.5f, 0.0f);
+    blueBody->setVelocity(-3.0f, -0.5f, 0.0f);
+
     // Row 2: Mid quads (Z = -5)
     Entity* yellowQuad = new Entity("yellowQuad");
     yellowQuad->addComponent("renderer", new QuadRenderer(1.0f, 1.0f, 0.0f, 1.0f));
     yellowQuad->getComponent<TransformComponent>("transform")->position = {-4.0f, 0.0f, -5.0f};
     yellowQuad->getComponent<TransformComponent>("transform")->scale = {2.0f, 2.0f, 1.0f};
+    yellowQuad->setStatic(true);
     scene.addChild(yellowQuad);
 
     Entity* cyanQuad = new Entity("cyanQuad");
     cyanQuad->addComponent("renderer", new QuadRenderer(0.0f, 1.0f, 1.0f, 1.0f));
     cyanQuad->getComponent<TransformComponent>("transform")->position = {0.0f, 0.0f, -5.0f};
     cyanQuad->getComponent<TransformComponent>("transform")->scale = {2.0f, 2.0f, 1.0f};
+    cyanQuad->setStatic(true);
     scene.addChild(cyanQuad);
 
     Entity* magentaQuad = new Entity("magentaQuad");
     magentaQuad->addComponent("renderer", new QuadRenderer(1.0f, 0.0f, 1.0f, 1.0f));
     magentaQuad->getComponent<TransformComponent>("transform")->position = {4.0f, 0.0f, -5.0f};
     magentaQuad->getComponent<TransformComponent>("transform")->scale = {2.0f, 2.0f, 1.0f};
+    magentaQuad->setStatic(true);
     scene.addChild(magentaQuad);
 
     // Row 3: Far quads (Z = -10)
@@ -154,37 +273,157 @@ int main() {
     orangeQuad->addComponent("renderer", new QuadRenderer(1.0f, 0.5f, 0.0f, 1.0f));
     orangeQuad->getComponent<TransformComponent>("transform")->position = {-4.0f, 0.0f, -10.0f};
     orangeQuad->getComponent<TransformComponent>("transform")->scale = {2.0f, 2.0f, 1.0f};
+    orangeQuad->setStatic(true);
     scene.addChild(orangeQuad);
 
     Entity* whiteQuad = new Entity("whiteQuad");
     whiteQuad->addComponent("renderer", new QuadRenderer(1.0f, 1.0f, 1.0f, 1.0f));
     whiteQuad->getComponent<TransformComponent>("transform")->position = {0.0f, 0.0f, -10.0f};
     whiteQuad->getComponent<TransformComponent>("transform")->scale = {2.0f, 2.0f, 1.0f};
+    whiteQuad->setStatic(true);
     scene.addChild(whiteQuad);
 
     Entity* grayQuad = new Entity("grayQuad");
     grayQuad->addComponent("renderer", new QuadRenderer(0.5f, 0.5f, 0.5f, 1.0f));
     grayQuad->getComponent<TransformComponent>("transform")->position = {4.0f, 0.0f, -10.0f};
     grayQuad->getComponent<TransformComponent>("transform")->scale = {2.0f, 2.0f, 1.0f};
+    grayQuad->setStatic(true);
     scene.addChild(grayQuad);
 
+    // Arena floor: a tilemap behind the quads, drawn as a few chunk meshes
+    TextureAtlas tileAtlas;
+    tileAtlas.add("floor", "textures/test.png");
+    tileAtlas.build();
+
+    Entity* arena = new Entity("arena");
+    auto* tilemap = new TilemapComponent(256, 256, &tileAtlas);
+    tilemap->setTileType(1, "floor");
+    for (int y = 0; y < tilemap->getHeight(); ++y) {
+        for (int x = (y % 2); x < tilemap->getWidth(); x += 2) {
+            tilemap->setTile(x, y, 1);
+        }
+    }
+
+    // A solid border; rays, line of sight and paths stop at it
+    tilemap->setTileType(2, "floor");
+    tilemap->fill(0, 0, tilemap->getWidth(), 1, 2);
+    tilemap->fill(0, tilemap->getHeight() - 1, tilemap->getWidth(), 1, 2);
+    tilemap->fill(0, 0, 1, tilemap->getHeight(), 2);
+    tilemap->fill(tilemap->getWidth() - 1, 0, 1, tilemap->getHeight(), 2);
+    services.raycastService->setTilemap(tilemap, -128.0f, -128.0f);
+    services.raycastService->setSolid(2);
+    services.pathfindingService->setTilemap(tilemap, -128.0f, -128.0f);
+    services.pathfindingService->setBlocked(2);
+
+    arena->addComponent("renderer", tilemap);
+    arena->getComponent<TransformComponent>("transform")->position = {-128.0f, -128.0f, -40.0f};
+    arena->setStatic(true);
+    scene.addChild(arena);
+
+    // Sparks rising from the centre quad
+    ParticleEmitterSettings sparks;
+    sparks.rate = 2000.0f;
+    sparks.speedMin = 2.0f;
+    sparks.speedMax = 6.0f;
+    sparks.spread = 60.0f;
+    sparks.sizeMin = 0.05f;
+    sparks.sizeMax = 0.1f;
+    sparks.forces.gravityY = -9.81f;
+    sparks.forces.drag = 0.5f;
+    sparks.appearance = {{1.0f, 0.9f, 0.4f, 1.0f}, {1.0f, 0.2f, 0.0f, 0.0f}, 0.5f};
+    sparks.additive = true;
+
+    Entity* sparkEmitter = new Entity("sparks");
+    auto* emitter = new ParticleEmitterComponent(20000, sparks);
+    emitter->setJobSystem(&jobs);
+    sparkEmitter->addComponent("renderer", emitter);
+    sparkEmitter->getComponent<TransformComponent>("transform")->position = {0.0f, 2.5f, 0.5f};
+    scene.addChild(sparkEmitter);
+
+    // An opening volley from the left; fast enough to cross a quad in one tick, the sweep still stops it
+    ProjectileSystem& shells = *services.projectileSystem;
+    for (int i = 0; i < 16; ++i) {
+        ProjectileSpawn spawn;
+        spawn.x = -14.0f;
+        spawn.y = -3.0f + 0.4f * static_cast<float>(i);
+        spawn.z = 0.1f;
+        spawn.velocityX = 120.0f;
+        spawn.lifetime = 1.0f;
+        shells.fire(spawn);
+    }
+
+    Entity* shellEntity = new Entity("shells");
+    shellEntity->addComponent("renderer", new ProjectileRendererComponent(shells, 1.0f, 0.8f, 0.3f, 1.0f));
+    scene.addChild(shellEntity);
+
+    // The back rows never move; bake them into shared batches
+    sceneRenderer.bakeStatic(&scene);
+
+    Texture2D::reportLoadStats(std::cout);
+    services.assetManager->reportStats(std::cout);
+    sceneRenderer.getProgramCache().reportStats(std::cout);
+    sceneRenderer.getStaticBatcher().reportStats(std::cout);
+
     std::cout << "\n==================== CONTROLS ====================" << std::endl;
     std::cout << "  WASD        - Move camera" << std::endl;
     std::cout << "  Space/Shift - Move up/down" << std::endl;
     std::cout << "  Right-click - Toggle mouse look" << std::endl;
+    std::cout << "  F3          - Toggle performance HUD" << std::endl;
     std::cout << "  TAB         - Switch camera (Perspective/Orthographic)" << std::endl;
     std::cout << "  Q/E         - Zoom out/in (Orthographic only)" << std::endl;
     std::cout << "  ESC         - Exit" << std::endl;
     std::cout << "==================================================" << std::endl;
 
-    // Create services using dependency injection
-    IEngineResources resources{ .window = window };
-    ServiceContainer services = ServiceContainer::create(resources);
-
     WorldEngine<ServiceContainer> we = WorldEngine<ServiceContainer>{};
+    // Tactical map of the arena; the front row stands in for moving units
+    Minimap minimap(-128.0f, -128.0f, 128.0f, 128.0f);
+    if (minimap.initialize()) {
+        minimap.track(redQuad, 1.0f, 0.2f, 0.2f);
+        minimap.track(greenQuad, 0.2f, 1.0f, 0.2f);
+        minimap.track(blueQuad, 0.2f, 0.4f, 1.0f);
+    }
+
     we.build(std::move(services), &scene, &sceneRenderer, window, &perspectiveCamera);
+    we.setMinimap(&minimap);
+
+    // Scene resolution follows frame cost; the window size stays what the user picked
+    DynamicResolution dynamicResolution({ .targetFrameMillis = 16.6f, .minScale = 0.5f, .maxScale = 1.0f });
+    we.setDynamicResolution(&dynamicResolution);
+
+    // Recorded sessions replay tick for tick; their checksums flag any divergence
+    InputRecording recording;
+    std::unique_ptr<InputRecording> replay;
+    std::unique_ptr<ReplayInputSource> replaySource;
+    FrameTimingLog timings;
+    if (!replayPath.empty()) {
+        replay = InputRecording::fromFile(replayPath);
+        if (replay) {
+            we.setFixedStep(replay->getFixedStep());
+            replaySource = std::make_unique<ReplayInputSource>(*replay, uncapped);
+            we.setInputSource(replaySource.get());
+            we.setHeadless(noRender);
+        }
+    }
+    if (!recordPath.empty()) {
+        we.setRecording(&recording);
+    }
+    if (!timingsPath.empty()) {
+        timings.open(timingsPath);
+    }
+    if (timings.isOpen() || replaySource) {
+        we.setTimingLog(&timings);
+    }
+
     we.start();
 
+    if (!recordPath.empty() && recording.save(recordPath)) {
+        std::cout << "Recorded " << recording.getTickCount() << " ticks, " << recording.getEventCount()
+                  << " input events to " << recordPath << std::endl;
+    }
+    if (replaySource) {
+        timings.reportSummary(std::cout);
+    }
+
     glfwTerminate();
     return 0;
 }
\ No newline at end of file
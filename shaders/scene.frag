@@ -2,15 +2,32 @@
 in vec2 TexCoord;
 out vec4 FragColor;
 
+#if defined(INSTANCED) || defined(VERTEX_COLOUR)
+in vec4 VertexColour;
+#define COLOUR VertexColour
+#else
 uniform vec4 colour;
+#define COLOUR colour
+#endif
+
+#ifdef TEXTURED
 uniform sampler2D textureSampler;
-uniform int useTexture;
+#endif
+
+#ifndef ALPHA_CUTOFF
+#define ALPHA_CUTOFF 0.5
+#endif
 
 void main() {
-    if (useTexture == 1) {
-        vec4 texColour = texture(textureSampler, TexCoord);
-        FragColor = texColour * colour;  // colour acts as tint
-    } else {
-        FragColor = colour;
+#ifdef TEXTURED
+    FragColor = texture(textureSampler, TexCoord) * COLOUR;  // colour acts as tint
+#else
+    FragColor = COLOUR;
+#endif
+
+#ifdef ALPHA_TEST
+    if (FragColor.a < ALPHA_CUTOFF) {
+        discard;
     }
+#endif
 }
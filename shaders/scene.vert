@@ -2,12 +2,39 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec2 aTexCoord;
 
+#ifdef INSTANCED
+layout (location = 2) in vec4 aInstance;  // xyz = position, w = size
+#endif
+
+uniform mat4 model;
+
+#if defined(INSTANCED) || defined(VERTEX_COLOUR)
+layout (location = 6) in vec4 aColour;  // per instance or per vertex
+out vec4 VertexColour;
+#endif
+
 out vec2 TexCoord;
 
 uniform mat4 viewProjection;
-uniform mat4 model;
+
+#ifdef ATLAS
+uniform vec4 uvRect;  // xy = offset, zw = scale (atlas region)
+#endif
 
 void main() {
+#ifdef INSTANCED
+    gl_Position = viewProjection * model * vec4(aPos * aInstance.w + aInstance.xyz, 1.0);
+#else
     gl_Position = viewProjection * model * vec4(aPos, 1.0);
+#endif
+
+#if defined(INSTANCED) || defined(VERTEX_COLOUR)
+    VertexColour = aColour;
+#endif
+
+#ifdef ATLAS
+    TexCoord = uvRect.xy + aTexCoord * uvRect.zw;
+#else
     TexCoord = aTexCoord;
+#endif
 }
@@ -0,0 +1,324 @@
+// Offline texture baker
+// Decodes source images once and writes GPU-ready .tex files (see engine/renderer/texture/BakedTexture.h):
+// rows are pre-flipped for OpenGL, the full mip chain is stored and, with --compress,
+// RGB/RGBA levels are block compressed to BC1/BC3.
+//
+// Usage: texture_baker [--compress] [--no-mips] [--out-dir DIR] image...
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "renderer/texture/BakedTexture.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+namespace fs = std::filesystem;
+
+struct Image {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t channels = 0;
+    std::vector<unsigned char> pixels;
+};
+
+struct BakeOptions {
+    bool compress = false;
+    bool mips = true;
+    fs::path outDir;
+};
+
+// ==================== Mip generation ====================
+
+// 2x2 box filter; odd edges reuse the last row/column
+static Image downsample(const Image& src) {
+    Image dst;
+    dst.width = std::max(1u, src.width / 2);
+    dst.height = std::max(1u, src.height / 2);
+    dst.channels = src.channels;
+    dst.pixels.resize(static_cast<size_t>(dst.width) * dst.height * dst.channels);
+
+    for (uint32_t y = 0; y < dst.height; ++y) {
+        const uint32_t y0 = std::min(y * 2, src.height - 1);
+        const uint32_t y1 = std::min(y * 2 + 1, src.height - 1);
+        for (uint32_t x = 0; x < dst.width; ++x) {
+            const uint32_t x0 = std::min(x * 2, src.width - 1);
+            const uint32_t x1 = std::min(x * 2 + 1, src.width - 1);
+            for (uint32_t c = 0; c < src.channels; ++c) {
+                auto at = [&](uint32_t px, uint32_t py) {
+                    return static_cast<uint32_t>(src.pixels[(static_cast<size_t>(py) * src.width + px) * src.channels + c]);
+                };
+                const uint32_t sum = at(x0, y0) + at(x1, y0) + at(x0, y1) + at(x1, y1);
+                dst.pixels[(static_cast<size_t>(y) * dst.width + x) * dst.channels + c] = static_cast<unsigned char>((sum + 2) / 4);
+            }
+        }
+    }
+    return dst;
+}
+
+// ==================== Block compression ====================
+
+static uint16_t packRGB565(const unsigned char* rgb) {
+    return static_cast<uint16_t>(((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) | (rgb[2] >> 3));
+}
+
+static void unpackRGB565(uint16_t c, int* rgb) {
+    rgb[0] = ((c >> 11) & 31) * 255 / 31;
+    rgb[1] = ((c >> 5) & 63) * 255 / 63;
+    rgb[2] = (c & 31) * 255 / 31;
+}
+
+// Gathers a 4x4 block as RGBA, clamping at the image edge
+static void fetchBlock(const Image& image, uint32_t bx, uint32_t by, unsigned char block[16][4]) {
+    for (uint32_t y = 0; y < 4; ++y) {
+        for (uint32_t x = 0; x < 4; ++x) {
+            const uint32_t px = std::min(bx * 4 + x, image.width - 1);
+            const uint32_t py = std::min(by * 4 + y, image.height - 1);
+            const unsigned char* src = &image.pixels[(static_cast<size_t>(py) * image.width + px) * image.channels];
+            unsigned char* dst = block[y * 4 + x];
+            dst[0] = src[0];
+            dst[1] = image.channels > 1 ? src[1] : src[0];
+            dst[2] = image.channels > 2 ? src[2] : src[0];
+            dst[3] = image.channels > 3 ? src[3] : 255;
+        }
+    }
+}
+
+// BC1 colour block using the bounding box of the block as endpoints
+static void encodeColourBlock(const unsigned char block[16][4], unsigned char* out) {
+    unsigned char minColour[3] = {255, 255, 255};
+    unsigned char maxColour[3] = {0, 0, 0};
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            minColour[c] = std::min(minColour[c], block[i][c]);
+            maxColour[c] = std::max(maxColour[c], block[i][c]);
+        }
+    }
+
+    uint16_t c0 = packRGB565(maxColour);
+    uint16_t c1 = packRGB565(minColour);
+    uint32_t indices = 0;
+
+    // c0 > c1 selects the four-colour mode; equal endpoints leave every index at 0
+    if (c0 < c1) std::swap(c0, c1);
+    if (c0 != c1) {
+        int palette[4][3];
+        unpackRGB565(c0, palette[0]);
+        unpackRGB565(c1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            int bestDistance = INT32_MAX;
+            for (int p = 0; p < 4; ++p) {
+                int distance = 0;
+                for (int c = 0; c < 3; ++c) {
+                    const int d = block[i][c] - palette[p][c];
+                    distance += d * d;
+                }
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= static_cast<uint32_t>(best) << (i * 2);
+        }
+    }
+
+    out[0] = static_cast<unsigned char>(c0 & 0xFF);
+    out[1] = static_cast<unsigned char>(c0 >> 8);
+    out[2] = static_cast<unsigned char>(c1 & 0xFF);
+    out[3] = static_cast<unsigned char>(c1 >> 8);
+    std::memcpy(out + 4, &indices, 4);  // little endian, matching the GPU layout
+}
+
+// BC3 alpha block in eight-value mode
+static void encodeAlphaBlock(const unsigned char block[16][4], unsigned char* out) {
+    unsigned char a0 = 0;
+    unsigned char a1 = 255;
+    for (int i = 0; i < 16; ++i) {
+        a0 = std::max(a0, block[i][3]);
+        a1 = std::min(a1, block[i][3]);
+    }
+
+    uint64_t indices = 0;
+    if (a0 != a1) {
+        int palette[8];
+        palette[0] = a0;
+        palette[1] = a1;
+        for (int p = 1; p < 7; ++p) {
+            palette[p + 1] = ((7 - p) * a0 + p * a1) / 7;
+        }
+
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            int bestDistance = INT32_MAX;
+            for (int p = 0; p < 8; ++p) {
+                const int distance = std::abs(block[i][3] - palette[p]);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= static_cast<uint64_t>(best) << (i * 3);
+        }
+    }
+
+    out[0] = a0;
+    out[1] = a1;
+    for (int i = 0; i < 6; ++i) {
+        out[2 + i] = static_cast<unsigned char>((indices >> (i * 8)) & 0xFF);
+    }
+}
+
+static std::vector<unsigned char> compressLevel(const Image& image, BakedFormat format) {
+    const uint32_t blocksX = (image.width + 3) / 4;
+    const uint32_t blocksY = (image.height + 3) / 4;
+    const size_t blockBytes = format == BakedFormat::BC1 ? 8 : 16;
+
+    std::vector<unsigned char> out(static_cast<size_t>(blocksX) * blocksY * blockBytes);
+    unsigned char block[16][4];
+    for (uint32_t by = 0; by < blocksY; ++by) {
+        for (uint32_t bx = 0; bx < blocksX; ++bx) {
+            unsigned char* dst = &out[(static_cast<size_t>(by) * blocksX + bx) * blockBytes];
+            fetchBlock(image, bx, by, block);
+            if (format == BakedFormat::BC3) {
+                encodeAlphaBlock(block, dst);
+                dst += 8;
+            }
+            encodeColourBlock(block, dst);
+        }
+    }
+    return out;
+}
+
+// ==================== Baking ====================
+
+static bool bake(const fs::path& input, const BakeOptions& options) {
+    using Clock = std::chrono::steady_clock;
+
+    // Time what the runtime PNG path pays on the CPU: decode and flip (its mips come from glGenerateMipmap)
+    const auto start = Clock::now();
+
+    stbi_set_flip_vertically_on_load(true);
+    int width = 0, height = 0, channels = 0;
+    unsigned char* data = stbi_load(input.string().c_str(), &width, &height, &channels, 0);
+    if (!data) {
+        std::cerr << "ERROR::TEXTURE_BAKER::Failed to load " << input.string() << ": " << stbi_failure_reason() << std::endl;
+        return false;
+    }
+    if (channels == 2) {
+        // Grey + alpha has no matching upload format; expand to RGBA
+        stbi_image_free(data);
+        data = stbi_load(input.string().c_str(), &width, &height, &channels, 4);
+        channels = 4;
+    }
+
+    std::vector<Image> levels(1);
+    levels[0].width = static_cast<uint32_t>(width);
+    levels[0].height = static_cast<uint32_t>(height);
+    levels[0].channels = static_cast<uint32_t>(channels);
+    levels[0].pixels.assign(data, data + static_cast<size_t>(width) * height * channels);
+    stbi_image_free(data);
+
+    const auto sourceMicros = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+
+    if (options.mips) {
+        while ((levels.back().width > 1 || levels.back().height > 1) && levels.size() < bakedTextureMaxMips) {
+            levels.push_back(downsample(levels.back()));
+        }
+    }
+
+    BakedFormat format = static_cast<BakedFormat>(channels);
+    if (options.compress && channels == 3) format = BakedFormat::BC1;
+    if (options.compress && channels == 4) format = BakedFormat::BC3;
+
+    std::vector<std::vector<unsigned char>> levelData;
+    for (const Image& level : levels) {
+        levelData.push_back(isCompressedFormat(format) ? compressLevel(level, format) : level.pixels);
+    }
+
+    BakedTextureHeader header {};
+    std::memcpy(header.magic, bakedTextureMagic, sizeof(header.magic));
+    header.version = bakedTextureVersion;
+    header.width = levels[0].width;
+    header.height = levels[0].height;
+    header.channels = static_cast<uint32_t>(channels);
+    header.format = format;
+    header.mipCount = static_cast<uint32_t>(levels.size());
+    header.sourceLoadMicros = static_cast<uint64_t>(sourceMicros);
+
+    std::vector<BakedMipLevel> table(levels.size());
+    uint64_t offset = sizeof(header) + table.size() * sizeof(BakedMipLevel);
+    for (size_t i = 0; i < levels.size(); ++i) {
+        table[i].width = levels[i].width;
+        table[i].height = levels[i].height;
+        table[i].offset = offset;
+        table[i].size = levelData[i].size();
+        offset += levelData[i].size();
+    }
+
+    fs::path output = options.outDir.empty() ? input : options.outDir / input.filename();
+    output.replace_extension(".tex");
+    if (output.has_parent_path()) {
+        fs::create_directories(output.parent_path());
+    }
+
+    std::ofstream file(output, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "ERROR::TEXTURE_BAKER::Cannot write " << output.string() << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(BakedMipLevel)));
+    for (const auto& level : levelData) {
+        file.write(reinterpret_cast<const char*>(level.data()), static_cast<std::streamsize>(level.size()));
+    }
+
+    std::cout << "Baked " << input.string() << " -> " << output.string() << " (" << width << "x" << height
+              << ", " << levels.size() << " mips, " << offset << " bytes, PNG path " << sourceMicros / 1000.0 << " ms)"
+              << std::endl;
+    return true;
+}
+
+int main(int argc, char** argv) {
+    BakeOptions options;
+    std::vector<fs::path> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--compress") {
+            options.compress = true;
+        } else if (arg == "--no-mips") {
+            options.mips = false;
+        } else if (arg == "--out-dir" && i + 1 < argc) {
+            options.outDir = argv[++i];
+        } else {
+            inputs.emplace_back(arg);
+        }
+    }
+
+    if (inputs.empty()) {
+        std::cerr << "Usage: texture_baker [--compress] [--no-mips] [--out-dir DIR] image..." << std::endl;
+        return 1;
+    }
+
+    int failures = 0;
+    for (const auto& input : inputs) {
+        if (!bake(input, options)) {
+            failures++;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}